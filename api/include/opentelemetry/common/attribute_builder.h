@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "opentelemetry/common/attribute_value.h"
+#include "opentelemetry/common/key_value_iterable.h"
+#include "opentelemetry/nostd/function_ref.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/nostd/variant.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace common
+{
+/**
+ * Adds one attribute. The key and the value only need to remain valid for the
+ * duration of the call.
+ */
+using AttributeAdder = nostd::function_ref<void(nostd::string_view, AttributeValue)>;
+
+/**
+ * Computes attributes on demand, passing each of them to the given
+ * AttributeAdder. Attribute builders allow deferring the cost of formatting
+ * attribute values until it is known that the attributes are recorded.
+ */
+using AttributeBuilder = nostd::function_ref<void(AttributeAdder)>;
+
+/**
+ * The attributes of an AttributeBuilder as a KeyValueIterable. The builder is
+ * invoked once, on construction, and the attributes it adds are copied, as
+ * their keys and values are only valid during the call of the AttributeAdder.
+ */
+class BuiltAttributes final : public KeyValueIterable
+{
+public:
+  explicit BuiltAttributes(AttributeBuilder builder)
+  {
+    builder([this](nostd::string_view key, AttributeValue value) {
+      attributes_.emplace_back(CopyString(key), nostd::visit(ValueCopier{*this}, value));
+    });
+  }
+
+  bool ForEachKeyValue(nostd::function_ref<bool(nostd::string_view, AttributeValue)> callback) const
+      noexcept override
+  {
+    for (const auto &attribute : attributes_)
+    {
+      if (!callback(attribute.first, attribute.second))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t size() const noexcept override { return attributes_.size(); }
+
+private:
+  struct ValueCopier
+  {
+    BuiltAttributes &attributes;
+
+    template <class T>
+    AttributeValue operator()(T value)
+    {
+      return value;
+    }
+
+    AttributeValue operator()(nostd::string_view value) { return attributes.CopyString(value); }
+
+    template <class T>
+    AttributeValue operator()(nostd::span<const T> values)
+    {
+      return nostd::span<const T>(attributes.CopyArray(values.data(), values.size()),
+                                  values.size());
+    }
+
+    AttributeValue operator()(nostd::span<const nostd::string_view> values)
+    {
+      auto copy = attributes.CopyArray(values.data(), values.size());
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        copy[i] = attributes.CopyString(values[i]);
+      }
+      return nostd::span<const nostd::string_view>(copy, values.size());
+    }
+  };
+
+  nostd::string_view CopyString(nostd::string_view value)
+  {
+    std::shared_ptr<std::string> copy(new std::string(value.data(), value.size()));
+    storage_.push_back(copy);
+    return *copy;
+  }
+
+  template <class T>
+  T *CopyArray(const T *values, size_t size)
+  {
+    std::shared_ptr<T> copy(new T[size], std::default_delete<T[]>());
+    std::copy(values, values + size, copy.get());
+    storage_.push_back(copy);
+    return copy.get();
+  }
+
+  std::vector<std::pair<nostd::string_view, AttributeValue>> attributes_;
+  // Owns the copied strings and arrays, which are of different types.
+  std::vector<std::shared_ptr<void>> storage_;
+};
+}  // namespace common
+OPENTELEMETRY_END_NAMESPACE
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 
+#include "opentelemetry/common/attribute_builder.h"
 #include "opentelemetry/common/attribute_value.h"
 #include "opentelemetry/common/key_value_iterable_view.h"
 #include "opentelemetry/core/timestamp.h"
@@ -105,6 +106,19 @@ class Span
   virtual void SetAttribute(nostd::string_view key,
                             const common::AttributeValue &value) noexcept = 0;
 
+  // Sets the attributes computed by a builder on the Span. The builder is only
+  // invoked if the Span is recording, so that the attribute values of spans
+  // which are not recorded are never computed.
+  void SetAttributes(common::AttributeBuilder attributes) noexcept
+  {
+    if (this->IsRecording())
+    {
+      attributes([this](nostd::string_view key, common::AttributeValue value) {
+        this->SetAttribute(key, value);
+      });
+    }
+  }
+
   // Adds an event to the Span.
   virtual void AddEvent(nostd::string_view name) noexcept = 0;
 
@@ -122,6 +136,23 @@ class Span
     this->AddEvent(name, std::chrono::system_clock::now(), attributes);
   }
 
+  // Adds an event to the Span, with a custom timestamp, and the attributes
+  // computed by a builder. The builder is only invoked if the Span is recording.
+  void AddEvent(nostd::string_view name,
+                core::SystemTimestamp timestamp,
+                common::AttributeBuilder attributes) noexcept
+  {
+    if (this->IsRecording())
+    {
+      this->AddEvent(name, timestamp, common::BuiltAttributes{attributes});
+    }
+  }
+
+  void AddEvent(nostd::string_view name, common::AttributeBuilder attributes) noexcept
+  {
+    this->AddEvent(name, std::chrono::system_clock::now(), attributes);
+  }
+
   template <class T,
             nostd::enable_if_t<common::detail::is_key_value_iterable<T>::value> * = nullptr>
   void AddEvent(nostd::string_view name,
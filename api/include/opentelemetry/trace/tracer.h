@@ -37,12 +37,64 @@ class Tracer
                                             const SpanContextKeyValueIterable &links,
                                             const StartSpanOptions &options = {}) noexcept = 0;
 
+  /**
+   * Starts a span, with attributes computed by a builder.
+   *
+   * The builder is only invoked if the span is recording, so that the
+   * attribute values of spans which are not recorded are never computed.
+   * Attributes the sampler bases its decision on must be passed eagerly in
+   * attributes, as the sampler does not see the deferred attributes. These are
+   * set after the span is started, so span processors only see them once the
+   * span ends.
+   */
+  nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
+                                    const common::KeyValueIterable &attributes,
+                                    const SpanContextKeyValueIterable &links,
+                                    common::AttributeBuilder deferred_attributes,
+                                    const StartSpanOptions &options = {}) noexcept
+  {
+    auto span = this->StartSpan(name, attributes, links, options);
+    span->SetAttributes(deferred_attributes);
+    return span;
+  }
+
   nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
                                     const StartSpanOptions &options = {}) noexcept
   {
     return this->StartSpan(name, {}, {}, options);
   }
 
+  nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
+                                    common::AttributeBuilder deferred_attributes,
+                                    const StartSpanOptions &options = {}) noexcept
+  {
+    return this->StartSpan(name, common::NullKeyValueIterable(), NullSpanContext(),
+                           deferred_attributes, options);
+  }
+
+  template <class T,
+            nostd::enable_if_t<common::detail::is_key_value_iterable<T>::value> * = nullptr>
+  nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
+                                    const T &attributes,
+                                    common::AttributeBuilder deferred_attributes,
+                                    const StartSpanOptions &options = {}) noexcept
+  {
+    return this->StartSpan(name, common::KeyValueIterableView<T>(attributes), NullSpanContext(),
+                           deferred_attributes, options);
+  }
+
+  nostd::shared_ptr<Span> StartSpan(
+      nostd::string_view name,
+      std::initializer_list<std::pair<nostd::string_view, common::AttributeValue>> attributes,
+      common::AttributeBuilder deferred_attributes,
+      const StartSpanOptions &options = {}) noexcept
+  {
+    return this->StartSpan(name,
+                           nostd::span<const std::pair<nostd::string_view, common::AttributeValue>>{
+                               attributes.begin(), attributes.end()},
+                           deferred_attributes, options);
+  }
+
   template <class T,
             nostd::enable_if_t<common::detail::is_key_value_iterable<T>::value> * = nullptr>
   nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <opentelemetry/common/attribute_builder.h>
+
+#include <string>
+#include <vector>
+
+using opentelemetry::common::AttributeAdder;
+using opentelemetry::common::AttributeValue;
+using opentelemetry::common::BuiltAttributes;
+namespace nostd = opentelemetry::nostd;
+
+TEST(BuiltAttributesTest, BuilderInvokedOnce)
+{
+  int builder_calls = 0;
+  BuiltAttributes attributes{[&](AttributeAdder add) {
+    ++builder_calls;
+    add("int", 1);
+    add("bool", true);
+  }};
+  EXPECT_EQ(2, attributes.size());
+
+  int attribute_count = 0;
+  attributes.ForEachKeyValue([&](nostd::string_view, AttributeValue) noexcept {
+    ++attribute_count;
+    return true;
+  });
+  EXPECT_EQ(2, attribute_count);
+  EXPECT_EQ(1, builder_calls);
+}
+
+TEST(BuiltAttributesTest, CopiesKeysAndValues)
+{
+  BuiltAttributes attributes{[](AttributeAdder add) {
+    // The strings and arrays are destroyed once the adder returns.
+    std::string key = "string";
+    add(key, std::string("value"));
+    std::vector<nostd::string_view> strings = {"a", "b"};
+    std::string strings_key                 = "strings";
+    add(strings_key, nostd::span<const nostd::string_view>(strings.data(), strings.size()));
+    std::vector<int64_t> ints = {1, 2, 3};
+    add(std::string("ints"), nostd::span<const int64_t>(ints.data(), ints.size()));
+  }};
+
+  std::vector<std::string> keys;
+  attributes.ForEachKeyValue([&](nostd::string_view key, AttributeValue value) noexcept {
+    keys.push_back(std::string(key.data(), key.size()));
+    if (key == "string")
+    {
+      EXPECT_EQ("value", nostd::get<nostd::string_view>(value));
+    }
+    else if (key == "strings")
+    {
+      auto strings = nostd::get<nostd::span<const nostd::string_view>>(value);
+      EXPECT_EQ((std::vector<nostd::string_view>{"a", "b"}),
+                std::vector<nostd::string_view>(strings.begin(), strings.end()));
+    }
+    else
+    {
+      auto ints = nostd::get<nostd::span<const int64_t>>(value);
+      EXPECT_EQ((std::vector<int64_t>{1, 2, 3}), std::vector<int64_t>(ints.begin(), ints.end()));
+    }
+    return true;
+  });
+  EXPECT_EQ((std::vector<std::string>{"string", "strings", "ints"}), keys);
+}
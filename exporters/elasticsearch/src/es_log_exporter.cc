@@ -47,8 +47,9 @@ class ResponseHandler : public http_client::EventHandler
     {
       std::unique_lock<std::mutex> lk(mutex_);
 
-      // Store the body of the request
-      body_ = std::string(response.GetBody().begin(), response.GetBody().end());
+      // Store the body and the status code of the request
+      body_        = std::string(response.GetBody().begin(), response.GetBody().end());
+      status_code_ = response.GetStatusCode();
 
       // Set the response_received_ flag to true and notify any threads waiting on this result
       response_received_ = true;
@@ -77,6 +78,15 @@ class ResponseHandler : public http_client::EventHandler
     return body_;
   }
 
+  /**
+   * Returns the status code of the response
+   */
+  http_client::StatusCode GetStatusCode()
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    return status_code_;
+  }
+
   // Callback method when an http event occurs
   void OnEvent(http_client::SessionState state,
                opentelemetry::nostd::string_view reason) noexcept override
@@ -118,6 +128,9 @@ class ResponseHandler : public http_client::EventHandler
   // A string to store the response body
   std::string body_ = "";
 
+  // The status code of the response
+  http_client::StatusCode status_code_ = 0;
+
   // Whether to print the results from the callback
   bool console_debug_ = false;
 };
@@ -168,9 +181,9 @@ sdk::common::ExportResult ElasticsearchLogExporter::Export(
     // in URI
     body += "{\"index\" : {}}\n";
 
-    // Add the context of the Recordable
-    auto json_record = std::unique_ptr<ElasticSearchRecordable>(
-        static_cast<ElasticSearchRecordable *>(record.release()));
+    // Add the context of the Recordable, which is kept until the export succeeds so that it can
+    // be exported again after a transient failure
+    auto json_record = static_cast<ElasticSearchRecordable *>(record.get());
     body += json_record->GetJSON().dump() + "\n";
   }
   std::vector<uint8_t> body_vec(body.begin(), body.end());
@@ -191,11 +204,17 @@ sdk::common::ExportResult ElasticsearchLogExporter::Export(
   // End the session
   session->FinishSession();
 
-  // If an error occurred with the HTTP request
-  if (!write_successful)
+  // If an error occurred with the HTTP request, or Elasticsearch is temporarily overloaded
+  auto status_code = handler->GetStatusCode();
+  if (!write_successful || status_code == 429 || status_code == 502 || status_code == 503 ||
+      status_code == 504)
   {
-    // TODO: retry logic
-    return sdk::common::ExportResult::kFailure;
+    return sdk::common::ExportResult::kFailureRetryable;
+  }
+
+  for (auto &record : records)
+  {
+    record.reset();
   }
 
   // Parse the response output to determine if Elasticsearch consumed it correctly
@@ -208,7 +227,6 @@ sdk::common::ExportResult ElasticsearchLogExporter::Export(
       std::cout << responseBody << std::endl;
     }
 
-    // TODO: Retry logic
     return sdk::common::ExportResult::kFailure;
   }
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/sdk/common/sequenced_circular_buffer.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 #include "vector"
@@ -63,7 +63,8 @@ class InMemorySpanData final
   }
 
 private:
-  opentelemetry::sdk::common::CircularBuffer<opentelemetry::sdk::trace::SpanData> spans_received_;
+  opentelemetry::sdk::common::SequencedCircularBuffer<opentelemetry::sdk::trace::SpanData>
+      spans_received_;
 };
 }  // namespace memory
 }  // namespace exporter
@@ -1,6 +1,7 @@
 #pragma once
 #include "opentelemetry/exporters/memory/in_memory_span_data.h"
 #include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -41,6 +42,17 @@ class InMemorySpanExporter final : public opentelemetry::sdk::trace::SpanExporte
   {
     for (auto &recordable : recordables)
     {
+      // Spans shared with other processors are copied, as the spans are kept
+      // for inspection by tests.
+      auto shared_span = dynamic_cast<sdk::trace::SharedSpanData *>(recordable.get());
+      if (shared_span != nullptr)
+      {
+        std::unique_ptr<sdk::trace::SpanData> span(new sdk::trace::SpanData);
+        shared_span->CopyTo(*span);
+        data_->Add(std::move(span));
+        continue;
+      }
+
       auto span = std::unique_ptr<sdk::trace::SpanData>(
           dynamic_cast<sdk::trace::SpanData *>(recordable.release()));
       if (span != nullptr)
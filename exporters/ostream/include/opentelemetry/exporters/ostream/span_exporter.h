@@ -105,8 +105,7 @@ class OStreamSpanExporter final : public sdktrace::SpanExporter
   }
 
   // various print helpers
-  void printAttributes(const std::unordered_map<std::string, sdkcommon::OwnedAttributeValue> &map,
-                       const std::string prefix = "\n\t");
+  void printAttributes(const sdkcommon::AttributeView &map, const std::string prefix = "\n\t");
 
   void printEvents(const std::vector<sdktrace::SpanDataEvent> &events);
 
@@ -86,8 +86,7 @@ void print_value(sdk::common::OwnedAttributeValue &value, std::ostream &sout)
 #endif
 }
 
-void printMap(std::unordered_map<std::string, sdk::common::OwnedAttributeValue> map,
-              std::ostream &sout)
+void printMap(sdk::common::AttributeView map, std::ostream &sout)
 {
   sout << "{";
   size_t size = map.size();
@@ -1,4 +1,6 @@
 #include "opentelemetry/exporters/ostream/span_exporter.h"
+#include "opentelemetry/sdk/trace/recordable_pool.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
 #include <iostream>
 
@@ -33,7 +35,8 @@ OStreamSpanExporter::OStreamSpanExporter(std::ostream &sout) noexcept : sout_(so
 
 std::unique_ptr<sdktrace::Recordable> OStreamSpanExporter::MakeRecordable() noexcept
 {
-  return std::unique_ptr<sdktrace::Recordable>(new sdktrace::SpanData);
+  return std::unique_ptr<sdktrace::Recordable>(
+      sdktrace::RecordablePool<sdktrace::SpanData>::Acquire().release());
 }
 
 sdk::common::ExportResult OStreamSpanExporter::Export(
@@ -46,9 +49,13 @@ sdk::common::ExportResult OStreamSpanExporter::Export(
 
   for (auto &recordable : spans)
   {
-    auto span = std::unique_ptr<sdktrace::SpanData>(
-        static_cast<sdktrace::SpanData *>(recordable.release()));
+    if (recordable == nullptr)
+    {
+      continue;
+    }
 
+    // Spans shared with other processors are read in place.
+    auto span = sdktrace::SharedSpanData::FromRecordable(*recordable);
     if (span != nullptr)
     {
 
@@ -79,6 +86,12 @@ sdk::common::ExportResult OStreamSpanExporter::Export(
       printLinks(span->GetLinks());
       sout_ << "\n}\n";
     }
+
+    if (span == recordable.get())
+    {
+      sdktrace::RecordablePool<sdktrace::SpanData>::Release(std::unique_ptr<sdktrace::SpanData>(
+          static_cast<sdktrace::SpanData *>(recordable.release())));
+    }
   }
 
   return sdk::common::ExportResult::kSuccess;
@@ -90,9 +103,8 @@ bool OStreamSpanExporter::Shutdown(std::chrono::microseconds timeout) noexcept
   return true;
 }
 
-void OStreamSpanExporter::printAttributes(
-    const std::unordered_map<std::string, sdkcommon::OwnedAttributeValue> &map,
-    const std::string prefix)
+void OStreamSpanExporter::printAttributes(const sdkcommon::AttributeView &map,
+                                          const std::string prefix)
 {
   for (const auto &kv : map)
   {
@@ -8,6 +8,10 @@
 
 #include "opentelemetry/sdk/trace/exporter.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
 {
@@ -32,8 +36,12 @@ struct OtlpExporterOptions
 
 /**
  * The OTLP exporter exports span data in OpenTelemetry Protocol (OTLP) format.
+ * Encoded batches are serialized ExportTraceServiceRequest messages.
+ *
+ * Export, Encode and ExportEncoded may be called concurrently, so the exporter
+ * supports a BatchSpanProcessor with more than one concurrent export.
  */
-class OtlpExporter final : public opentelemetry::sdk::trace::SpanExporter
+class OtlpExporter final : public opentelemetry::sdk::trace::EncodingSpanExporter
 {
 public:
   /**
@@ -59,6 +67,20 @@ class OtlpExporter final : public opentelemetry::sdk::trace::SpanExporter
   sdk::common::ExportResult Export(
       const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans) noexcept override;
 
+  /**
+   * Encode a batch of span recordables into a serialized OTLP request.
+   * @param spans a span of unique pointers to span recordables
+   * @param data the serialized request
+   */
+  bool Encode(const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans,
+              std::string *data) noexcept override;
+
+  /**
+   * Export a serialized OTLP request made by Encode.
+   * @param data the serialized request
+   */
+  sdk::common::ExportResult ExportEncoded(nostd::string_view data) noexcept override;
+
   /**
    * Shut down the exporter.
    * @param timeout an optional timeout, the default timeout of 0 means that no
@@ -81,12 +103,34 @@ class OtlpExporter final : public opentelemetry::sdk::trace::SpanExporter
   // Store service stub internally. Useful for testing.
   std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> trace_service_stub_;
 
+  // Requests are reused across calls to Export, so that their span messages can be swapped
+  // into recycled recordables. Concurrent calls take different requests from the pool.
+  std::vector<std::unique_ptr<proto::collector::trace::v1::ExportTraceServiceRequest>> requests_;
+  std::mutex requests_mutex_;
+
   /**
    * Create an OtlpExporter using the specified service stub.
    * Only tests can call this constructor directly.
    * @param stub the service stub to be used for exporting
    */
   OtlpExporter(std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub);
+
+  /**
+   * Take a request from the pool, or create one if the pool is empty.
+   */
+  std::unique_ptr<proto::collector::trace::v1::ExportTraceServiceRequest> AcquireRequest() noexcept;
+
+  /**
+   * Return a request to the pool.
+   */
+  void ReleaseRequest(
+      std::unique_ptr<proto::collector::trace::v1::ExportTraceServiceRequest> request) noexcept;
+
+  /**
+   * Send a request to the collector.
+   */
+  sdk::common::ExportResult SendRequest(
+      const proto::collector::trace::v1::ExportTraceServiceRequest &request) noexcept;
 };
 }  // namespace otlp
 }  // namespace exporter
@@ -19,6 +19,8 @@ class Recordable final : public sdk::trace::Recordable
 public:
   const proto::trace::v1::Span &span() const noexcept { return span_; }
 
+  proto::trace::v1::Span *mutable_span() noexcept { return &span_; }
+
   void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
                    opentelemetry::trace::SpanId parent_span_id) noexcept override;
 
@@ -29,9 +31,22 @@ class Recordable final : public sdk::trace::Recordable
                 core::SystemTimestamp timestamp,
                 const common::KeyValueIterable &attributes) noexcept override;
 
+  void AddEvent(nostd::string_view name,
+                core::SystemTimestamp timestamp,
+                const common::KeyValueIterable &attributes,
+                uint32_t dropped_attributes_count) noexcept override;
+
   void AddLink(const opentelemetry::trace::SpanContext &span_context,
                const common::KeyValueIterable &attributes) noexcept override;
 
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const common::KeyValueIterable &attributes,
+               uint32_t dropped_attributes_count) noexcept override;
+
+  void SetDroppedCounts(uint32_t dropped_attributes_count,
+                        uint32_t dropped_events_count,
+                        uint32_t dropped_links_count) noexcept override;
+
   void SetStatus(trace::StatusCode code, nostd::string_view description) noexcept override;
 
   void SetName(nostd::string_view name) noexcept override;
@@ -42,8 +57,31 @@ class Recordable final : public sdk::trace::Recordable
 
   void SetDuration(std::chrono::nanoseconds duration) noexcept override;
 
+  void SetInstrumentationLibrary(
+      const std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>
+          &instrumentation_library) noexcept override;
+
+  /**
+   * @return the instrumentation library of the span, or nullptr if none was set.
+   */
+  const std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>
+      &GetInstrumentationLibrary() const noexcept
+  {
+    return instrumentation_library_;
+  }
+
+  size_t GetEstimatedSize() const noexcept override { return span_.ByteSizeLong(); }
+
+  /**
+   * Clear the span so that this recordable can be reused. Protobuf keeps the
+   * allocated strings and repeated fields around for the next span.
+   */
+  void Reset() noexcept;
+
 private:
   proto::trace::v1::Span span_;
+  std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>
+      instrumentation_library_;
 };
 }  // namespace otlp
 }  // namespace exporter
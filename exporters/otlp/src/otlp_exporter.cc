@@ -1,9 +1,15 @@
 #include "opentelemetry/exporters/otlp/otlp_exporter.h"
 #include "opentelemetry/exporters/otlp/recordable.h"
+#include "opentelemetry/sdk/trace/recordable_pool.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <new>
+#include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -14,20 +20,136 @@ namespace otlp
 // ----------------------------- Helper functions ------------------------------
 
 /**
- * Add span protobufs contained in recordables to request.
+ * Add span protobufs contained in recordables to request. The span protobufs are swapped
+ * into the request and the drained recordables are returned to the recordable pool.
+ * Spans are grouped into one InstrumentationLibrarySpans per instrumentation library.
  * @param spans the spans to export
  * @param request the current request
+ * @return the instrumentation library of every InstrumentationLibrarySpans of the request
  */
-void PopulateRequest(const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans,
-                     proto::collector::trace::v1::ExportTraceServiceRequest *request)
+std::vector<std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>>
+PopulateRequest(
+    const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans,
+    proto::collector::trace::v1::ExportTraceServiceRequest *request)
 {
-  auto resource_span       = request->add_resource_spans();
-  auto instrumentation_lib = resource_span->add_instrumentation_library_spans();
+  auto resource_span = request->add_resource_spans();
+
+  // A batch contains spans of only a few libraries, so they are looked up linearly.
+  std::vector<std::pair<std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>,
+                        proto::trace::v1::InstrumentationLibrarySpans *>>
+      instrumentation_libs;
 
   for (auto &recordable : spans)
   {
-    auto rec = std::unique_ptr<Recordable>(static_cast<Recordable *>(recordable.release()));
-    *instrumentation_lib->add_spans() = std::move(rec->span());
+    std::unique_ptr<Recordable> rec;
+    auto shared_span = dynamic_cast<sdk::trace::SharedSpanData *>(recordable.get());
+    if (shared_span != nullptr)
+    {
+      // Spans shared with other processors are converted into a protobuf span here.
+      rec = sdk::trace::RecordablePool<Recordable>::Acquire();
+      if (rec == nullptr)
+      {
+        continue;
+      }
+      shared_span->CopyTo(*rec);
+      recordable.reset();
+    }
+    else
+    {
+      rec = std::unique_ptr<Recordable>(static_cast<Recordable *>(recordable.release()));
+    }
+    const auto &library = rec->GetInstrumentationLibrary();
+
+    auto it = std::find_if(instrumentation_libs.begin(), instrumentation_libs.end(),
+                           [&library](const decltype(instrumentation_libs)::value_type &entry) {
+                             return entry.first == library ||
+                                    (entry.first != nullptr && library != nullptr &&
+                                     *entry.first == *library);
+                           });
+    proto::trace::v1::InstrumentationLibrarySpans *instrumentation_lib;
+    if (it != instrumentation_libs.end())
+    {
+      instrumentation_lib = it->second;
+    }
+    else
+    {
+      instrumentation_lib = resource_span->add_instrumentation_library_spans();
+      if (library != nullptr)
+      {
+        instrumentation_lib->mutable_instrumentation_library()->set_name(library->GetName());
+        instrumentation_lib->mutable_instrumentation_library()->set_version(
+            library->GetVersion());
+      }
+      instrumentation_libs.emplace_back(library, instrumentation_lib);
+    }
+
+    instrumentation_lib->add_spans()->Swap(rec->mutable_span());
+    sdk::trace::RecordablePool<Recordable>::Release(std::move(rec));
+  }
+
+  std::vector<std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>>
+      libraries;
+  libraries.reserve(instrumentation_libs.size());
+  for (auto &entry : instrumentation_libs)
+  {
+    libraries.push_back(std::move(entry.first));
+  }
+  return libraries;
+}
+
+/**
+ * Swap the span protobufs of a request back into recordables, in the slots of the spans
+ * which PopulateRequest took, so that the spans can be exported again.
+ * @param request the request populated from spans
+ * @param libraries the instrumentation libraries returned by PopulateRequest
+ * @param spans the spans the request was populated from
+ */
+void RestoreSpans(
+    proto::collector::trace::v1::ExportTraceServiceRequest *request,
+    const std::vector<std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>>
+        &libraries,
+    const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans)
+{
+  auto slot          = spans.begin();
+  auto resource_span = request->mutable_resource_spans(0);
+  for (int i = 0; i < resource_span->instrumentation_library_spans_size(); ++i)
+  {
+    auto instrumentation_lib = resource_span->mutable_instrumentation_library_spans(i);
+    for (auto &span : *instrumentation_lib->mutable_spans())
+    {
+      while (slot != spans.end() && *slot != nullptr)
+      {
+        ++slot;
+      }
+      auto rec = sdk::trace::RecordablePool<Recordable>::Acquire();
+      if (slot == spans.end() || rec == nullptr)
+      {
+        return;
+      }
+      rec->mutable_span()->Swap(&span);
+      rec->SetInstrumentationLibrary(libraries[i]);
+      slot->reset(rec.release());
+    }
+  }
+}
+
+/**
+ * @return true if an export which failed with the given status code may succeed later
+ */
+bool IsRetryable(grpc::StatusCode code)
+{
+  switch (code)
+  {
+    case grpc::StatusCode::CANCELLED:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+    case grpc::StatusCode::ABORTED:
+    case grpc::StatusCode::OUT_OF_RANGE:
+    case grpc::StatusCode::UNAVAILABLE:
+    case grpc::StatusCode::DATA_LOSS:
+      return true;
+    default:
+      return false;
   }
 }
 
@@ -84,16 +206,92 @@ OtlpExporter::OtlpExporter(
 
 std::unique_ptr<sdk::trace::Recordable> OtlpExporter::MakeRecordable() noexcept
 {
-  return std::unique_ptr<sdk::trace::Recordable>(new Recordable);
+  return std::unique_ptr<sdk::trace::Recordable>(
+      sdk::trace::RecordablePool<Recordable>::Acquire().release());
 }
 
 sdk::common::ExportResult OtlpExporter::Export(
     const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans) noexcept
 {
-  proto::collector::trace::v1::ExportTraceServiceRequest request;
+  // Clearing the request keeps the span messages of the previous export around, so that
+  // they can be swapped into the recycled recordables.
+  auto request = AcquireRequest();
+  if (request == nullptr)
+  {
+    return sdk::common::ExportResult::kFailure;
+  }
+  request->Clear();
+
+  auto libraries = PopulateRequest(spans, request.get());
+
+  auto result = SendRequest(*request);
+  if (result == sdk::common::ExportResult::kFailureRetryable)
+  {
+    RestoreSpans(request.get(), libraries, spans);
+  }
+  ReleaseRequest(std::move(request));
+  return result;
+}
+
+bool OtlpExporter::Encode(const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans,
+                          std::string *data) noexcept
+{
+  auto request = AcquireRequest();
+  if (request == nullptr)
+  {
+    return false;
+  }
+  request->Clear();
+  PopulateRequest(spans, request.get());
+  bool encoded = request->SerializeToString(data);
+  ReleaseRequest(std::move(request));
+  return encoded;
+}
 
-  PopulateRequest(spans, &request);
+sdk::common::ExportResult OtlpExporter::ExportEncoded(nostd::string_view data) noexcept
+{
+  auto request = AcquireRequest();
+  if (request == nullptr)
+  {
+    return sdk::common::ExportResult::kFailure;
+  }
+  if (!request->ParseFromArray(data.data(), static_cast<int>(data.size())))
+  {
+    std::cerr << "[OTLP Exporter] ExportEncoded() failed: invalid request\n";
+    ReleaseRequest(std::move(request));
+    return sdk::common::ExportResult::kFailure;
+  }
+  auto result = SendRequest(*request);
+  ReleaseRequest(std::move(request));
+  return result;
+}
+
+std::unique_ptr<proto::collector::trace::v1::ExportTraceServiceRequest>
+OtlpExporter::AcquireRequest() noexcept
+{
+  {
+    std::lock_guard<std::mutex> guard{requests_mutex_};
+    if (!requests_.empty())
+    {
+      auto request = std::move(requests_.back());
+      requests_.pop_back();
+      return request;
+    }
+  }
+  return std::unique_ptr<proto::collector::trace::v1::ExportTraceServiceRequest>(
+      new (std::nothrow) proto::collector::trace::v1::ExportTraceServiceRequest);
+}
+
+void OtlpExporter::ReleaseRequest(
+    std::unique_ptr<proto::collector::trace::v1::ExportTraceServiceRequest> request) noexcept
+{
+  std::lock_guard<std::mutex> guard{requests_mutex_};
+  requests_.push_back(std::move(request));
+}
 
+sdk::common::ExportResult OtlpExporter::SendRequest(
+    const proto::collector::trace::v1::ExportTraceServiceRequest &request) noexcept
+{
   grpc::ClientContext context;
   proto::collector::trace::v1::ExportTraceServiceResponse response;
 
@@ -102,6 +300,10 @@ sdk::common::ExportResult OtlpExporter::Export(
   if (!status.ok())
   {
     std::cerr << "[OTLP Exporter] Export() failed: " << status.error_message() << "\n";
+    if (IsRetryable(status.error_code()))
+    {
+      return sdk::common::ExportResult::kFailureRetryable;
+    }
     return sdk::common::ExportResult::kFailure;
   }
   return sdk::common::ExportResult::kSuccess;
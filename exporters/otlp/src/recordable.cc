@@ -168,6 +168,34 @@ void Recordable::AddLink(const opentelemetry::trace::SpanContext &span_context,
   // TODO: Populate trace_state when it is supported by SpanContext
 }
 
+void Recordable::AddEvent(nostd::string_view name,
+                          core::SystemTimestamp timestamp,
+                          const common::KeyValueIterable &attributes,
+                          uint32_t dropped_attributes_count) noexcept
+{
+  AddEvent(name, timestamp, attributes);
+  span_.mutable_events(span_.events_size() - 1)->set_dropped_attributes_count(
+      dropped_attributes_count);
+}
+
+void Recordable::AddLink(const opentelemetry::trace::SpanContext &span_context,
+                         const common::KeyValueIterable &attributes,
+                         uint32_t dropped_attributes_count) noexcept
+{
+  AddLink(span_context, attributes);
+  span_.mutable_links(span_.links_size() - 1)->set_dropped_attributes_count(
+      dropped_attributes_count);
+}
+
+void Recordable::SetDroppedCounts(uint32_t dropped_attributes_count,
+                                  uint32_t dropped_events_count,
+                                  uint32_t dropped_links_count) noexcept
+{
+  span_.set_dropped_attributes_count(dropped_attributes_count);
+  span_.set_dropped_events_count(dropped_events_count);
+  span_.set_dropped_links_count(dropped_links_count);
+}
+
 void Recordable::SetStatus(trace::StatusCode code, nostd::string_view description) noexcept
 {
   span_.mutable_status()->set_code(opentelemetry::proto::trace::v1::Status_StatusCode(code));
@@ -231,6 +259,19 @@ void Recordable::SetDuration(std::chrono::nanoseconds duration) noexcept
   const uint64_t unix_end_time = span_.start_time_unix_nano() + duration.count();
   span_.set_end_time_unix_nano(unix_end_time);
 }
+
+void Recordable::SetInstrumentationLibrary(
+    const std::shared_ptr<const sdk::instrumentationlibrary::InstrumentationLibrary>
+        &instrumentation_library) noexcept
+{
+  instrumentation_library_ = instrumentation_library;
+}
+
+void Recordable::Reset() noexcept
+{
+  span_.Clear();
+  instrumentation_library_.reset();
+}
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -12,6 +12,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace testing;
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -64,6 +70,70 @@ TEST_F(OtlpExporterTestPeer, ExportUnitTest)
   EXPECT_EQ(sdk::common::ExportResult::kFailure, result);
 }
 
+// Call Export() from several threads at once, as a batch processor with concurrent exports does
+TEST_F(OtlpExporterTestPeer, ConcurrentExportUnitTest)
+{
+  auto mock_stub = new proto::collector::trace::v1::MockTraceServiceStub();
+  std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub_interface(
+      mock_stub);
+  auto exporter = GetExporter(stub_interface);
+
+  const int num_threads   = 4;
+  const int num_exports   = 100;
+  const size_t batch_size = 3;
+
+  // Every request holds the spans of one batch only, which are all named after its thread.
+  std::atomic<int> mixed_requests{0};
+  auto check_request = [&](grpc::ClientContext *,
+                           const proto::collector::trace::v1::ExportTraceServiceRequest &request,
+                           proto::collector::trace::v1::ExportTraceServiceResponse *) {
+    std::vector<std::string> names;
+    for (auto &resource_span : request.resource_spans())
+    {
+      for (auto &instrumentation_lib : resource_span.instrumentation_library_spans())
+      {
+        for (auto &span : instrumentation_lib.spans())
+        {
+          names.push_back(span.name());
+        }
+      }
+    }
+    if (names.size() != batch_size ||
+        static_cast<size_t>(std::count(names.begin(), names.end(), names.front())) != batch_size)
+    {
+      ++mixed_requests;
+    }
+    return grpc::Status::OK;
+  };
+  EXPECT_CALL(*mock_stub, Export(_, _, _))
+      .Times(Exactly(num_threads * num_exports))
+      .WillRepeatedly(Invoke(check_request));
+
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < num_threads; ++thread)
+  {
+    threads.emplace_back([&exporter, thread] {
+      for (int i = 0; i < num_exports; ++i)
+      {
+        std::unique_ptr<sdk::trace::Recordable> batch[batch_size];
+        for (auto &recordable : batch)
+        {
+          recordable = exporter->MakeRecordable();
+          recordable->SetName("Thread " + std::to_string(thread));
+        }
+        EXPECT_EQ(sdk::common::ExportResult::kSuccess,
+                  exporter->Export(
+                      nostd::span<std::unique_ptr<sdk::trace::Recordable>>(batch, batch_size)));
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(0, mixed_requests.load());
+}
+
 // Create spans, let processor call Export()
 TEST_F(OtlpExporterTestPeer, ExportIntegrationTest)
 {
@@ -150,6 +150,24 @@ TEST(Recordable, AddLink)
   }
 }
 
+TEST(Recordable, SetDroppedCounts)
+{
+  Recordable rec;
+  std::map<std::string, int> attributes = {{"attr1", 1}};
+
+  rec.AddEvent("Test Event", std::chrono::system_clock::now(),
+               common::KeyValueIterableView<std::map<std::string, int>>(attributes), 2);
+  rec.AddLink(trace::SpanContext(false, false),
+              common::KeyValueIterableView<std::map<std::string, int>>(attributes), 3);
+  rec.SetDroppedCounts(4, 5, 6);
+
+  EXPECT_EQ(rec.span().events(0).dropped_attributes_count(), 2);
+  EXPECT_EQ(rec.span().links(0).dropped_attributes_count(), 3);
+  EXPECT_EQ(rec.span().dropped_attributes_count(), 4);
+  EXPECT_EQ(rec.span().dropped_events_count(), 5);
+  EXPECT_EQ(rec.span().dropped_links_count(), 6);
+}
+
 // Test non-int single types. Int single types are tested using templates (see IntAttributeTest)
 TEST(Recordable, SetSingleAtrribute)
 {
@@ -17,6 +17,7 @@
 #include "opentelemetry/exporters/zipkin/recordable.h"
 #include "opentelemetry/ext/http/client/http_client_factory.h"
 #include "opentelemetry/ext/http/common/url_parser.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -24,6 +25,25 @@ namespace exporter
 namespace zipkin
 {
 
+namespace
+{
+/**
+ * @return true if a request which failed with the given result may succeed later, because
+ * the collector could not be reached or was temporarily overloaded.
+ */
+bool IsRetryable(http_client::Result &result)
+{
+  if (!result)
+  {
+    return result.GetSessionState() == http_client::SessionState::ConnectFailed ||
+           result.GetSessionState() == http_client::SessionState::TimedOut ||
+           result.GetSessionState() == http_client::SessionState::NetworkError;
+  }
+  auto status_code = result.GetResponse().GetStatusCode();
+  return status_code == 429 || status_code == 502 || status_code == 503 || status_code == 504;
+}
+}  // namespace
+
 // -------------------------------- Constructors --------------------------------
 
 ZipkinExporter::ZipkinExporter(const ZipkinExporterOptions &options)
@@ -56,32 +76,47 @@ sdk::common::ExportResult ZipkinExporter::Export(
   exporter::zipkin::ZipkinSpan json_spans = {};
   for (auto &recordable : spans)
   {
-    auto rec = std::unique_ptr<Recordable>(static_cast<Recordable *>(recordable.release()));
-    if (rec != nullptr)
+    if (recordable == nullptr)
+    {
+      continue;
+    }
+    // The recordables are kept until the export succeeds, so that they can be exported again
+    // after a transient failure.
+    nlohmann::json json_span;
+    auto shared_span = dynamic_cast<sdk::trace::SharedSpanData *>(recordable.get());
+    if (shared_span != nullptr)
+    {
+      // Spans shared with other processors are converted into a JSON span here.
+      Recordable rec;
+      shared_span->CopyTo(rec);
+      json_span = rec.span();
+    }
+    else
     {
-      auto json_span = rec->span();
-      // add localEndPoint
-      json_span["localEndpoint"] = local_end_point_;
-      json_spans.push_back(json_span);
+      json_span = static_cast<Recordable *>(recordable.get())->span();
     }
+    // add localEndPoint
+    json_span["localEndpoint"] = local_end_point_;
+    json_spans.push_back(std::move(json_span));
   }
   auto body_s = json_spans.dump();
   http_client::Body body_v(body_s.begin(), body_s.end());
   auto result = http_client_->Post(url_parser_.url_, body_v);
-  if (result && result.GetResponse().GetStatusCode() == 200 ||
-      result.GetResponse().GetStatusCode() == 202)
+  if (IsRetryable(result))
   {
-    return sdk::common::ExportResult::kSuccess;
+    return sdk::common::ExportResult::kFailureRetryable;
   }
-  else
+
+  for (auto &recordable : spans)
   {
-    if (result.GetSessionState() == http_client::SessionState::ConnectFailed)
-    {
-      // TODO -> Handle error / retries
-    }
-    return sdk::common::ExportResult::kFailure;
+    recordable.reset();
+  }
+  if (result && (result.GetResponse().GetStatusCode() == 200 ||
+                 result.GetResponse().GetStatusCode() == 202))
+  {
+    return sdk::common::ExportResult::kSuccess;
   }
-  return sdk::common::ExportResult::kSuccess;
+  return sdk::common::ExportResult::kFailure;
 }
 
 void ZipkinExporter::InitializeLocalEndpoint()
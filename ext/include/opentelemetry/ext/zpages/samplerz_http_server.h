@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "opentelemetry/ext/zpages/zpages_http_server.h"
+#include "opentelemetry/sdk/trace/samplers/trace_id_ratio.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace ext
+{
+namespace zpages
+{
+
+/**
+ * Serves the description of a TraceIdRatioBasedSampler, and changes its ratio
+ * while the process runs, e.g. to turn sampling down during an incident:
+ *
+ *   curl http://localhost:30001/samplerz
+ *   curl -X POST http://localhost:30001/samplerz/ratio/0.01
+ */
+class SamplerzHttpServer : public opentelemetry::ext::zpages::zPagesHttpServer
+{
+public:
+  /**
+   * Construct the server for a sampler, which may be shared with the tracer
+   * provider whose spans it samples
+   * @param sampler is the sampler whose ratio is served and changed
+   * @param host is the host where the SamplerZ endpoint is served, default being localhost
+   * @param port is the port where the SamplerZ endpoint is served, default being 30001
+   */
+  SamplerzHttpServer(std::shared_ptr<opentelemetry::sdk::trace::TraceIdRatioBasedSampler> sampler,
+                     const std::string &host = "localhost",
+                     int port                = 30001)
+      : opentelemetry::ext::zpages::zPagesHttpServer("/samplerz", host, port),
+        sampler_(std::move(sampler))
+  {
+    InitializeSamplerzEndpoint(*this);
+  };
+
+private:
+  /**
+   * Set the HTTP server to use the "Serve" callback to handle the requests
+   * @param server, which should be an instance of this object
+   */
+  void InitializeSamplerzEndpoint(SamplerzHttpServer &server) { server[endpoint_] = Serve; }
+
+  /**
+   * Sets the response to the current description of the sampler, after
+   * changing its ratio if requested
+   * @param req is the HTTP request, whose query may set the ratio
+   * @param resp is the HTTP response with the description of the sampler
+   * @returns the HTTP status code
+   */
+  int HandleRequest(HTTP_SERVER_NS::HttpRequest const &req, HTTP_SERVER_NS::HttpResponse &resp);
+
+  HTTP_SERVER_NS::HttpRequestCallback Serve{
+      [&](HTTP_SERVER_NS::HttpRequest const &req, HTTP_SERVER_NS::HttpResponse &resp) {
+        return HandleRequest(req, resp);
+      }};
+
+  std::shared_ptr<opentelemetry::sdk::trace::TraceIdRatioBasedSampler> sampler_;
+};
+
+}  // namespace zpages
+}  // namespace ext
+OPENTELEMETRY_END_NAMESPACE
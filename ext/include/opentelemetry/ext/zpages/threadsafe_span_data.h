@@ -2,11 +2,12 @@
 
 #include <chrono>
 #include <mutex>
-#include <unordered_map>
 #include <vector>
 
 #include "opentelemetry/core/timestamp.h"
 #include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/flat_attribute_map.h"
+#include "opentelemetry/sdk/common/string_intern_table.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 #include "opentelemetry/trace/canonical_code.h"
@@ -26,6 +27,9 @@ namespace zpages
 class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
 {
 public:
+  using Attributes = opentelemetry::sdk::common::FlatAttributeMap<
+      opentelemetry::sdk::trace::kSpanAttributesInlineCapacity>;
+
   /**
    * Get the trace id for this span
    * @return the trace id for this span
@@ -73,7 +77,18 @@ class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
   opentelemetry::nostd::string_view GetName() const noexcept
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    return name_;
+    return interned_name_.IsValid() ? interned_name_.GetValue() : nostd::string_view{name_};
+  }
+
+  /**
+   * Get the interned name for this span
+   * @return the interned name for this span, or an invalid handle if the name
+   * could not be interned
+   */
+  opentelemetry::sdk::common::InternedString GetInternedName() const noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return interned_name_;
   }
 
   /**
@@ -120,8 +135,7 @@ class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
    * Get the attributes for this span
    * @return the attributes for this span
    */
-  std::unordered_map<std::string, opentelemetry::sdk::common::OwnedAttributeValue> GetAttributes()
-      const noexcept
+  Attributes GetAttributes() const noexcept
   {
     std::lock_guard<std::mutex> lock(mutex_);
     return attributes_;
@@ -138,7 +152,7 @@ class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
   void SetAttribute(nostd::string_view key, const common::AttributeValue &value) noexcept override
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    attributes_[std::string(key)] = nostd::visit(converter_, value);
+    attributes_.SetAttribute(key, value);
   }
 
   void SetStatus(opentelemetry::trace::StatusCode code,
@@ -151,8 +165,17 @@ class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
 
   void SetName(nostd::string_view name) noexcept override
   {
+    auto interned_name = opentelemetry::sdk::common::StringInternTable::GetInstance().Intern(name);
     std::lock_guard<std::mutex> lock(mutex_);
-    name_ = std::string(name);
+    interned_name_ = interned_name;
+    if (interned_name_.IsValid())
+    {
+      name_.clear();
+    }
+    else
+    {
+      name_ = std::string(name);
+    }
   }
 
   void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
@@ -207,12 +230,12 @@ class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
         parent_span_id_(threadsafe_span_data.parent_span_id_),
         start_time_(threadsafe_span_data.start_time_),
         duration_(threadsafe_span_data.duration_),
+        interned_name_(threadsafe_span_data.interned_name_),
         name_(threadsafe_span_data.name_),
         status_code_(threadsafe_span_data.status_code_),
         status_desc_(threadsafe_span_data.status_desc_),
         attributes_(threadsafe_span_data.attributes_),
-        events_(threadsafe_span_data.events_),
-        converter_(threadsafe_span_data.converter_)
+        events_(threadsafe_span_data.events_)
   {}
 
   mutable std::mutex mutex_;
@@ -220,13 +243,13 @@ class ThreadsafeSpanData final : public opentelemetry::sdk::trace::Recordable
   opentelemetry::trace::SpanId parent_span_id_;
   core::SystemTimestamp start_time_;
   std::chrono::nanoseconds duration_{0};
+  opentelemetry::sdk::common::InternedString interned_name_;
   std::string name_;
   opentelemetry::trace::SpanKind span_kind_;
   opentelemetry::trace::StatusCode status_code_{opentelemetry::trace::StatusCode::kUnset};
   std::string status_desc_;
-  std::unordered_map<std::string, opentelemetry::sdk::common::OwnedAttributeValue> attributes_;
+  Attributes attributes_;
   std::vector<opentelemetry::sdk::trace::SpanDataEvent> events_;
-  opentelemetry::sdk::common::AttributeConverter converter_;
 };
 }  // namespace zpages
 }  // namespace ext
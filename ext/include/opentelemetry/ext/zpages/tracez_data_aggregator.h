@@ -1,13 +1,11 @@
 #pragma once
 
 #include <array>
-#include <atomic>
-#include <condition_variable>
 #include <list>
 #include <map>
 #include <mutex>
 #include <string>
-#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "opentelemetry/ext/zpages/latency_boundaries.h"
@@ -15,6 +13,7 @@
 #include "opentelemetry/ext/zpages/tracez_shared_data.h"
 #include "opentelemetry/nostd/span.h"
 #include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/executor.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 #include "opentelemetry/trace/canonical_code.h"
 
@@ -30,8 +29,8 @@ namespace zpages
  * converting it to useful information that can be made available to
  * display on the tracez zpage.
  *
- * When this object is created it starts a thread that calls a function
- * periodically to update the aggregated data with new spans.
+ * When this object is created it schedules a task on an executor that calls a
+ * function periodically to update the aggregated data with new spans.
  *
  * The only exposed function is a getter that returns a copy of the aggregated
  * data when requested. This function is ensured to be called in sequence to the
@@ -44,15 +43,18 @@ class TracezDataAggregator
 {
 public:
   /**
-   * Constructor creates a thread that calls a function to aggregate span data
+   * Constructor schedules a task that calls a function to aggregate span data
    * at regular intervals.
    * @param shared_data is the shared set of spans to expose.
    * @param update_interval the time duration for updating the aggregated data.
+   * @param executor the executor to run the task on, which may be shared with
+   * other components. If empty, the aggregator creates an executor of its own.
    */
   TracezDataAggregator(std::shared_ptr<TracezSharedData> shared_data,
-                       milliseconds update_interval = milliseconds(10));
+                       milliseconds update_interval                    = milliseconds(10),
+                       std::shared_ptr<sdk::common::Executor> executor = nullptr);
 
-  /** Ends the thread set up in the constructor and destroys the object **/
+  /** Ends the task set up in the constructor and destroys the object **/
   ~TracezDataAggregator();
 
   /**
@@ -75,6 +77,15 @@ class TracezDataAggregator
    */
   void AggregateCompletedSpans(std::vector<std::unique_ptr<ThreadsafeSpanData>> &completed_spans);
 
+  /**
+   * AggregateCompletedSharedSpans is the function that is called to update the
+   * aggregation with the span data of newly completed spans, which were shared
+   * by a MultiSpanProcessor. Only the spans kept as samples are copied.
+   * @param completed_spans are the newly completed spans.
+   */
+  void AggregateCompletedSharedSpans(
+      std::vector<std::shared_ptr<const opentelemetry::sdk::trace::SpanData>> &completed_spans);
+
   /**
    * AggregateRunningSpans aggregates the data for all running spans received
    * from the span processor. Running spans are not cleared by the span
@@ -93,19 +104,40 @@ class TracezDataAggregator
    */
   void AggregateRunningSpans(std::unordered_set<ThreadsafeSpanData *> &running_spans);
 
+  /**
+   * AggregateRunningSharedSpans aggregates the data for the running spans
+   * recorded by a MultiSpanProcessor, in the same way as AggregateRunningSpans.
+   * @param running_spans is the running spans to be aggregated.
+   */
+  void AggregateRunningSharedSpans(
+      std::vector<std::shared_ptr<const ThreadsafeSpanData>> &running_spans);
+
   /**
    * AggregateStatusOKSpans is the function called to update the data of spans
    * with status code OK.
    * @param ok_span is the span who's data is to be aggregated
+   * @param tracez_data is the aggregated data for the name of the span
    */
-  void AggregateStatusOKSpan(std::unique_ptr<ThreadsafeSpanData> &ok_span);
+  void AggregateStatusOKSpan(std::unique_ptr<ThreadsafeSpanData> &ok_span,
+                             TracezData &tracez_data);
 
   /**
    * AggregateStatusErrorSpans is the function that is called to update the
    * data of error spans
    * @param error_span is the error span who's data is to be aggregated
+   * @param tracez_data is the aggregated data for the name of the span
+   */
+  void AggregateStatusErrorSpan(std::unique_ptr<ThreadsafeSpanData> &error_span,
+                                TracezData &tracez_data);
+
+  /**
+   * GetTracezData returns the aggregated data for the name of a span, creating
+   * it if the name was not seen before.
+   * @param span_data the span whose aggregated data is to be returned, either a
+   * ThreadsafeSpanData or a SpanData
    */
-  void AggregateStatusErrorSpan(std::unique_ptr<ThreadsafeSpanData> &error_span);
+  template <class SpanDataType>
+  TracezData &GetTracezData(const SpanDataType &span_data);
 
   /**
    * ClearRunningSpanData is a function that is used to clear all running span
@@ -117,13 +149,13 @@ class TracezDataAggregator
 
   /**
    * FindLatencyBoundary finds the latency boundary to which the duration of
-   * the given span_data belongs to
-   * @ param span_data is the ThreadsafeSpanData whose duration for which the latency
+   * a span belongs to
+   * @ param duration is the duration of the span for which the latency
    * boundary is to be found
    * @ returns LatencyBoundary is the latency boundary that the duration belongs
    * to
    */
-  LatencyBoundary FindLatencyBoundary(std::unique_ptr<ThreadsafeSpanData> &ok_span);
+  LatencyBoundary FindLatencyBoundary(std::chrono::nanoseconds duration);
 
   /**
    * InsertIntoSampleSpanList is a helper function that is called to insert
@@ -133,7 +165,17 @@ class TracezDataAggregator
    * @param span_data the span_data to be inserted into list
    */
   void InsertIntoSampleSpanList(std::list<ThreadsafeSpanData> &sample_spans,
-                                ThreadsafeSpanData &span_data);
+                                const ThreadsafeSpanData &span_data);
+
+  /**
+   * InsertIntoSampleSpanList inserts a copy of span data shared by a
+   * MultiSpanProcessor into a sample span list.
+   * @param sample_spans the sample span list into which span is to be inserted
+   * @param span_data the span_data to be inserted into list
+   */
+  void InsertIntoSampleSpanList(
+      std::list<ThreadsafeSpanData> &sample_spans,
+      const std::shared_ptr<const opentelemetry::sdk::trace::SpanData> &span_data);
 
   /** Instance of shared spans used to collect raw data **/
   std::shared_ptr<TracezSharedData> tracez_shared_data_;
@@ -148,19 +190,19 @@ class TracezDataAggregator
    * DS based on frequency of usage of a span name.
    */
   std::map<std::string, TracezData> aggregated_tracez_data_;
-  std::mutex mtx_;
-
-  /** A boolean that is set to true in the constructor and false in the
-   * destructor to start and end execution of aggregate spans **/
-  std::atomic<bool> execute_;
 
-  /** Thread that executes aggregate spans at regurlar intervals during this
-  object's lifetime**/
-  std::thread aggregate_spans_thread_;
+  /**
+   * Entries of aggregated_tracez_data_ keyed by the id of the interned span
+   * name, so that spans with interned names are aggregated without comparing
+   * strings. Cleared whenever entries may have been removed.
+   */
+  std::unordered_map<uint32_t, TracezData *> tracez_data_by_name_id_;
+  std::mutex mtx_;
 
-  /** Condition variable that notifies the thread when object is about to be
-  destroyed **/
-  std::condition_variable cv_;
+  /** Executor and task that executes aggregate spans at regular intervals
+  during this object's lifetime **/
+  std::shared_ptr<sdk::common::Executor> executor_;
+  std::unique_ptr<sdk::common::ScheduledTask> aggregate_spans_task_;
 };
 
 }  // namespace zpages
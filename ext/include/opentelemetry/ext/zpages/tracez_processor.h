@@ -42,7 +42,8 @@ class TracezSpanProcessor : public opentelemetry::sdk::trace::SpanProcessor
 
   /*
    * OnStart is called when a span starts; the recordable is cast to span_data and added to
-   * running_spans.
+   * running_spans. Spans recorded by a MultiSpanProcessor are tracked by their identity and
+   * start, as their span data is not thread-safe.
    * @param span a recordable for a span that was just started
    */
   void OnStart(opentelemetry::sdk::trace::Recordable &span,
@@ -50,7 +51,8 @@ class TracezSpanProcessor : public opentelemetry::sdk::trace::SpanProcessor
 
   /*
    * OnEnd is called when a span ends; that span_data is moved from running_spans to
-   * completed_spans
+   * completed_spans. Spans shared by a MultiSpanProcessor are kept in completed_spans without
+   * copying them.
    * @param span a recordable for a span that was ended
    */
   void OnEnd(std::unique_ptr<opentelemetry::sdk::trace::Recordable> &&span) noexcept override;
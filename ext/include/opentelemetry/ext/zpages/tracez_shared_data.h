@@ -3,6 +3,7 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -10,6 +11,7 @@
 #include "opentelemetry/ext/zpages/threadsafe_span_data.h"
 #include "opentelemetry/sdk/trace/processor.h"
 #include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/sdk/trace/span_data.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace ext
@@ -27,6 +29,12 @@ class TracezSharedData
   {
     std::unordered_set<ThreadsafeSpanData *> running;
     std::vector<std::unique_ptr<ThreadsafeSpanData>> completed;
+
+    // Spans recorded by a MultiSpanProcessor: the identity and start of the
+    // running spans, and the span data shared with the other processors once
+    // the spans have ended.
+    std::vector<std::shared_ptr<const ThreadsafeSpanData>> running_shared;
+    std::vector<std::shared_ptr<const opentelemetry::sdk::trace::SpanData>> completed_shared;
   };
 
   /*
@@ -44,6 +52,20 @@ class TracezSharedData
    */
   void OnEnd(std::unique_ptr<ThreadsafeSpanData> &&span) noexcept;
 
+  /*
+   * Called when a span recorded by a MultiSpanProcessor has been started.
+   * @param span_data the span data the span is recorded into
+   * @param span the identity and start of the span
+   */
+  void OnStart(const opentelemetry::sdk::trace::SpanData *span_data,
+               std::shared_ptr<const ThreadsafeSpanData> span) noexcept;
+
+  /*
+   * Called when a span recorded by a MultiSpanProcessor has ended.
+   * @param span_data the span data shared with the other processors
+   */
+  void OnEnd(std::shared_ptr<const opentelemetry::sdk::trace::SpanData> span_data) noexcept;
+
   /*
    * Returns a snapshot of all spans stored. This snapshot has a copy of the
    * stored running_spans and gives ownership of completed spans to the caller.
@@ -58,6 +80,10 @@ class TracezSharedData
 private:
   mutable std::mutex mtx_;
   CollectedSpans spans_;
+  // The running spans recorded by a MultiSpanProcessor, by their span data.
+  std::unordered_map<const opentelemetry::sdk::trace::SpanData *,
+                     std::shared_ptr<const ThreadsafeSpanData>>
+      running_shared_;
 };
 }  // namespace zpages
 }  // namespace ext
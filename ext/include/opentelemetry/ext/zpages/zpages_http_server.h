@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "opentelemetry/ext/http/server/http_server.h"
+#include "opentelemetry/version.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace ext
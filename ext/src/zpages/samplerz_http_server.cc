@@ -0,0 +1,48 @@
+#include "opentelemetry/ext/zpages/samplerz_http_server.h"
+
+#include <cstdlib>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace ext
+{
+namespace zpages
+{
+
+int SamplerzHttpServer::HandleRequest(HTTP_SERVER_NS::HttpRequest const &req,
+                                      HTTP_SERVER_NS::HttpResponse &resp)
+{
+  std::string query                          = GetQuery(req.uri);  // samplerz
+  resp.headers[HTTP_SERVER_NS::CONTENT_TYPE] = "text/plain";
+
+  if (StartsWith(query, "ratio"))
+  {
+    if (req.method != "POST")
+    {
+      resp.body = "The ratio must be set with POST";
+      return 405;
+    }
+    auto value   = GetAfterSlash(query);
+    char *end    = nullptr;
+    double ratio = std::strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || !(ratio >= 0.0 && ratio <= 1.0))
+    {
+      resp.body = "Invalid ratio: " + value;
+      return 400;
+    }
+    sampler_->SetRatio(ratio);
+  }
+  else if (!query.empty() && query != "/samplerz")
+  {
+    resp.body = "Invalid query: " + query;
+    return 404;
+  }
+
+  // Another request may change the ratio while the description is copied.
+  opentelemetry::sdk::common::EpochGuard guard;
+  resp.body = std::string(sampler_->GetDescription());
+  return 200;
+}
+
+}  // namespace zpages
+}  // namespace ext
+OPENTELEMETRY_END_NAMESPACE
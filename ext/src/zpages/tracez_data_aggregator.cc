@@ -1,4 +1,5 @@
 #include "opentelemetry/ext/zpages/tracez_data_aggregator.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace ext
@@ -7,31 +8,27 @@ namespace zpages
 {
 
 TracezDataAggregator::TracezDataAggregator(std::shared_ptr<TracezSharedData> shared_data,
-                                           milliseconds update_interval)
+                                           milliseconds update_interval,
+                                           std::shared_ptr<sdk::common::Executor> executor)
 {
   tracez_shared_data_ = shared_data;
+  executor_           = executor ? std::move(executor) : std::make_shared<sdk::common::Executor>();
 
-  // Start a thread that calls AggregateSpans periodically or till notified.
-  execute_.store(true, std::memory_order_release);
-  aggregate_spans_thread_ = std::thread([this, update_interval]() {
-    while (execute_.load(std::memory_order_acquire))
-    {
-      std::unique_lock<std::mutex> lock(mtx_);
-      AggregateSpans();
-      cv_.wait_for(lock, update_interval);
-    }
-  });
+  // Schedule a task that calls AggregateSpans periodically.
+  aggregate_spans_task_.reset(new sdk::common::ScheduledTask(
+      executor_,
+      [this, update_interval]() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        AggregateSpans();
+        return update_interval;
+      },
+      milliseconds(0)));
 }
 
 TracezDataAggregator::~TracezDataAggregator()
 {
-  // Notify and join the thread so object can be destroyed without wait for wake
-  if (execute_.load(std::memory_order_acquire))
-  {
-    execute_.store(false, std::memory_order_release);
-    cv_.notify_one();
-    aggregate_spans_thread_.join();
-  }
+  // Stop the task so object can be destroyed while it is not running
+  aggregate_spans_task_->Stop();
 }
 
 std::map<std::string, TracezData> TracezDataAggregator::GetAggregatedTracezData()
@@ -40,20 +37,18 @@ std::map<std::string, TracezData> TracezDataAggregator::GetAggregatedTracezData(
   return aggregated_tracez_data_;
 }
 
-LatencyBoundary TracezDataAggregator::FindLatencyBoundary(
-    std::unique_ptr<ThreadsafeSpanData> &span_data)
+LatencyBoundary TracezDataAggregator::FindLatencyBoundary(std::chrono::nanoseconds duration)
 {
-  const auto &span_data_duration = span_data->GetDuration();
   for (unsigned int boundary = 0; boundary < kLatencyBoundaries.size() - 1; boundary++)
   {
-    if (span_data_duration < kLatencyBoundaries[boundary + 1])
+    if (duration < kLatencyBoundaries[boundary + 1])
       return (LatencyBoundary)boundary;
   }
   return LatencyBoundary::k100SecondToMax;
 }
 
 void TracezDataAggregator::InsertIntoSampleSpanList(std::list<ThreadsafeSpanData> &sample_spans,
-                                                    ThreadsafeSpanData &span_data)
+                                                    const ThreadsafeSpanData &span_data)
 {
   /**
    * Check to see if the sample span list size exceeds the set limit, if it does
@@ -66,8 +61,23 @@ void TracezDataAggregator::InsertIntoSampleSpanList(std::list<ThreadsafeSpanData
   sample_spans.push_back(ThreadsafeSpanData(span_data));
 }
 
+void TracezDataAggregator::InsertIntoSampleSpanList(
+    std::list<ThreadsafeSpanData> &sample_spans,
+    const std::shared_ptr<const opentelemetry::sdk::trace::SpanData> &span_data)
+{
+  if (sample_spans.size() == kMaxNumberOfSampleSpans)
+  {
+    sample_spans.pop_front();
+  }
+  sample_spans.emplace_back();
+  opentelemetry::sdk::trace::SharedSpanData(span_data).CopyTo(sample_spans.back());
+}
+
 void TracezDataAggregator::ClearRunningSpanData()
 {
+  // Entries may be erased below, so the lookup by name id is rebuilt while aggregating.
+  tracez_data_by_name_id_.clear();
+
   auto it = aggregated_tracez_data_.begin();
   while (it != aggregated_tracez_data_.end())
   {
@@ -93,21 +103,45 @@ void TracezDataAggregator::ClearRunningSpanData()
   }
 }
 
-void TracezDataAggregator::AggregateStatusOKSpan(std::unique_ptr<ThreadsafeSpanData> &ok_span)
+template <class SpanDataType>
+TracezData &TracezDataAggregator::GetTracezData(const SpanDataType &span_data)
+{
+  // Span names are usually interned, in which case the data is found by the id
+  // of the name without building a string or comparing names.
+  auto interned_name = span_data.GetInternedName();
+  if (interned_name.IsValid())
+  {
+    auto it = tracez_data_by_name_id_.find(interned_name.GetId());
+    if (it != tracez_data_by_name_id_.end())
+    {
+      return *it->second;
+    }
+    auto name         = interned_name.GetValue();
+    auto &tracez_data = aggregated_tracez_data_[std::string(name.data(), name.size())];
+
+    tracez_data_by_name_id_[interned_name.GetId()] = &tracez_data;
+    return tracez_data;
+  }
+
+  auto name = span_data.GetName();
+  return aggregated_tracez_data_[std::string(name.data(), name.size())];
+}
+
+void TracezDataAggregator::AggregateStatusOKSpan(std::unique_ptr<ThreadsafeSpanData> &ok_span,
+                                                 TracezData &tracez_data)
 {
   // Find and update boundary of aggregated data that span belongs
-  auto boundary_name = FindLatencyBoundary(ok_span);
+  auto boundary_name = FindLatencyBoundary(ok_span->GetDuration());
 
-  // Get the data for name in aggrgation and update count and sample spans
-  auto &tracez_data = aggregated_tracez_data_.at(ok_span->GetName().data());
+  // Update count and sample spans
   InsertIntoSampleSpanList(tracez_data.sample_latency_spans[boundary_name], *ok_span.get());
   tracez_data.completed_span_count_per_latency_bucket[boundary_name]++;
 }
 
-void TracezDataAggregator::AggregateStatusErrorSpan(std::unique_ptr<ThreadsafeSpanData> &error_span)
+void TracezDataAggregator::AggregateStatusErrorSpan(std::unique_ptr<ThreadsafeSpanData> &error_span,
+                                                    TracezData &tracez_data)
 {
-  // Get data for name in aggregation and update count and sample spans
-  auto &tracez_data = aggregated_tracez_data_.at(error_span->GetName().data());
+  // Update count and sample spans
   InsertIntoSampleSpanList(tracez_data.sample_error_spans, *error_span.get());
   tracez_data.error_span_count++;
 }
@@ -117,18 +151,53 @@ void TracezDataAggregator::AggregateCompletedSpans(
 {
   for (auto &completed_span : completed_spans)
   {
-    std::string span_name = completed_span->GetName().data();
+    auto &tracez_data = GetTracezData(*completed_span);
 
-    if (aggregated_tracez_data_.find(span_name) == aggregated_tracez_data_.end())
-    {
-      aggregated_tracez_data_[span_name] = TracezData();
-    }
+    if (completed_span->GetStatus() == trace::StatusCode::kOk ||
+        completed_span->GetStatus() == trace::StatusCode::kUnset)
+      AggregateStatusOKSpan(completed_span, tracez_data);
+    else
+      AggregateStatusErrorSpan(completed_span, tracez_data);
+  }
+}
+
+void TracezDataAggregator::AggregateCompletedSharedSpans(
+    std::vector<std::shared_ptr<const opentelemetry::sdk::trace::SpanData>> &completed_spans)
+{
+  // Every span is counted, but only the last kMaxNumberOfSampleSpans spans of
+  // each sample list are kept, so the sample lists are determined first, and
+  // only the spans which are kept are copied.
+  std::vector<std::list<ThreadsafeSpanData> *> sample_spans_of_span;
+  std::unordered_map<std::list<ThreadsafeSpanData> *, size_t> num_spans_by_sample_spans;
+  sample_spans_of_span.reserve(completed_spans.size());
+  for (auto &completed_span : completed_spans)
+  {
+    auto &tracez_data = GetTracezData(*completed_span);
 
+    std::list<ThreadsafeSpanData> *sample_spans;
     if (completed_span->GetStatus() == trace::StatusCode::kOk ||
         completed_span->GetStatus() == trace::StatusCode::kUnset)
-      AggregateStatusOKSpan(completed_span);
+    {
+      auto boundary_name = FindLatencyBoundary(completed_span->GetDuration());
+      sample_spans       = &tracez_data.sample_latency_spans[boundary_name];
+      tracez_data.completed_span_count_per_latency_bucket[boundary_name]++;
+    }
     else
-      AggregateStatusErrorSpan(completed_span);
+    {
+      sample_spans = &tracez_data.sample_error_spans;
+      tracez_data.error_span_count++;
+    }
+    sample_spans_of_span.push_back(sample_spans);
+    ++num_spans_by_sample_spans[sample_spans];
+  }
+
+  for (size_t i = 0; i < completed_spans.size(); ++i)
+  {
+    auto &num_spans_after = --num_spans_by_sample_spans[sample_spans_of_span[i]];
+    if (num_spans_after < static_cast<size_t>(kMaxNumberOfSampleSpans))
+    {
+      InsertIntoSampleSpanList(*sample_spans_of_span[i], completed_spans[i]);
+    }
   }
 }
 
@@ -137,16 +206,19 @@ void TracezDataAggregator::AggregateRunningSpans(
 {
   for (auto &running_span : running_spans)
   {
-    std::string span_name = running_span->GetName().data();
-
-    if (aggregated_tracez_data_.find(span_name) == aggregated_tracez_data_.end())
-    {
-      aggregated_tracez_data_[span_name] = TracezData();
-    }
+    auto &tracez_data = GetTracezData(*running_span);
+    InsertIntoSampleSpanList(tracez_data.sample_running_spans, *running_span);
+    tracez_data.running_span_count++;
+  }
+}
 
-    auto &tracez_data = aggregated_tracez_data_[span_name];
-    InsertIntoSampleSpanList(aggregated_tracez_data_[span_name].sample_running_spans,
-                             *running_span);
+void TracezDataAggregator::AggregateRunningSharedSpans(
+    std::vector<std::shared_ptr<const ThreadsafeSpanData>> &running_spans)
+{
+  for (auto &running_span : running_spans)
+  {
+    auto &tracez_data = GetTracezData(*running_span);
+    InsertIntoSampleSpanList(tracez_data.sample_running_spans, *running_span);
     tracez_data.running_span_count++;
   }
 }
@@ -178,7 +250,9 @@ void TracezDataAggregator::AggregateSpans()
    **/
   ClearRunningSpanData();
   AggregateCompletedSpans(span_snapshot.completed);
+  AggregateCompletedSharedSpans(span_snapshot.completed_shared);
   AggregateRunningSpans(span_snapshot.running);
+  AggregateRunningSharedSpans(span_snapshot.running_shared);
 }
 
 }  // namespace zpages
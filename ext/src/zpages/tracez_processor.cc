@@ -1,4 +1,6 @@
 #include "opentelemetry/ext/zpages/tracez_processor.h"
+#include "opentelemetry/sdk/trace/multi_span_processor.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace ext
@@ -9,12 +11,38 @@ namespace zpages
 void TracezSpanProcessor::OnStart(opentelemetry::sdk::trace::Recordable &span,
                                   const opentelemetry::trace::SpanContext &parent_context) noexcept
 {
-  shared_data_->OnStart(static_cast<ThreadsafeSpanData *>(&span));
+  auto span_data = dynamic_cast<ThreadsafeSpanData *>(&span);
+  if (span_data != nullptr)
+  {
+    shared_data_->OnStart(span_data);
+    return;
+  }
+
+  // The span data of a MultiSpanProcessor is modified without a lock while the
+  // span runs, so only the identity and start of the span are tracked.
+  auto shared_span_data = opentelemetry::sdk::trace::MultiSpanProcessor::GetSpanData(span);
+  if (shared_span_data != nullptr)
+  {
+    std::shared_ptr<ThreadsafeSpanData> running_span(new ThreadsafeSpanData);
+    running_span->SetIdentity(shared_span_data->GetSpanContext(),
+                              shared_span_data->GetParentSpanId());
+    running_span->SetName(shared_span_data->GetName());
+    running_span->SetSpanKind(shared_span_data->GetSpanKind());
+    running_span->SetStartTime(shared_span_data->GetStartTime());
+    shared_data_->OnStart(shared_span_data, std::move(running_span));
+  }
 }
 
 void TracezSpanProcessor::OnEnd(
     std::unique_ptr<opentelemetry::sdk::trace::Recordable> &&span) noexcept
 {
+  auto shared_span = dynamic_cast<opentelemetry::sdk::trace::SharedSpanData *>(span.get());
+  if (shared_span != nullptr)
+  {
+    shared_data_->OnEnd(shared_span->GetSharedSpanData());
+    return;
+  }
+
   shared_data_->OnEnd(
       std::unique_ptr<ThreadsafeSpanData>(static_cast<ThreadsafeSpanData *>(span.release())));
 }
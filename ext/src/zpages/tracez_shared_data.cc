@@ -23,6 +23,21 @@ void TracezSharedData::OnEnd(std::unique_ptr<ThreadsafeSpanData> &&span) noexcep
   }
 }
 
+void TracezSharedData::OnStart(const opentelemetry::sdk::trace::SpanData *span_data,
+                               std::shared_ptr<const ThreadsafeSpanData> span) noexcept
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  running_shared_[span_data] = std::move(span);
+}
+
+void TracezSharedData::OnEnd(
+    std::shared_ptr<const opentelemetry::sdk::trace::SpanData> span_data) noexcept
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  running_shared_.erase(span_data.get());
+  spans_.completed_shared.push_back(std::move(span_data));
+}
+
 TracezSharedData::CollectedSpans TracezSharedData::GetSpanSnapshot() noexcept
 {
   CollectedSpans snapshot;
@@ -30,6 +45,13 @@ TracezSharedData::CollectedSpans TracezSharedData::GetSpanSnapshot() noexcept
   snapshot.running   = spans_.running;
   snapshot.completed = std::move(spans_.completed);
   spans_.completed.clear();
+  snapshot.running_shared.reserve(running_shared_.size());
+  for (const auto &running_span : running_shared_)
+  {
+    snapshot.running_shared.push_back(running_span.second);
+  }
+  snapshot.completed_shared = std::move(spans_.completed_shared);
+  spans_.completed_shared.clear();
   return snapshot;
 }
 
@@ -0,0 +1,103 @@
+#include "opentelemetry/ext/zpages/samplerz_http_server.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+
+using opentelemetry::ext::zpages::SamplerzHttpServer;
+using opentelemetry::sdk::trace::TraceIdRatioBasedSampler;
+
+namespace
+{
+constexpr int kPort = 19010;
+
+/*
+ * Sends a request to the server, and reads the response until the server
+ * closes the connection.
+ * @return the status code and the body of the response
+ */
+std::pair<int, std::string> SendRequest(const std::string &method, const std::string &uri)
+{
+  SocketTools::Socket socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (!socket.connect(SocketTools::SocketAddr(SocketTools::SocketAddr::Loopback, kPort)))
+  {
+    socket.close();
+    return {0, ""};
+  }
+  std::string request = method + " " + uri +
+                        " HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n"
+                        "Content-Length: 0\r\n\r\n";
+  socket.send(request.data(), static_cast<unsigned>(request.size()));
+
+  std::string response;
+  char buffer[1024];
+  for (int size; (size = socket.recv(buffer, sizeof(buffer))) > 0;)
+  {
+    response.append(buffer, static_cast<size_t>(size));
+  }
+  socket.close();
+
+  // HTTP/1.1 200 OK\r\n<headers>\r\n\r\n<body>
+  auto status_start = response.find(' ');
+  auto body_start   = response.find("\r\n\r\n");
+  if (status_start == std::string::npos || body_start == std::string::npos)
+  {
+    return {0, ""};
+  }
+  return {std::atoi(response.c_str() + status_start + 1), response.substr(body_start + 4)};
+}
+
+class SamplerzHttpServerTest : public ::testing::Test
+{
+protected:
+  SamplerzHttpServerTest()
+      : sampler_(std::make_shared<TraceIdRatioBasedSampler>(0.5)),
+        server_(sampler_, "localhost", kPort)
+  {}
+
+  void SetUp() override
+  {
+    server_.setKeepalive(false);
+    server_.start();
+  }
+
+  void TearDown() override { server_.stop(); }
+
+  std::shared_ptr<TraceIdRatioBasedSampler> sampler_;
+  SamplerzHttpServer server_;
+};
+}  // namespace
+
+TEST_F(SamplerzHttpServerTest, GetsDescription)
+{
+  auto response = SendRequest("GET", "/samplerz");
+  EXPECT_EQ(response.first, 200);
+  EXPECT_EQ(response.second, "TraceIdRatioBasedSampler{0.500000}");
+}
+
+TEST_F(SamplerzHttpServerTest, SetsRatio)
+{
+  auto response = SendRequest("POST", "/samplerz/ratio/0.01");
+  EXPECT_EQ(response.first, 200);
+  EXPECT_EQ(response.second, "TraceIdRatioBasedSampler{0.010000}");
+  EXPECT_EQ(sampler_->GetDescription(), "TraceIdRatioBasedSampler{0.010000}");
+}
+
+TEST_F(SamplerzHttpServerTest, RequiresPostToSetRatio)
+{
+  auto response = SendRequest("GET", "/samplerz/ratio/0.01");
+  EXPECT_EQ(response.first, 405);
+  EXPECT_EQ(sampler_->GetDescription(), "TraceIdRatioBasedSampler{0.500000}");
+}
+
+TEST_F(SamplerzHttpServerTest, RejectsInvalidRatios)
+{
+  for (auto uri : {"/samplerz/ratio/", "/samplerz/ratio/abc", "/samplerz/ratio/1.5"})
+  {
+    EXPECT_EQ(SendRequest("POST", uri).first, 400) << uri;
+  }
+  EXPECT_EQ(sampler_->GetDescription(), "TraceIdRatioBasedSampler{0.500000}");
+}
@@ -4,6 +4,7 @@
 
 #include "opentelemetry/ext/zpages/tracez_processor.h"
 #include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/multi_span_processor.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/sdk/trace/tracer.h"
 
@@ -689,3 +690,37 @@ TEST_F(TracezDataAggregatorTest, NoChangeInBetweenCallsToAggregator)
 
   running_span->End();
 }
+
+/** Test to check that spans recorded by a MultiSpanProcessor are aggregated,
+ * and only as many completed spans as kept as samples are copied **/
+TEST(TracezDataAggregator, SpansOfMultiSpanProcessor)
+{
+  std::shared_ptr<TracezSharedData> shared_data(new TracezSharedData());
+  std::shared_ptr<SpanProcessor> processor(new MultiSpanProcessor(
+      {std::shared_ptr<SpanProcessor>(new TracezSpanProcessor(shared_data))}));
+  auto resource = opentelemetry::sdk::resource::Resource::Create({});
+  std::shared_ptr<opentelemetry::trace::Tracer> tracer(new Tracer(processor, resource));
+  TracezDataAggregator tracez_data_aggregator(shared_data, milliseconds(10));
+
+  auto running_span = tracer->StartSpan(span_name1);
+  for (int i = 0; i < 2 * kMaxNumberOfSampleSpans; i++)
+  {
+    tracer->StartSpan(span_name2)->End();
+  }
+  auto error_span = tracer->StartSpan(span_name2);
+  error_span->SetStatus(opentelemetry::trace::StatusCode::kError, "error");
+  error_span->End();
+
+  std::this_thread::sleep_for(milliseconds(500));
+  auto data = tracez_data_aggregator.GetAggregatedTracezData();
+  ASSERT_EQ(data.size(), 2);
+  VerifySpanCountsInTracezData(span_name1, data.at(span_name1), 1, 0,
+                               {0, 0, 0, 0, 0, 0, 0, 0, 0});
+  EXPECT_EQ(data.at(span_name1).sample_running_spans.front().GetSpanId(),
+            running_span->GetContext().span_id());
+  VerifySpanCountsInTracezData(span_name2, data.at(span_name2), 0, 1,
+                               {2 * kMaxNumberOfSampleSpans, 0, 0, 0, 0, 0, 0, 0, 0});
+  EXPECT_EQ(data.at(span_name2).sample_error_spans.front().GetDescription(), "error");
+
+  running_span->End();
+}
@@ -7,6 +7,8 @@
 #include "opentelemetry/ext/zpages/threadsafe_span_data.h"
 #include "opentelemetry/nostd/span.h"
 #include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/multi_span_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
 #include "opentelemetry/sdk/trace/tracer.h"
 
 using namespace opentelemetry::sdk::trace;
@@ -634,3 +636,30 @@ TEST_F(TracezProcessor, RunningSnapshotCompletedThreadSafety)
 
   EndAllSpans(spans2);
 }
+
+/*
+ * Test that spans recorded by a MultiSpanProcessor are tracked while running, and that the
+ * span data shared once they end is kept without copying it.
+ */
+TEST_F(TracezProcessor, SpansOfMultiSpanProcessor)
+{
+  std::shared_ptr<SpanProcessor> multi_processor(
+      new MultiSpanProcessor({std::shared_ptr<SpanProcessor>(processor)}));
+  auto resource = opentelemetry::sdk::resource::Resource::Create({});
+  std::shared_ptr<opentelemetry::trace::Tracer> multi_tracer(new Tracer(multi_processor, resource));
+
+  auto span  = multi_tracer->StartSpan(span_names[0]);
+  auto spans = shared_data->GetSpanSnapshot();
+  ASSERT_EQ(spans.running_shared.size(), 1);
+  EXPECT_EQ(spans.running_shared[0]->GetName(), span_names[0]);
+  EXPECT_EQ(spans.running_shared[0]->GetSpanId(), span->GetContext().span_id());
+  EXPECT_EQ(spans.completed_shared.size(), 0);
+
+  span->End();
+  spans = shared_data->GetSpanSnapshot();
+  EXPECT_EQ(spans.running_shared.size(), 0);
+  ASSERT_EQ(spans.completed_shared.size(), 1);
+  EXPECT_EQ(spans.completed_shared[0]->GetName(), span_names[0]);
+  EXPECT_EQ(spans.running.size(), 0);
+  EXPECT_EQ(spans.completed.size(), 0);
+}
@@ -2,7 +2,7 @@
 
 #include <atomic>
 #include <memory>
-#include <mutex>
+#include "opentelemetry/sdk/common/epoch_reclaimer.h"
 #include "opentelemetry/version.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -11,49 +11,50 @@ namespace sdk
 namespace common
 {
 /**
- * A wrapper to provide atomic shared pointers.
+ * A wrapper to provide atomic shared pointers for values that are read very
+ * frequently and replaced rarely, such as the span processor of a tracer.
  *
- * This wrapper relies on a mutex for gcc 4.8, and specializations of
- * std::atomic_store and std::atomic_load for all other instances.
+ * The current value is published through an atomic pointer, so readers never
+ * take a lock, and get() does not touch any reference count. To make this safe
+ * without tracking readers, values replaced by store() are retired with
+ * RetireAfterGracePeriod: raw pointers obtained from get() stay valid for as
+ * long as the EpochGuard held while calling get().
  */
-#if (__GNUC__ == 4 && (__GNUC_MINOR__ >= 8))
 template <class T>
 class AtomicSharedPtr
 {
 public:
-  explicit AtomicSharedPtr(std::shared_ptr<T> ptr) noexcept : ptr_{std::move(ptr)} {}
+  explicit AtomicSharedPtr(std::shared_ptr<T> ptr) noexcept
+      : current_(new std::shared_ptr<T>(std::move(ptr)))
+  {}
+
+  // Readers must be gone once the AtomicSharedPtr itself is destroyed.
+  ~AtomicSharedPtr() { delete current_.load(); }
+
+  AtomicSharedPtr(const AtomicSharedPtr &) = delete;
+  AtomicSharedPtr &operator=(const AtomicSharedPtr &) = delete;
 
   void store(const std::shared_ptr<T> &other) noexcept
   {
-    std::lock_guard<std::mutex> lock_guard{mu_};
-    ptr_ = other;
+    auto *previous = current_.exchange(new std::shared_ptr<T>(other));
+    RetireAfterGracePeriod(std::shared_ptr<const void>(previous));
   }
 
   std::shared_ptr<T> load() const noexcept
   {
-    std::lock_guard<std::mutex> lock_guard{mu_};
-    return ptr_;
+    EpochGuard guard;
+    return *current_.load();
   }
 
-private:
-  std::shared_ptr<T> ptr_;
-  mutable std::mutex mu_;
-};
-#else
-template <class T>
-class AtomicSharedPtr
-{
-public:
-  explicit AtomicSharedPtr(std::shared_ptr<T> ptr) noexcept : ptr_{std::move(ptr)} {}
-
-  void store(const std::shared_ptr<T> &other) noexcept { std::atomic_store(&ptr_, other); }
-
-  std::shared_ptr<T> load() const noexcept { return std::atomic_load(&ptr_); }
+  /**
+   * @return the current value without acquiring a reference to it. The caller
+   * must hold an EpochGuard, for as long as it uses the value.
+   */
+  T *get() const noexcept { return current_.load()->get(); }
 
 private:
-  std::shared_ptr<T> ptr_;
+  std::atomic<const std::shared_ptr<T> *> current_;
 };
-#endif
 }  // namespace common
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
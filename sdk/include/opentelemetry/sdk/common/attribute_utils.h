@@ -108,6 +108,37 @@ struct AttributeConverter
   }
 };
 
+/**
+ * Estimates the size of an OwnedAttributeValue once encoded for export, as the
+ * size of its contents plus a few bytes of framing per value.
+ */
+struct AttributeSizeEstimator
+{
+  static constexpr size_t kValueOverhead = 2;
+
+  template <typename T>
+  size_t operator()(const T &) noexcept
+  {
+    return sizeof(T) + kValueOverhead;
+  }
+  size_t operator()(const std::string &v) noexcept { return v.size() + kValueOverhead; }
+  size_t operator()(const std::vector<bool> &v) noexcept { return v.size() + kValueOverhead; }
+  size_t operator()(const std::vector<std::string> &v) noexcept
+  {
+    size_t size = kValueOverhead;
+    for (auto &s : v)
+    {
+      size += s.size() + kValueOverhead;
+    }
+    return size;
+  }
+  template <typename T>
+  size_t operator()(const std::vector<T> &v) noexcept
+  {
+    return v.size() * sizeof(T) + kValueOverhead;
+  }
+};
+
 /**
  * Class for storing attributes.
  */
@@ -138,6 +169,9 @@ class AttributeMap
     attributes_[std::string(key)] = nostd::visit(converter_, value);
   }
 
+  // Remove all attributes, keeping the allocated buckets
+  void Clear() noexcept { attributes_.clear(); }
+
 private:
   std::unordered_map<std::string, OwnedAttributeValue> attributes_;
   AttributeConverter converter_;
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/sdk/common/sharded_circular_buffer.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * What a batch processor does with an element added to its queue while the
+ * queue is full.
+ */
+enum class OverflowPolicy
+{
+  /* The new element is dropped. */
+  kDropNewest,
+  /* The oldest element in the queue is dropped to make room. */
+  kDropOldest,
+  /**
+   * The element with the lowest priority in the queue is replaced, if its
+   * priority is lower than the priority of the new element, which is dropped
+   * otherwise. The queue is scanned, so an element added to a full queue costs
+   * time proportional to the queue size.
+   */
+  kDropLowestPriority,
+  /**
+   * The producer waits for room in the queue up to a timeout, and then drops
+   * the new element.
+   */
+  kBlock
+};
+
+/**
+ * The queue of a batch processor: a ShardedCircularBuffer which applies an
+ * OverflowPolicy when full, and counts the elements it accepts and drops.
+ *
+ * The queue is full when the shard of the producer is full, or when the
+ * estimated size of all queued elements would exceed an optional memory
+ * budget in bytes.
+ *
+ * Producers only synchronize with each other and with the consumer when the
+ * queue is full, or on a shared byte counter if there is a memory budget.
+ * The consumer role may be taken over by a producer to drop elements, so
+ * consuming is serialized by a mutex.
+ */
+template <class T>
+class BatchQueue
+{
+public:
+  using Priority = std::function<int(const T &)>;
+  using Size     = std::function<size_t(const T &)>;
+
+  /**
+   * @param max_size the maximum number of elements over all shards
+   * @param num_shards the number of shards, at least one
+   * @param policy what to do when an element is added while the queue is full
+   * @param max_block_time how long to wait for room with OverflowPolicy::kBlock
+   * @param priority the priority of an element for
+   * OverflowPolicy::kDropLowestPriority, where elements with lower values are
+   * dropped first
+   * @param max_bytes the memory budget of the queue, or 0 for none. Elements
+   * estimated to be larger than the budget are always dropped.
+   * @param size the estimated size of an element in bytes, for the memory budget
+   */
+  BatchQueue(size_t max_size,
+             size_t num_shards,
+             OverflowPolicy policy                    = OverflowPolicy::kDropNewest,
+             std::chrono::milliseconds max_block_time = std::chrono::milliseconds(0),
+             Priority priority                        = nullptr,
+             size_t max_bytes                         = 0,
+             Size size                                = nullptr)
+      : buffer_{max_size, num_shards},
+        consumer_notified_{new std::atomic<bool>[buffer_.num_shards()]},
+        policy_{policy},
+        max_block_time_{max_block_time},
+        priority_{std::move(priority)},
+        max_bytes_{size ? max_bytes : 0},
+        size_{std::move(size)}
+  {
+    for (size_t i = 0; i < buffer_.num_shards(); ++i)
+    {
+      consumer_notified_[i].store(false, std::memory_order_relaxed);
+    }
+    if (policy_ == OverflowPolicy::kDropLowestPriority && !priority_)
+    {
+      policy_ = OverflowPolicy::kDropNewest;
+    }
+  }
+
+  /**
+   * Adds an element into the shard of the calling thread, applying the
+   * overflow policy if the queue is full.
+   * @param ptr a pointer to the element to add, which is reset if the element
+   * was accepted
+   * @param notify_consumer the callback to invoke to wake up the consumer,
+   * when the shard gets at least half full or before blocking. A shard which
+   * is half full notifies the consumer only once until the next Consume.
+   * @return true if the element was accepted; false, if it was dropped.
+   */
+  template <class Notify>
+  bool Add(std::unique_ptr<T> &ptr, Notify notify_consumer) noexcept
+  {
+    const size_t shard_index = buffer_.GetShardIndex();
+    auto &shard              = buffer_.GetShard(shard_index);
+    const size_t size        = max_bytes_ != 0 ? size_(*ptr) : 0;
+    if (!TryAdd(shard, ptr, size) && !AddToFullQueue(shard, ptr, size, notify_consumer))
+    {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    // Only the counters of this shard are read here, and its flag is only
+    // written once until the consumer runs.
+    auto &consumer_notified = consumer_notified_[shard_index];
+    if (shard.size() >= shard.max_size() / 2 &&
+        !consumer_notified.load(std::memory_order_relaxed) &&
+        !consumer_notified.exchange(true, std::memory_order_relaxed))
+    {
+      notify_consumer();
+    }
+    return true;
+  }
+
+  /**
+   * Consume up to n elements, as with ShardedCircularBuffer::Consume.
+   * @return the number of elements consumed
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  template <class Callback>
+  size_t Consume(size_t n, Callback callback) noexcept
+  {
+    size_t consumed;
+    {
+      std::lock_guard<std::mutex> guard{consumer_mutex_};
+      // Cleared before consuming, so that a shard filled up again meanwhile
+      // notifies the consumer again.
+      for (size_t i = 0; i < buffer_.num_shards(); ++i)
+      {
+        consumer_notified_[i].store(false, std::memory_order_relaxed);
+      }
+      consumed = buffer_.Consume(n, [&](CircularBufferRange<AtomicUniquePtr<T>> range) noexcept {
+        ReleaseBytes(range);
+        callback(range);
+      });
+    }
+    if (policy_ == OverflowPolicy::kBlock)
+    {
+      // Lock the mutex, so that no producer misses the notification between
+      // failing to add and waiting.
+      {
+        std::lock_guard<std::mutex> guard{space_mutex_};
+      }
+      space_cv_.notify_all();
+    }
+    return consumed;
+  }
+
+  /**
+   * @return the maximum number of elements that can be stored in all shards.
+   */
+  size_t max_size() const noexcept { return buffer_.max_size(); }
+
+  /**
+   * @return true if all shards are empty.
+   */
+  bool empty() const noexcept { return buffer_.empty(); }
+
+  /**
+   * @return the number of elements stored in all shards.
+   */
+  size_t size() const noexcept { return buffer_.size(); }
+
+  /**
+   * @return the estimated size in bytes of the queued elements, if the queue
+   * has a memory budget; 0, otherwise.
+   */
+  size_t queued_bytes() const noexcept { return queued_bytes_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return the overflow policy applied by the queue.
+   */
+  OverflowPolicy policy() const noexcept { return policy_; }
+
+  /**
+   * @return the number of elements added to the queue and not dropped later,
+   * to make room for other elements. Every element added is either accepted
+   * or dropped.
+   */
+  uint64_t accepted_count() const noexcept
+  {
+    return buffer_.production_count() + replaced_count_.load(std::memory_order_relaxed) -
+           evicted_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return the number of elements dropped because the queue was full, either
+   * when they were added or later to make room for other elements.
+   */
+  uint64_t dropped_count() const noexcept
+  {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+private:
+  ShardedCircularBuffer<T> buffer_;
+  // Per shard, whether the consumer was notified that the shard is half full
+  std::unique_ptr<std::atomic<bool>[]> consumer_notified_;
+  OverflowPolicy policy_;
+  std::chrono::milliseconds max_block_time_;
+  Priority priority_;
+  size_t max_bytes_;
+  Size size_;
+
+  std::mutex consumer_mutex_;
+  std::mutex space_mutex_;
+  std::condition_variable space_cv_;
+
+  std::atomic<size_t> queued_bytes_{0};
+  std::atomic<uint64_t> dropped_count_{0};
+  // Elements dropped from the queue to make room for other elements
+  std::atomic<uint64_t> evicted_count_{0};
+  // Elements which took the place of an evicted element in the queue
+  std::atomic<uint64_t> replaced_count_{0};
+
+  bool TryReserveBytes(size_t size) noexcept
+  {
+    if (max_bytes_ == 0)
+    {
+      return true;
+    }
+    size_t queued_bytes = queued_bytes_.load(std::memory_order_relaxed);
+    do
+    {
+      if (queued_bytes + size > max_bytes_)
+      {
+        return false;
+      }
+    } while (!queued_bytes_.compare_exchange_weak(queued_bytes, queued_bytes + size,
+                                                  std::memory_order_relaxed));
+    return true;
+  }
+
+  void ReleaseBytes(size_t size) noexcept
+  {
+    if (max_bytes_ != 0)
+    {
+      queued_bytes_.fetch_sub(size, std::memory_order_relaxed);
+    }
+  }
+
+  void ReleaseBytes(const CircularBufferRange<AtomicUniquePtr<T>> &range) noexcept
+  {
+    if (max_bytes_ == 0)
+    {
+      return;
+    }
+    size_t size = 0;
+    range.ForEach([&](AtomicUniquePtr<T> &ptr) noexcept {
+      size += size_(*ptr);
+      return true;
+    });
+    ReleaseBytes(size);
+  }
+
+  bool TryAdd(SequencedCircularBuffer<T> &shard, std::unique_ptr<T> &ptr, size_t size) noexcept
+  {
+    if (!TryReserveBytes(size))
+    {
+      return false;
+    }
+    if (shard.Add(ptr))
+    {
+      return true;
+    }
+    ReleaseBytes(size);
+    return false;
+  }
+
+  template <class Notify>
+  bool AddToFullQueue(SequencedCircularBuffer<T> &shard,
+                      std::unique_ptr<T> &ptr,
+                      size_t size,
+                      Notify &notify_consumer) noexcept
+  {
+    if (shard.max_size() == 0 || (max_bytes_ != 0 && size > max_bytes_))
+    {
+      return false;
+    }
+    switch (policy_)
+    {
+      case OverflowPolicy::kDropNewest:
+        return false;
+      case OverflowPolicy::kDropOldest:
+        return DropOldest(shard, ptr, size);
+      case OverflowPolicy::kDropLowestPriority:
+        return DropLowestPriority(shard, ptr, size);
+      case OverflowPolicy::kBlock:
+        return Block(shard, ptr, size, notify_consumer);
+    }
+    return false;
+  }
+
+  bool DropOldest(SequencedCircularBuffer<T> &shard, std::unique_ptr<T> &ptr, size_t size) noexcept
+  {
+    std::lock_guard<std::mutex> guard{consumer_mutex_};
+    while (!TryAdd(shard, ptr, size))
+    {
+      // Only the elements of this shard can be dropped, which may not free
+      // enough of the memory budget.
+      auto consumed = shard.Consume(1, [&](CircularBufferRange<AtomicUniquePtr<T>> range) noexcept {
+        ReleaseBytes(range);
+        range.ForEach([](AtomicUniquePtr<T> &element) noexcept {
+          element.Reset();
+          return true;
+        });
+      });
+      if (consumed == 0)
+      {
+        return false;
+      }
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      evicted_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  bool DropLowestPriority(SequencedCircularBuffer<T> &shard,
+                          std::unique_ptr<T> &ptr,
+                          size_t size) noexcept
+  {
+    const int priority = priority_(*ptr);
+    std::lock_guard<std::mutex> guard{consumer_mutex_};
+    if (TryAdd(shard, ptr, size))
+    {
+      return true;
+    }
+    AtomicUniquePtr<T> *lowest = nullptr;
+    int lowest_priority        = priority;
+    shard.Peek().ForEach([&](AtomicUniquePtr<T> &element) noexcept {
+      int element_priority = priority_(*element);
+      if (element_priority < lowest_priority)
+      {
+        lowest          = &element;
+        lowest_priority = element_priority;
+      }
+      return true;
+    });
+    if (lowest == nullptr)
+    {
+      return false;
+    }
+    if (max_bytes_ != 0)
+    {
+      // The new element replaces the dropped one, if it fits in its place.
+      const size_t lowest_size = size_(**lowest);
+      if (size > lowest_size && !TryReserveBytes(size - lowest_size))
+      {
+        return false;
+      }
+      ReleaseBytes(size > lowest_size ? 0 : lowest_size - size);
+    }
+    lowest->Swap(ptr);
+    ptr.reset();
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    evicted_count_.fetch_add(1, std::memory_order_relaxed);
+    replaced_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  template <class Notify>
+  bool Block(SequencedCircularBuffer<T> &shard,
+             std::unique_ptr<T> &ptr,
+             size_t size,
+             Notify &notify_consumer) noexcept
+  {
+    auto deadline = std::chrono::steady_clock::now() + max_block_time_;
+    std::unique_lock<std::mutex> lock{space_mutex_};
+    while (!TryAdd(shard, ptr, size))
+    {
+      notify_consumer();
+      if (space_cv_.wait_until(lock, deadline) == std::cv_status::timeout)
+      {
+        return TryAdd(shard, ptr, size);
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * Cuts consumed elements into consecutive export batches of at most max_items
+ * elements and at most max_bytes estimated bytes, where 0 means no limit. An
+ * element larger than max_bytes is exported alone.
+ * @param elements the elements to export
+ * @param size the estimated size of an element in bytes
+ * @param callback the callback to invoke with every batch, which is invoked
+ * once with an empty batch if there are no elements
+ */
+template <class T, class Size, class Callback>
+void ForEachExportBatch(nostd::span<std::unique_ptr<T>> elements,
+                        size_t max_items,
+                        size_t max_bytes,
+                        Size size,
+                        Callback callback)
+{
+  if (max_items == 0)
+  {
+    max_items = elements.size();
+  }
+  size_t begin = 0;
+  do
+  {
+    size_t end   = begin;
+    size_t bytes = 0;
+    while (end < elements.size() && end - begin < max_items)
+    {
+      if (max_bytes != 0)
+      {
+        bytes += size(*elements[end]);
+        if (bytes > max_bytes && end > begin)
+        {
+          break;
+        }
+      }
+      ++end;
+    }
+    callback(nostd::span<std::unique_ptr<T>>(elements.data() + begin, end - begin));
+    begin = end;
+  } while (begin < elements.size());
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "opentelemetry/sdk/common/exporter_utils.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Struct to hold circuit breaker options.
+ */
+struct CircuitBreakerOptions
+{
+  /* The number of consecutive retryable export failures which open the circuit. */
+  size_t failure_threshold = 5;
+
+  /* How long the circuit stays open before a probe export is let through. */
+  std::chrono::milliseconds open_duration = std::chrono::milliseconds(5000);
+
+  /**
+   * Whether batches rejected while the circuit is open fail with
+   * ExportResult::kFailureRetryable, leaving the recordables to the retry
+   * buffer of the processor. Otherwise they are dropped with
+   * ExportResult::kFailure.
+   */
+  bool retry_rejected = true;
+};
+
+/**
+ * The state of a circuit breaker.
+ */
+enum class CircuitState
+{
+  // Exports pass through.
+  kClosed,
+
+  // Exports are rejected until the open duration expires.
+  kOpen,
+
+  // A single probe export passes through, which closes the circuit on success
+  // and opens it again on failure.
+  kHalfOpen
+};
+
+/**
+ * The state machine of an exporter circuit breaker. The circuit opens after
+ * consecutive failed exports, so that batches are rejected without being
+ * serialized while the backend is down, and closes again once a probe export
+ * succeeds.
+ */
+class CircuitBreaker
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit CircuitBreaker(const CircuitBreakerOptions &options) : options_{options} {}
+
+  /**
+   * @return true if an export may be passed to the exporter. In the open state,
+   * the first call after the open duration is let through as a probe.
+   */
+  bool AllowExport() noexcept
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    switch (state_)
+    {
+      case CircuitState::kClosed:
+        return true;
+      case CircuitState::kOpen:
+        if (Clock::now() >= open_until_)
+        {
+          state_ = CircuitState::kHalfOpen;
+          return true;
+        }
+        break;
+      case CircuitState::kHalfOpen:
+        break;
+    }
+    rejected_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * Records the result of an export let through by AllowExport(). Only
+   * ExportResult::kFailureRetryable counts as a failure; other failures are
+   * permanent for the batch, such as a batch rejected by the backend, and show
+   * that the backend was reached.
+   */
+  void RecordResult(ExportResult result) noexcept
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (result != ExportResult::kFailureRetryable)
+    {
+      state_                = CircuitState::kClosed;
+      consecutive_failures_ = 0;
+      return;
+    }
+    ++consecutive_failures_;
+    if (state_ == CircuitState::kHalfOpen || consecutive_failures_ >= options_.failure_threshold)
+    {
+      state_      = CircuitState::kOpen;
+      open_until_ = Clock::now() + options_.open_duration;
+    }
+  }
+
+  /**
+   * @return the current state of the circuit.
+   */
+  CircuitState state() const noexcept
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return state_;
+  }
+
+  /**
+   * @return the number of exports rejected while the circuit was open.
+   */
+  uint64_t rejected_count() const noexcept
+  {
+    return rejected_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return the options of the circuit breaker.
+   */
+  const CircuitBreakerOptions &options() const noexcept { return options_; }
+
+private:
+  const CircuitBreakerOptions options_;
+
+  mutable std::mutex mutex_;
+  CircuitState state_          = CircuitState::kClosed;
+  size_t consecutive_failures_ = 0;
+  Clock::time_point open_until_;
+  std::atomic<uint64_t> rejected_count_{0};
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
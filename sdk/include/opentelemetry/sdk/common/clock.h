@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "opentelemetry/core/timestamp.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A wall clock and a monotonic clock reading taken together.
+ */
+struct ClockTimestamps
+{
+  core::SystemTimestamp system_time;
+  core::SteadyTimestamp steady_time;
+};
+
+/**
+ * Clock is the source of the timestamps the SDK records for spans, log records
+ * and metrics. It is called on the hot path of every span, so implementations
+ * must be thread-safe and cheap.
+ */
+class Clock
+{
+public:
+  virtual ~Clock() = default;
+
+  /**
+   * @return the current wall clock time
+   */
+  virtual core::SystemTimestamp SystemNow() noexcept = 0;
+
+  /**
+   * @return the current monotonic time, used to measure durations
+   */
+  virtual core::SteadyTimestamp SteadyNow() noexcept = 0;
+
+  /**
+   * Read both clocks at once. Implementations deriving one from the other
+   * override this to read the underlying clock only once.
+   * @return the current wall clock and monotonic time
+   */
+  virtual ClockTimestamps Now() noexcept { return {SystemNow(), SteadyNow()}; }
+};
+
+/**
+ * The default clock, reading std::chrono::system_clock and
+ * std::chrono::steady_clock.
+ */
+class SystemClock final : public Clock
+{
+public:
+  core::SystemTimestamp SystemNow() noexcept override;
+
+  core::SteadyTimestamp SteadyNow() noexcept override;
+
+  /**
+   * @return a shared instance of the system clock
+   */
+  static std::shared_ptr<Clock> GetInstance() noexcept;
+};
+
+/**
+ * A clock reading CLOCK_REALTIME_COARSE and CLOCK_MONOTONIC_COARSE, which are
+ * served from the vDSO without querying the clocksource. The resolution is the
+ * kernel tick (typically 1 to 4 ms), so durations of short spans are rounded
+ * accordingly. Falls back to SystemClock on platforms without coarse clocks.
+ */
+class CoarseClock final : public Clock
+{
+public:
+  core::SystemTimestamp SystemNow() noexcept override;
+
+  core::SteadyTimestamp SteadyNow() noexcept override;
+};
+
+/**
+ * A clock deriving both times from the CPU timestamp counter, which is read
+ * without a system call. The counter frequency is calibrated against
+ * std::chrono::steady_clock on construction, and the counter is anchored to
+ * one reading of the system and steady clocks.
+ *
+ * This requires an invariant TSC that is synchronized between cores, which is
+ * the case on current x86-64 CPUs. As the calibrated frequency is not exact,
+ * the times drift from the system clock over time; long running processes
+ * should call Calibrate() periodically. Falls back to the steady clock on
+ * other architectures and on CPUs without an invariant TSC.
+ */
+class TscClock final : public Clock
+{
+public:
+  /**
+   * @param calibration_duration how long to measure the counter frequency for.
+   * Longer durations give a more accurate frequency, but block the constructor.
+   */
+  explicit TscClock(
+      std::chrono::microseconds calibration_duration = std::chrono::milliseconds{10}) noexcept;
+
+  core::SystemTimestamp SystemNow() noexcept override;
+
+  core::SteadyTimestamp SteadyNow() noexcept override;
+
+  ClockTimestamps Now() noexcept override;
+
+  /**
+   * Measure the counter frequency and re-anchor the clock. This may be called
+   * while other threads read the clock, which see either the old or the new
+   * calibration.
+   * @param calibration_duration how long to measure the counter frequency for.
+   */
+  void Calibrate(std::chrono::microseconds calibration_duration) noexcept;
+
+  /**
+   * @return true if the CPU has a timestamp counter running at a constant rate
+   * in all power states, which the clock is then derived from.
+   */
+  static bool HasInvariantTsc() noexcept;
+
+private:
+  struct Calibration
+  {
+    uint64_t anchor_ticks;
+    double nanos_per_tick;
+    int64_t anchor_system_nanos;
+    int64_t anchor_steady_nanos;
+  };
+
+  Calibration LoadCalibration() const noexcept;
+
+  uint64_t ReadTicks() const noexcept;
+
+  ClockTimestamps ToTimestamps(const Calibration &calibration, uint64_t ticks) const noexcept;
+
+  const bool use_tsc_;
+
+  // The calibration is published with a sequence lock: the sequence is odd
+  // while Calibrate updates the fields, which are atomic so that readers can
+  // load them concurrently and retry if the sequence changed meanwhile.
+  std::mutex calibrate_mutex_;
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<uint64_t> anchor_ticks_{0};
+  std::atomic<double> nanos_per_tick_{1.0};
+  std::atomic<int64_t> anchor_system_nanos_{0};
+  std::atomic<int64_t> anchor_steady_nanos_{0};
+};
+
+/**
+ * A clock deriving the wall clock time from a per-thread anchor plus the
+ * monotonic time elapsed since, so that taking both timestamps reads only the
+ * steady clock. Each thread reads the system clock again once its anchor is
+ * older than the resync interval, which bounds the drift from adjustments to
+ * the system clock.
+ */
+class AnchoredClock final : public Clock
+{
+public:
+  /**
+   * @param resync_interval how long a thread reuses its wall clock anchor.
+   */
+  explicit AnchoredClock(
+      std::chrono::nanoseconds resync_interval = std::chrono::seconds{1}) noexcept;
+
+  core::SystemTimestamp SystemNow() noexcept override;
+
+  core::SteadyTimestamp SteadyNow() noexcept override;
+
+  ClockTimestamps Now() noexcept override;
+
+private:
+  const std::chrono::nanoseconds resync_interval_;
+  // Identifies the anchors taken by this clock.
+  const uint64_t id_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A point in time by which an operation with a timeout must complete, on the
+ * steady clock. A timeout beyond the latest time the steady clock can
+ * represent, such as std::chrono::microseconds::max(), never expires.
+ */
+class Deadline
+{
+public:
+  explicit Deadline(std::chrono::microseconds timeout) noexcept
+      : Deadline(timeout, std::chrono::steady_clock::now())
+  {}
+
+  /**
+   * @return true if the deadline is in the past
+   */
+  bool IsExpired() const noexcept
+  {
+    return !is_never_ && std::chrono::steady_clock::now() >= time_;
+  }
+
+  /**
+   * @return the time left until the deadline, which is zero if the deadline
+   * expired and std::chrono::microseconds::max() if it never expires
+   */
+  std::chrono::microseconds GetRemaining() const noexcept
+  {
+    if (is_never_)
+    {
+      return (std::chrono::microseconds::max)();
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now >= time_)
+    {
+      return std::chrono::microseconds::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_ - now);
+  }
+
+  /**
+   * Waits on a condition variable until a predicate holds or the deadline
+   * expires.
+   * @return the value of the predicate
+   */
+  template <class Predicate>
+  bool Wait(std::condition_variable &cv,
+            std::unique_lock<std::mutex> &lock,
+            Predicate predicate) const
+  {
+    if (is_never_)
+    {
+      cv.wait(lock, predicate);
+      return true;
+    }
+    return cv.wait_until(lock, time_, predicate);
+  }
+
+private:
+  Deadline(std::chrono::microseconds timeout, std::chrono::steady_clock::time_point now) noexcept
+      : is_never_{timeout >= std::chrono::duration_cast<std::chrono::microseconds>(
+                                 (std::chrono::steady_clock::time_point::max)() - now)},
+        time_{is_never_ ? std::chrono::steady_clock::time_point{}
+                        : now + (std::max)(timeout, std::chrono::microseconds::zero())}
+  {}
+
+  bool is_never_;
+  std::chrono::steady_clock::time_point time_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/deadline.h"
+#include "opentelemetry/sdk/common/executor.h"
+#include "opentelemetry/sdk/common/exporter_utils.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Struct to hold disk spool options.
+ */
+struct DiskSpoolOptions
+{
+  /* The existing directory the segment files are written to. */
+  std::string directory = ".";
+
+  /* The prefix of the file names, which must be unique per spool in the directory. */
+  std::string name = "otel-spool";
+
+  /* The size in bytes after which a new segment file is started. */
+  size_t max_segment_size = 4 * 1024 * 1024;
+
+  /**
+   * The maximum size in bytes of all segment files. When it is reached, the
+   * oldest segments are deleted to make room.
+   */
+  size_t max_total_size = 64 * 1024 * 1024;
+
+  /**
+   * How long a spooling exporter sends no batches after a retryable export
+   * failure. Batches exported meanwhile go to the spool directly.
+   */
+  std::chrono::milliseconds replay_interval = std::chrono::milliseconds(5000);
+
+  /**
+   * The maximum number of spooled batches a spooling exporter replays at a
+   * time, so that the exports waiting for the spool are not blocked for the
+   * whole backlog.
+   */
+  size_t max_replay_batches = 8;
+
+  /**
+   * The executor the spooled batches are replayed on, which may be shared with
+   * other components. If empty, an executor of its own is created for the
+   * spool.
+   */
+  std::shared_ptr<Executor> executor;
+};
+
+/**
+ * A first-in first-out queue of records on local disk, which survives a
+ * restart of the process.
+ *
+ * Records are appended to segment files of a bounded size, each framed with
+ * its length and a CRC-32, so that a record torn by a crash or corrupted on
+ * disk is detected and skipped together with the rest of its segment. A small
+ * head file holds the sequence number of the oldest segment. Records are
+ * replayed at least once: after a crash, the records of the oldest segment
+ * read before the crash are read again.
+ *
+ * This class is not thread-safe.
+ */
+class DiskSpool
+{
+public:
+  /**
+   * Opens the spool, and recovers the segments left by a previous process.
+   * New records are appended to a new segment.
+   */
+  explicit DiskSpool(const DiskSpoolOptions &options);
+
+  ~DiskSpool();
+
+  DiskSpool(const DiskSpool &)            = delete;
+  DiskSpool &operator=(const DiskSpool &) = delete;
+
+  /**
+   * Appends a record, deleting the oldest segments if the spool is full.
+   * @return true if the record was written; false, if it is larger than the
+   * spool or writing failed.
+   */
+  bool Append(nostd::string_view data) noexcept;
+
+  /**
+   * Reads the oldest record without removing it. Corrupted records are
+   * skipped.
+   * @return true if a record was read; false, if the spool is empty.
+   */
+  bool Peek(std::string *data) noexcept;
+
+  /**
+   * Removes the record returned by the last call to Peek().
+   */
+  void Pop() noexcept;
+
+  /**
+   * @return true if the spool holds no segments.
+   */
+  bool empty() const noexcept { return segments_.empty(); }
+
+  /**
+   * @return the size in bytes of all segment files.
+   */
+  size_t size() const noexcept { return total_size_; }
+
+  /**
+   * @return the number of segments deleted because the spool was full, or
+   * because they were corrupted.
+   */
+  uint64_t evicted_count() const noexcept { return evicted_count_; }
+
+private:
+  struct Segment
+  {
+    uint64_t sequence;
+    size_t size;
+  };
+
+  const DiskSpoolOptions options_;
+
+  // The segments from the oldest, the last of which is written if writer_ is set.
+  std::deque<Segment> segments_;
+  size_t total_size_      = 0;
+  uint64_t next_sequence_ = 0;
+  std::FILE *writer_      = nullptr;
+
+  // The oldest segment is read from read_offset_, and peek_size_ is the size of
+  // the record returned by Peek().
+  std::FILE *reader_  = nullptr;
+  size_t read_offset_ = 0;
+  size_t peek_size_   = 0;
+
+  uint64_t evicted_count_ = 0;
+
+  std::string GetSegmentPath(uint64_t sequence) const;
+  std::string GetHeadPath() const;
+  void WriteHead(uint64_t sequence) noexcept;
+  void RemoveFront() noexcept;
+  bool StartSegment() noexcept;
+};
+
+/**
+ * Exports encoded batches through a DiskSpool: while the backend fails with
+ * ExportResult::kFailureRetryable, batches are spooled, and a task on the
+ * executor replays them in order once the backend recovers. New batches are
+ * spooled behind the backlog until it is replayed. This class is thread-safe.
+ */
+class Spooler
+{
+public:
+  using ExportEncoded = std::function<ExportResult(nostd::string_view)>;
+
+  /**
+   * Opens the spool, and starts replaying the batches left by a previous
+   * process.
+   * @param options the disk spool options
+   * @param export_encoded the function sending an encoded batch to the backend
+   */
+  Spooler(const DiskSpoolOptions &options, ExportEncoded export_encoded);
+
+  /**
+   * Exports an encoded batch, or spools it if the backend is down.
+   * @param data the encoded batch
+   * @return ExportResult::kSuccess if the batch was exported or spooled, or the
+   * result of a failed export which is not retryable.
+   */
+  ExportResult Export(std::string &&data) noexcept;
+
+  /**
+   * Stops replaying on the executor, and replays the backlog until the
+   * deadline expires or the backend fails. The batches left stay in the spool
+   * for the next process.
+   */
+  void Shutdown(const Deadline &deadline) noexcept;
+
+  /**
+   * @return the number of segments deleted because the spool was full, or
+   * because they were corrupted.
+   */
+  uint64_t evicted_count() const noexcept;
+
+private:
+  const std::chrono::milliseconds replay_interval_;
+  const size_t max_replay_batches_;
+  const ExportEncoded export_encoded_;
+
+  mutable std::mutex mutex_;
+  DiskSpool spool_;
+  // No batches are sent before this time.
+  Executor::Clock::time_point retry_time_;
+
+  // Destroyed first, so that a replay in progress is waited for.
+  std::unique_ptr<ScheduledTask> replay_task_;
+
+  /**
+   * The routine performed by the replay task.
+   * @return the delay until the next replay
+   */
+  Executor::Clock::duration Replay() noexcept;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Epoch-based reclamation for values that are read very frequently and
+ * replaced rarely, such as the span processor of a tracer.
+ *
+ * Readers enter a critical section by creating an EpochGuard, which increments
+ * a counter of the current epoch in a shard of the calling thread, so readers
+ * on different threads do not share a cache line. Values which may still be
+ * read are retired instead of released, and are released after a grace
+ * period, once all guards created before they were retired are gone.
+ *
+ * Guards should be short-lived, since a guard held for a long time delays the
+ * release of all values retired meanwhile.
+ */
+class EpochGuard
+{
+public:
+  /**
+   * Enters a critical section, in which retired values are not released.
+   */
+  EpochGuard() noexcept;
+
+  EpochGuard(EpochGuard &&other) noexcept : counter_(other.counter_) { other.counter_ = nullptr; }
+
+  EpochGuard &operator=(EpochGuard &&other) noexcept
+  {
+    if (this != &other)
+    {
+      Release();
+      counter_       = other.counter_;
+      other.counter_ = nullptr;
+    }
+    return *this;
+  }
+
+  EpochGuard(const EpochGuard &) = delete;
+  EpochGuard &operator=(const EpochGuard &) = delete;
+
+  ~EpochGuard() { Release(); }
+
+  /**
+   * Leaves the critical section, if not left already.
+   */
+  void Release() noexcept;
+
+private:
+  // The counter of the epoch and shard the guard entered, or nullptr.
+  std::atomic<int64_t> *counter_;
+};
+
+/**
+ * Releases a value once all EpochGuards which exist now are gone. The value
+ * is released on the calling thread if no guard exists, or otherwise by a
+ * later call, or on a thread releasing a guard, at most every 10 milliseconds.
+ */
+void RetireAfterGracePeriod(std::shared_ptr<const void> value) noexcept;
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
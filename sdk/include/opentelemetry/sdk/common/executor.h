@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "opentelemetry/sdk/common/deadline.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A small thread pool with a timer queue, which runs the background work of
+ * telemetry components such as batch processors, push controllers and zPages
+ * aggregation. Components sharing an executor share its threads, so that the
+ * number of threads and wakeups does not grow with the number of pipelines.
+ *
+ * Tasks are run in the order of their scheduled time, on any thread of the
+ * pool. A task blocks its thread while it runs, so blocking exports delay the
+ * other tasks scheduled on the same executor.
+ */
+class Executor
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @param num_threads the number of threads of the pool, at least one
+   */
+  explicit Executor(size_t num_threads = 1)
+  {
+    num_threads = (std::max)(num_threads, size_t{1});
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+      threads_.emplace_back(&Executor::Run, this);
+    }
+  }
+
+  /**
+   * Stops the threads after the tasks running. Tasks not run yet are discarded.
+   */
+  ~Executor()
+  {
+    {
+      std::lock_guard<std::mutex> guard{mutex_};
+      is_stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto &thread : threads_)
+    {
+      thread.join();
+    }
+  }
+
+  Executor(const Executor &)            = delete;
+  Executor &operator=(const Executor &) = delete;
+
+  /**
+   * Schedules a task to run once at the given time, or as soon as possible if
+   * the time is in the past.
+   */
+  void Schedule(Clock::time_point time, std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> guard{mutex_};
+      tasks_.push_back(TimedTask{time, next_sequence_++, std::move(task)});
+      std::push_heap(tasks_.begin(), tasks_.end(), IsLater);
+    }
+    // Waiting threads may sleep until a later task.
+    cv_.notify_one();
+  }
+
+  /**
+   * @return the number of threads of the pool.
+   */
+  size_t num_threads() const noexcept { return threads_.size(); }
+
+private:
+  struct TimedTask
+  {
+    Clock::time_point time;
+    // Orders the tasks scheduled for the same time
+    uint64_t sequence;
+    std::function<void()> task;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // A min-heap of the tasks by time
+  std::vector<TimedTask> tasks_;
+  uint64_t next_sequence_ = 0;
+  bool is_stopped_        = false;
+  std::vector<std::thread> threads_;
+
+  static bool IsLater(const TimedTask &a, const TimedTask &b) noexcept
+  {
+    return a.time != b.time ? a.time > b.time : a.sequence > b.sequence;
+  }
+
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (!is_stopped_)
+    {
+      if (tasks_.empty())
+      {
+        cv_.wait(lock);
+        continue;
+      }
+      auto time = tasks_.front().time;
+      if (Clock::now() < time)
+      {
+        cv_.wait_until(lock, time);
+        continue;
+      }
+      std::pop_heap(tasks_.begin(), tasks_.end(), IsLater);
+      auto task = std::move(tasks_.back().task);
+      tasks_.pop_back();
+
+      // Another thread takes over waiting for the next task.
+      if (!tasks_.empty())
+      {
+        cv_.notify_one();
+      }
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+};
+
+/**
+ * A task run repeatedly on an Executor, never concurrently with itself, in
+ * place of a dedicated thread looping over a timed wait. The callback returns
+ * the delay until its next run, and Wake() brings the next run forward.
+ */
+class ScheduledTask
+{
+public:
+  /**
+   * The callback run by the task. It returns the delay until the next run, or
+   * Executor::Clock::duration::max() to only run again when woken up.
+   */
+  using Callback = std::function<Executor::Clock::duration()>;
+
+  /**
+   * @param executor the executor to run on
+   * @param callback the callback to run
+   * @param delay the delay until the first run
+   */
+  ScheduledTask(std::shared_ptr<Executor> executor,
+                Callback callback,
+                Executor::Clock::duration delay)
+      : executor_{std::move(executor)}, state_{new State{executor_.get(), std::move(callback)}}
+  {
+    std::lock_guard<std::mutex> guard{state_->mutex};
+    ScheduleLocked(state_, Executor::Clock::now() + delay);
+  }
+
+  /**
+   * Stops the task, see Stop().
+   */
+  ~ScheduledTask() { Stop(); }
+
+  ScheduledTask(const ScheduledTask &)            = delete;
+  ScheduledTask &operator=(const ScheduledTask &) = delete;
+
+  /**
+   * Runs the callback as soon as possible. If the callback is running, it
+   * runs again right after it returns.
+   */
+  void Wake() noexcept
+  {
+    std::lock_guard<std::mutex> guard{state_->mutex};
+    if (state_->is_stopped)
+    {
+      return;
+    }
+    if (state_->is_running)
+    {
+      state_->is_woken = true;
+      return;
+    }
+    auto now = Executor::Clock::now();
+    if (state_->time > now)
+    {
+      ScheduleLocked(state_, now);
+    }
+  }
+
+  /**
+   * Stops running the callback, waiting for a run in progress to return.
+   *
+   * Note: This method must not be called from the callback.
+   */
+  void Stop() noexcept
+  {
+    std::unique_lock<std::mutex> lock{state_->mutex};
+    state_->is_stopped = true;
+    state_->cv.wait(lock, [this] { return !state_->is_running; });
+  }
+
+  /**
+   * Stops running the callback, waiting for a run in progress to return until
+   * the deadline expires.
+   * @return true if no run is in progress
+   *
+   * Note: This method must not be called from the callback.
+   */
+  bool Stop(const Deadline &deadline) noexcept
+  {
+    std::unique_lock<std::mutex> lock{state_->mutex};
+    state_->is_stopped = true;
+    return deadline.Wait(state_->cv, lock, [this] { return !state_->is_running; });
+  }
+
+private:
+  /**
+   * The state shared with the runs scheduled on the executor, which may
+   * outlive the task.
+   */
+  struct State
+  {
+    State(Executor *executor, Callback callback) : executor{executor}, callback{std::move(callback)}
+    {}
+
+    // Only used while the task is not stopped, so the executor is alive.
+    Executor *executor;
+    Callback callback;
+    std::mutex mutex;
+    std::condition_variable cv;
+    // The time of the next run, and its generation. Runs of earlier
+    // generations were superseded by Wake() and are skipped.
+    Executor::Clock::time_point time = (Executor::Clock::time_point::max)();
+    uint64_t generation              = 0;
+    bool is_running                  = false;
+    bool is_woken                    = false;
+    bool is_stopped                  = false;
+  };
+
+  std::shared_ptr<Executor> executor_;
+  std::shared_ptr<State> state_;
+
+  static void ScheduleLocked(const std::shared_ptr<State> &state, Executor::Clock::time_point time)
+  {
+    const uint64_t generation = ++state->generation;
+    state->time               = time;
+    state->executor->Schedule(time, [state, generation] { Run(state, generation); });
+  }
+
+  static void Run(const std::shared_ptr<State> &state, uint64_t generation)
+  {
+    {
+      std::lock_guard<std::mutex> guard{state->mutex};
+      if (state->is_stopped || generation != state->generation)
+      {
+        return;
+      }
+      state->is_running = true;
+      state->is_woken   = false;
+      state->time       = (Executor::Clock::time_point::max)();
+    }
+
+    auto delay = state->callback();
+
+    std::lock_guard<std::mutex> guard{state->mutex};
+    state->is_running = false;
+    if (!state->is_stopped)
+    {
+      auto now = Executor::Clock::now();
+      if (state->is_woken)
+      {
+        ScheduleLocked(state, now);
+      }
+      else if (delay < Executor::Clock::time_point::max() - now)
+      {
+        ScheduleLocked(state, now + delay);
+      }
+    }
+    state->cv.notify_all();
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -39,7 +39,12 @@ enum class ExportResult
   kFailureFull = 2,
 
   // The export() function was passed an invalid argument.
-  kFailureInvalidArgument = 3
+  kFailureInvalidArgument = 3,
+
+  // Batch exporting failed with a transient error, such as an unavailable
+  // backend. The exporter left the recordables in the batch, so that the
+  // caller may export them again later.
+  kFailureRetryable = 4
 };
 
 }  // namespace common
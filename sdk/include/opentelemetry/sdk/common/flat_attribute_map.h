@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "opentelemetry/common/key_value_iterable.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * An attribute, as stored by FlatAttributeMap.
+ */
+using AttributeEntry = std::pair<std::string, OwnedAttributeValue>;
+
+/**
+ * A read-only, non-owning view of the attributes stored in a FlatAttributeMap.
+ *
+ * Attributes are stored contiguously in insertion order, so exporters can
+ * iterate them without any hashing. Lookups by key are linear.
+ */
+class AttributeView
+{
+public:
+  using value_type     = AttributeEntry;
+  using const_iterator = const AttributeEntry *;
+
+  AttributeView() noexcept = default;
+
+  AttributeView(const AttributeEntry *data, size_t size) noexcept : data_{data}, size_{size} {}
+
+  const_iterator begin() const noexcept { return data_; }
+
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  size_t size() const noexcept { return size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @return an iterator to the attribute with the given key, or end() if there is none.
+   */
+  const_iterator find(nostd::string_view key) const noexcept
+  {
+    for (auto it = begin(); it != end(); ++it)
+    {
+      if (it->first.size() == key.size() &&
+          std::memcmp(it->first.data(), key.data(), key.size()) == 0)
+      {
+        return it;
+      }
+    }
+    return end();
+  }
+
+  size_t count(nostd::string_view key) const noexcept { return find(key) == end() ? 0 : 1; }
+
+  /**
+   * @return the approximate size of the attributes once encoded for export.
+   */
+  size_t GetEstimatedSize() const noexcept
+  {
+    size_t size = 0;
+    for (auto &attribute : *this)
+    {
+      size += attribute.first.size() + AttributeSizeEstimator::kValueOverhead +
+              nostd::visit(AttributeSizeEstimator{}, attribute.second);
+    }
+    return size;
+  }
+
+  /**
+   * @return the value of the attribute with the given key.
+   * @throws std::out_of_range if there is no such attribute.
+   */
+  const OwnedAttributeValue &at(nostd::string_view key) const
+  {
+    auto it = find(key);
+    if (it == end())
+    {
+      throw std::out_of_range("attribute not found");
+    }
+    return it->second;
+  }
+
+private:
+  const AttributeEntry *data_ = nullptr;
+  size_t size_                = 0;
+};
+
+/**
+ * Presents the owned attributes of an AttributeView as a KeyValueIterable, so
+ * that recorded attributes can be passed on to another recordable.
+ *
+ * The values passed to the callback refer to the attributes of the view,
+ * except for boolean and string arrays, which are converted into temporary
+ * arrays valid for the duration of the callback only.
+ */
+class AttributeViewIterable final : public opentelemetry::common::KeyValueIterable
+{
+public:
+  explicit AttributeViewIterable(AttributeView attributes) noexcept : attributes_{attributes} {}
+
+  bool ForEachKeyValue(
+      nostd::function_ref<bool(nostd::string_view, opentelemetry::common::AttributeValue)> callback)
+      const noexcept override
+  {
+    for (const auto &attribute : attributes_)
+    {
+      if (!nostd::visit(Visitor{attribute.first, callback}, attribute.second))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t size() const noexcept override { return attributes_.size(); }
+
+private:
+  struct Visitor
+  {
+    nostd::string_view key;
+    nostd::function_ref<bool(nostd::string_view, opentelemetry::common::AttributeValue)> callback;
+
+    template <class T>
+    bool operator()(const T &value)
+    {
+      return callback(key, value);
+    }
+
+    bool operator()(const std::string &value) { return callback(key, nostd::string_view{value}); }
+
+    template <class T>
+    bool operator()(const std::vector<T> &values)
+    {
+      return callback(key, nostd::span<const T>{values.data(), values.size()});
+    }
+
+    bool operator()(const std::vector<bool> &values)
+    {
+      std::unique_ptr<bool[]> copy{new bool[values.size()]};
+      std::copy(values.begin(), values.end(), copy.get());
+      return callback(key, nostd::span<const bool>{copy.get(), values.size()});
+    }
+
+    bool operator()(const std::vector<std::string> &values)
+    {
+      std::vector<nostd::string_view> views(values.begin(), values.end());
+      return callback(key, nostd::span<const nostd::string_view>{views.data(), views.size()});
+    }
+  };
+
+  AttributeView attributes_;
+};
+
+/**
+ * A flat map for storing attributes, with last-write-wins semantics.
+ *
+ * The first N attributes are stored inline, without any heap allocation. Once
+ * more attributes are added, all of them are moved to a heap allocated array
+ * which grows geometrically. Clear() keeps that array for reuse.
+ *
+ * Most spans and log records carry a handful of attributes, for which a linear
+ * scan is cheaper than hashing, and building the map costs no allocation per
+ * attribute beyond the owned copies of the values.
+ */
+template <size_t N>
+class FlatAttributeMap
+{
+  static_assert(N > 0, "FlatAttributeMap requires an inline capacity of at least one");
+
+public:
+  using value_type     = AttributeEntry;
+  using const_iterator = const AttributeEntry *;
+
+  // Construct empty attribute map
+  FlatAttributeMap() noexcept {}
+
+  // Construct attribute map and populate with attributes
+  FlatAttributeMap(const opentelemetry::common::KeyValueIterable &attributes) : FlatAttributeMap()
+  {
+    attributes.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          SetAttribute(key, value);
+          return true;
+        });
+  }
+
+  FlatAttributeMap(const FlatAttributeMap &other) : FlatAttributeMap()
+  {
+    Reserve(other.size_);
+    for (const auto &entry : other)
+    {
+      new (data_ + size_) AttributeEntry(entry);
+      ++size_;
+    }
+  }
+
+  FlatAttributeMap(FlatAttributeMap &&other) noexcept : FlatAttributeMap() { Steal(other); }
+
+  FlatAttributeMap &operator=(const FlatAttributeMap &other)
+  {
+    if (this != &other)
+    {
+      Clear();
+      Reserve(other.size_);
+      for (const auto &entry : other)
+      {
+        new (data_ + size_) AttributeEntry(entry);
+        ++size_;
+      }
+    }
+    return *this;
+  }
+
+  FlatAttributeMap &operator=(FlatAttributeMap &&other) noexcept
+  {
+    if (this != &other)
+    {
+      Clear();
+      Deallocate();
+      Steal(other);
+    }
+    return *this;
+  }
+
+  ~FlatAttributeMap()
+  {
+    Clear();
+    Deallocate();
+  }
+
+  /**
+   * @return a view of the attributes, in insertion order.
+   */
+  AttributeView GetAttributes() const noexcept { return AttributeView(data_, size_); }
+
+  /**
+   * Set an attribute, replacing the value of an existing attribute with the same key.
+   */
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept
+  {
+    AttributeConverter converter;
+    auto it = GetAttributes().find(key);
+    if (it != end())
+    {
+      const_cast<AttributeEntry *>(it)->second = nostd::visit(converter, value);
+      return;
+    }
+    Reserve(size_ + 1);
+    new (data_ + size_) AttributeEntry(std::string(key.data(), key.size()),
+                                       nostd::visit(converter, value));
+    ++size_;
+  }
+
+  /**
+   * Remove all attributes. The storage is kept for reuse.
+   */
+  void Clear() noexcept
+  {
+    for (size_t i = 0; i < size_; ++i)
+    {
+      data_[i].~AttributeEntry();
+    }
+    size_ = 0;
+  }
+
+  const_iterator begin() const noexcept { return data_; }
+
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  size_t size() const noexcept { return size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator find(nostd::string_view key) const noexcept { return GetAttributes().find(key); }
+
+  size_t count(nostd::string_view key) const noexcept { return GetAttributes().count(key); }
+
+  const OwnedAttributeValue &at(nostd::string_view key) const { return GetAttributes().at(key); }
+
+private:
+  using Storage =
+      typename std::aligned_storage<sizeof(AttributeEntry), alignof(AttributeEntry)>::type;
+
+  Storage inline_storage_[N];
+  AttributeEntry *data_ = reinterpret_cast<AttributeEntry *>(inline_storage_);
+  size_t size_          = 0;
+  size_t capacity_      = N;
+
+  bool IsInline() const noexcept
+  {
+    return data_ == reinterpret_cast<const AttributeEntry *>(inline_storage_);
+  }
+
+  void Reserve(size_t capacity)
+  {
+    if (capacity <= capacity_)
+    {
+      return;
+    }
+    size_t new_capacity = capacity_ * 2 > capacity ? capacity_ * 2 : capacity;
+    auto new_data =
+        static_cast<AttributeEntry *>(::operator new(new_capacity * sizeof(AttributeEntry)));
+    for (size_t i = 0; i < size_; ++i)
+    {
+      new (new_data + i) AttributeEntry(std::move(data_[i]));
+      data_[i].~AttributeEntry();
+    }
+    Deallocate();
+    data_     = new_data;
+    capacity_ = new_capacity;
+  }
+
+  void Deallocate() noexcept
+  {
+    if (!IsInline())
+    {
+      ::operator delete(data_);
+      data_     = reinterpret_cast<AttributeEntry *>(inline_storage_);
+      capacity_ = N;
+    }
+  }
+
+  // Take over the attributes of another map. This map must be empty and use inline storage.
+  void Steal(FlatAttributeMap &other) noexcept
+  {
+    if (other.IsInline())
+    {
+      for (size_t i = 0; i < other.size_; ++i)
+      {
+        new (data_ + i) AttributeEntry(std::move(other.data_[i]));
+      }
+      size_ = other.size_;
+      other.Clear();
+    }
+    else
+    {
+      data_           = other.data_;
+      size_           = other.size_;
+      capacity_       = other.capacity_;
+      other.data_     = reinterpret_cast<AttributeEntry *>(other.inline_storage_);
+      other.size_     = 0;
+      other.capacity_ = N;
+    }
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/sdk/common/exporter_utils.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * How a batch processor retries the batches whose export failed with
+ * ExportResult::kFailureRetryable.
+ */
+struct RetryOptions
+{
+  /* The maximum number of export attempts of a batch. One disables retries. */
+  size_t max_attempts = 5;
+
+  /* The backoff before the first retry. */
+  std::chrono::milliseconds initial_backoff = std::chrono::milliseconds(1000);
+
+  /* The maximum backoff between two retries. */
+  std::chrono::milliseconds max_backoff = std::chrono::milliseconds(5000);
+
+  /* The factor the backoff grows by after every retry. */
+  double backoff_multiplier = 1.5;
+
+  /* The maximum number of elements waiting for a retry. */
+  size_t max_buffer_size = 2048;
+
+  /**
+   * The maximum estimated size in bytes of the elements waiting for a retry.
+   * Zero means no limit.
+   */
+  size_t max_buffer_size_bytes = 4 * 1024 * 1024;
+};
+
+/**
+ * The batches of a batch processor waiting to be exported again after a
+ * transient failure. Every batch waits for an exponential backoff with
+ * jitter, and is dropped when it has no attempts left or when the buffer is
+ * full.
+ *
+ * Batches may be added from several threads, but only retried or taken from
+ * one.
+ */
+template <class T>
+class RetryBuffer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Size  = std::function<size_t(const T &)>;
+
+  /**
+   * @param options the retry options
+   * @param size the estimated size of an element in bytes
+   */
+  RetryBuffer(const RetryOptions &options, Size size)
+      : options_{options},
+        element_size_{std::move(size)},
+        random_{static_cast<std::minstd_rand::result_type>(
+            Clock::now().time_since_epoch().count())}
+  {}
+
+  /**
+   * Adds the elements of a batch whose export failed with
+   * ExportResult::kFailureRetryable. Elements taken by the exporter, which are
+   * null, are skipped.
+   * @param batch the batch, whose elements are moved into the buffer if added
+   * @param attempts the number of export attempts of the batch so far
+   * @return true if the batch was added; false, if it was dropped.
+   */
+  bool Add(nostd::span<std::unique_ptr<T>> batch, size_t attempts) noexcept
+  {
+    size_t num_elements = 0;
+    size_t num_bytes    = 0;
+    for (auto &element : batch)
+    {
+      if (element != nullptr)
+      {
+        ++num_elements;
+        num_bytes += element_size_(*element);
+      }
+    }
+    if (num_elements == 0)
+    {
+      return true;
+    }
+
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (attempts >= options_.max_attempts ||
+        num_elements_ + num_elements > options_.max_buffer_size ||
+        (options_.max_buffer_size_bytes != 0 &&
+         num_bytes_ + num_bytes > options_.max_buffer_size_bytes))
+    {
+      dropped_count_.fetch_add(num_elements, std::memory_order_relaxed);
+      return false;
+    }
+
+    Entry entry;
+    entry.batch.reserve(num_elements);
+    for (auto &element : batch)
+    {
+      if (element != nullptr)
+      {
+        entry.batch.push_back(std::move(element));
+      }
+    }
+    entry.attempts = attempts;
+    entry.bytes    = num_bytes;
+    entry.time     = Clock::now() + GetBackoff(attempts);
+    num_elements_ += num_elements;
+    num_bytes_ += num_bytes;
+    entries_.push_back(std::move(entry));
+    return true;
+  }
+
+  /**
+   * Exports the batches whose backoff expired by the given time again. The
+   * batches failing again with ExportResult::kFailureRetryable are added back.
+   * @param time the time, or Clock::time_point::max() to retry all batches
+   * @param export_batch the function exporting a
+   * nostd::span<std::unique_ptr<T>>, returning an ExportResult
+   *
+   * Note: This method must only be called from one thread at a time.
+   */
+  template <class Export>
+  void Retry(Clock::time_point time, Export export_batch)
+  {
+    TakeDue(time, [&](std::vector<std::unique_ptr<T>> &elements, size_t attempts) {
+      nostd::span<std::unique_ptr<T>> batch{elements.data(), elements.size()};
+      if (export_batch(batch) == ExportResult::kFailureRetryable)
+      {
+        Add(batch, attempts + 1);
+      }
+    });
+  }
+
+  /**
+   * Takes the batches whose backoff expired by the given time out of the
+   * buffer, for the caller to export them again, and to add them back with
+   * one more attempt if the export fails with ExportResult::kFailureRetryable.
+   * @param time the time, or Clock::time_point::max() to take all batches
+   * @param take the function taking a std::vector<std::unique_ptr<T>>&, whose
+   * elements it may move, and the number of export attempts of the batch
+   *
+   * Note: This method must only be called from one thread at a time.
+   */
+  template <class Take>
+  void TakeDue(Clock::time_point time, Take take)
+  {
+    std::vector<Entry> due;
+    {
+      std::lock_guard<std::mutex> guard{mutex_};
+      auto it = std::stable_partition(entries_.begin(), entries_.end(),
+                                      [time](const Entry &entry) { return entry.time > time; });
+      for (auto due_it = it; due_it != entries_.end(); ++due_it)
+      {
+        num_elements_ -= due_it->batch.size();
+        num_bytes_ -= due_it->bytes;
+        due.push_back(std::move(*due_it));
+      }
+      entries_.erase(it, entries_.end());
+    }
+
+    for (auto &entry : due)
+    {
+      take(entry.batch, entry.attempts);
+    }
+  }
+
+  /**
+   * @return the time of the next retry, or Clock::time_point::max() if there
+   * are no batches.
+   */
+  Clock::time_point next_retry_time() const noexcept
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    auto time = (Clock::time_point::max)();
+    for (auto &entry : entries_)
+    {
+      time = (std::min)(time, entry.time);
+    }
+    return time;
+  }
+
+  /**
+   * @return true if no batches wait for a retry.
+   */
+  bool empty() const noexcept
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return entries_.empty();
+  }
+
+  /**
+   * @return the number of elements dropped, because they had no attempts left
+   * or did not fit into the buffer.
+   */
+  uint64_t dropped_count() const noexcept
+  {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Entry
+  {
+    std::vector<std::unique_ptr<T>> batch;
+    size_t attempts = 0;
+    size_t bytes    = 0;
+    Clock::time_point time;
+  };
+
+  const RetryOptions options_;
+  Size element_size_;
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  size_t num_elements_ = 0;
+  size_t num_bytes_    = 0;
+  std::minstd_rand random_;
+  std::atomic<uint64_t> dropped_count_{0};
+
+  /**
+   * @return the backoff after the given number of attempts, drawn between half
+   * and all of the exponential backoff so that retries of different processors
+   * spread out.
+   */
+  Clock::duration GetBackoff(size_t attempts) noexcept
+  {
+    double backoff = static_cast<double>(options_.initial_backoff.count());
+    for (size_t i = 1; i < attempts; ++i)
+    {
+      backoff *= options_.backoff_multiplier;
+    }
+    backoff = (std::min)(backoff, static_cast<double>(options_.max_backoff.count()));
+    std::uniform_real_distribution<double> jitter{0.5, 1.0};
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(backoff * jitter(random_)));
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
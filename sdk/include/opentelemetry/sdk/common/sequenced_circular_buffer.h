@@ -0,0 +1,279 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/sdk/common/atomic_unique_ptr.h"
+#include "opentelemetry/sdk/common/circular_buffer_range.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/*
+ * A lock-free circular buffer that supports multiple concurrent producers
+ * and a single consumer, with the same interface as CircularBuffer.
+ *
+ * Every slot has a sequence number which tells whether the slot is free to be
+ * written at a position, or holds the element added at a position (as in
+ * Dmitry Vyukov's bounded MPMC queue). A slot free at position p has the
+ * sequence number 2p, and a slot holding the element added at position p has
+ * the sequence number 2p + 1, which also works for a single slot. Producers claim positions by advancing
+ * head_ and never read tail_, and the consumer never writes head_. The two
+ * counters are kept on separate cache lines.
+ */
+template <class T>
+class SequencedCircularBuffer
+{
+public:
+  explicit SequencedCircularBuffer(size_t max_size)
+      : data_{new AtomicUniquePtr<T>[max_size]},
+        sequences_{new std::atomic<uint64_t>[max_size]},
+        capacity_{max_size}
+  {
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+      sequences_[i].store(FreeSequence(i), std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @return a range of the elements in the circular buffer that can be
+   * consumed
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  CircularBufferRange<const AtomicUniquePtr<T>> Peek() const noexcept
+  {
+    return const_cast<SequencedCircularBuffer *>(this)->Peek();
+  }
+
+  /**
+   * @return a range of the elements in the circular buffer that can be
+   * consumed, which may be swapped with other elements
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  CircularBufferRange<AtomicUniquePtr<T>> Peek() noexcept
+  {
+    return PeekImpl(CountPublished(size()));
+  }
+
+  /**
+   * Consume elements from the circular buffer's tail.
+   * @param n the maximum number of elements to consume. Fewer elements are
+   * consumed if some of the first n elements are still being added by
+   * producers, in which case they are left for a later call.
+   * @param callback the callback to invoke with an AtomicUniquePtr to each
+   * consumed element.
+   * @return the number of elements consumed
+   *
+   * Note: The callback must set the passed AtomicUniquePtr to null.
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  template <class Callback>
+  size_t Consume(size_t n, Callback callback) noexcept
+  {
+    assert(n <= size());
+    n          = CountPublished(n);
+    auto range = PeekImpl(n);
+    static_assert(noexcept(callback(range)), "callback not allowed to throw");
+    callback(range);
+
+    // Hand the consumed slots back to producers for the next round.
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    for (uint64_t position = tail; position < tail + n; ++position)
+    {
+      sequences_[position % capacity_].store(FreeSequence(position + capacity_),
+                                             std::memory_order_release);
+    }
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * Consume elements from the circular buffer's tail.
+   * @param n the maximum number of elements to consume
+   * @return the number of elements consumed
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  size_t Consume(size_t n) noexcept
+  {
+    return Consume(n, [](CircularBufferRange<AtomicUniquePtr<T>> &range) noexcept {
+      range.ForEach([](AtomicUniquePtr<T> &ptr) noexcept {
+        ptr.Reset();
+        return true;
+      });
+    });
+  }
+
+  /**
+   * Adds an element into the circular buffer.
+   * @param ptr a pointer to the element to add
+   * @return true if the element was successfully added; false, otherwise.
+   */
+  bool Add(std::unique_ptr<T> &ptr) noexcept
+  {
+    return AddN(nostd::span<std::unique_ptr<T>>{&ptr, 1}) == 1;
+  }
+
+  /**
+   * Adds several elements into the circular buffer, claiming their positions
+   * at once. The added elements are consecutive in the buffer.
+   * @param ptrs the pointers to the elements to add
+   * @return the number of elements added, which were taken from the front of
+   * ptrs. The remaining elements did not fit into the buffer.
+   */
+  size_t AddN(nostd::span<std::unique_ptr<T>> ptrs) noexcept
+  {
+    if (capacity_ == 0 || ptrs.empty())
+    {
+      return 0;
+    }
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    size_t n;
+    while (true)
+    {
+      // Count the free slots from head, up to the number of elements to add.
+      for (n = 0; n < ptrs.size(); ++n)
+      {
+        uint64_t position = head + n;
+        uint64_t sequence = sequences_[position % capacity_].load(std::memory_order_acquire);
+        if (sequence != FreeSequence(position))
+        {
+          break;
+        }
+      }
+      if (n == 0)
+      {
+        uint64_t sequence = sequences_[head % capacity_].load(std::memory_order_acquire);
+        if (static_cast<int64_t>(sequence - FreeSequence(head)) < 0)
+        {
+          // The slot at head still holds the element of the previous round,
+          // so the circular buffer is full.
+          return 0;
+        }
+        // Another producer claimed head in the meantime.
+        head = head_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (head_.compare_exchange_weak(head, head + n, std::memory_order_relaxed,
+                                      std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      uint64_t position = head + i;
+      data_[position % capacity_].Swap(ptrs[i]);
+      sequences_[position % capacity_].store(UsedSequence(position), std::memory_order_release);
+    }
+    return n;
+  }
+
+  /**
+   * Clear the circular buffer.
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  void Clear() noexcept { Consume(size()); }
+
+  /**
+   * @return the maximum number of elements that can be stored in the buffer.
+   */
+  size_t max_size() const noexcept { return capacity_; }
+
+  /**
+   * @return true if the buffer is empty.
+   */
+  bool empty() const noexcept { return head_ == tail_; }
+
+  /**
+   * @return the number of elements stored in the circular buffer, including
+   * elements that are still being added by producers.
+   *
+   * Note: this method will only return a correct snapshot of the size if called
+   * from the consumer thread.
+   */
+  size_t size() const noexcept
+  {
+    uint64_t tail = tail_;
+    uint64_t head = head_;
+    assert(tail <= head);
+    return head - tail;
+  }
+
+  /**
+   * @return the number of elements consumed from the circular buffer.
+   */
+  uint64_t consumption_count() const noexcept { return tail_; }
+
+  /**
+   * @return the number of elements added to the circular buffer.
+   */
+  uint64_t production_count() const noexcept { return head_; }
+
+private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  std::unique_ptr<AtomicUniquePtr<T>[]> data_;
+  std::unique_ptr<std::atomic<uint64_t>[]> sequences_;
+  size_t capacity_;
+  char padding0_[kCacheLineSize];
+  std::atomic<uint64_t> head_{0};
+  char padding1_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> tail_{0};
+  char padding2_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+
+  static uint64_t FreeSequence(uint64_t position) noexcept { return 2 * position; }
+
+  static uint64_t UsedSequence(uint64_t position) noexcept { return 2 * position + 1; }
+
+  /**
+   * @return the number of consecutive elements from tail_, up to n, which
+   * producers have finished adding.
+   */
+  size_t CountPublished(size_t n) const noexcept
+  {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i)
+    {
+      uint64_t position = tail + i;
+      if (sequences_[position % capacity_].load(std::memory_order_acquire) !=
+          UsedSequence(position))
+      {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  CircularBufferRange<AtomicUniquePtr<T>> PeekImpl(size_t n) noexcept
+  {
+    if (n == 0)
+    {
+      return {};
+    }
+    uint64_t tail_index = tail_ % capacity_;
+    auto data           = data_.get();
+    if (tail_index + n <= capacity_)
+    {
+      return CircularBufferRange<AtomicUniquePtr<T>>{
+          nostd::span<AtomicUniquePtr<T>>{data + tail_index, n}};
+    }
+    return {nostd::span<AtomicUniquePtr<T>>{data + tail_index, capacity_ - tail_index},
+            nostd::span<AtomicUniquePtr<T>>{data, n - (capacity_ - tail_index)}};
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "opentelemetry/sdk/common/sequenced_circular_buffer.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A set of lock-free circular buffers (shards) that supports multiple
+ * concurrent producers and a single consumer.
+ *
+ * Every producer thread is assigned one shard, so that producers running on
+ * different threads contend on different counters. The consumer drains the
+ * shards round-robin. Elements are ordered within a shard, but not across
+ * shards.
+ */
+template <class T>
+class ShardedCircularBuffer
+{
+public:
+  /**
+   * @param max_size the maximum number of elements over all shards
+   * @param num_shards the number of shards, at least one
+   */
+  ShardedCircularBuffer(size_t max_size, size_t num_shards)
+  {
+    num_shards = (std::max)(num_shards, size_t{1});
+    // Each shard is a separate allocation, so that the counters of different
+    // shards do not share a cache line.
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+      shards_.emplace_back(
+          new SequencedCircularBuffer<T>{(max_size + num_shards - 1) / num_shards});
+    }
+  }
+
+  /**
+   * @return the shard the calling thread adds elements to
+   */
+  SequencedCircularBuffer<T> &GetShard() noexcept { return GetShard(GetShardIndex()); }
+
+  /**
+   * @return the index of the shard the calling thread adds elements to
+   */
+  size_t GetShardIndex() const noexcept { return GetThreadIndex() % shards_.size(); }
+
+  /**
+   * @param index the index of a shard, less than num_shards()
+   * @return the shard with the given index
+   */
+  SequencedCircularBuffer<T> &GetShard(size_t index) noexcept { return *shards_[index]; }
+
+  /**
+   * Adds an element into the shard of the calling thread.
+   * @param ptr a pointer to the element to add
+   * @return true if the element was successfully added; false, otherwise.
+   */
+  bool Add(std::unique_ptr<T> &ptr) noexcept { return GetShard().Add(ptr); }
+
+  /**
+   * Consume up to n elements from the shards. Every shard is first offered an
+   * equal share of n, and the remainder is then taken from the shards that
+   * have more elements. The first shard visited changes on every call.
+   * @param n the maximum number of elements to consume
+   * @param callback the callback to invoke once per shard with a range of
+   * AtomicUniquePtr to the consumed elements of that shard
+   * @return the number of elements consumed
+   *
+   * Note: The callback must set the passed AtomicUniquePtr to null.
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  template <class Callback>
+  size_t Consume(size_t n, Callback callback) noexcept
+  {
+    const size_t num_shards = shards_.size();
+    const size_t fair_share = (n + num_shards - 1) / num_shards;
+    size_t remaining        = n;
+    for (size_t pass = 0; pass < 2 && remaining > 0; ++pass)
+    {
+      for (size_t i = 0; i < num_shards && remaining > 0; ++i)
+      {
+        auto &shard  = *shards_[(next_shard_ + i) % num_shards];
+        size_t count = (std::min)(shard.size(), remaining);
+        if (pass == 0)
+        {
+          count = (std::min)(count, fair_share);
+        }
+        if (count == 0)
+        {
+          continue;
+        }
+        remaining -= shard.Consume(count, callback);
+      }
+    }
+    next_shard_ = (next_shard_ + 1) % num_shards;
+    return n - remaining;
+  }
+
+  /**
+   * @return the maximum number of elements that can be stored in all shards.
+   */
+  size_t max_size() const noexcept { return shards_.size() * shards_.front()->max_size(); }
+
+  /**
+   * @return true if all shards are empty.
+   */
+  bool empty() const noexcept
+  {
+    for (auto &shard : shards_)
+    {
+      if (!shard->empty())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @return the number of elements stored in all shards.
+   *
+   * Note: this method will only return a correct snapshot of the size if called
+   * from the consumer thread.
+   */
+  size_t size() const noexcept
+  {
+    size_t result = 0;
+    for (auto &shard : shards_)
+    {
+      result += shard->size();
+    }
+    return result;
+  }
+
+  /**
+   * @return the number of elements added to all shards.
+   */
+  uint64_t production_count() const noexcept
+  {
+    uint64_t result = 0;
+    for (auto &shard : shards_)
+    {
+      result += shard->production_count();
+    }
+    return result;
+  }
+
+  /**
+   * @return the number of shards.
+   */
+  size_t num_shards() const noexcept { return shards_.size(); }
+
+private:
+  std::vector<std::unique_ptr<SequencedCircularBuffer<T>>> shards_;
+  size_t next_shard_ = 0;
+
+  /**
+   * @return a number assigned to the calling thread, distinct for consecutively
+   * started threads so that they spread evenly over the shards.
+   */
+  static size_t GetThreadIndex() noexcept
+  {
+    static std::atomic<size_t> next_thread_index{0};
+    thread_local size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return thread_index;
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A string stored in a StringInternTable.
+ */
+struct InternedStringEntry
+{
+  uint32_t id;
+  uint64_t hash;
+  std::string value;
+};
+
+/**
+ * A handle to an interned string. Handles are trivially copyable, and two valid
+ * handles obtained from the same table compare equal if and only if their
+ * strings are equal, so they can be compared and hashed by id.
+ */
+class InternedString
+{
+public:
+  InternedString() noexcept = default;
+
+  explicit InternedString(const InternedStringEntry *entry) noexcept : entry_{entry} {}
+
+  /**
+   * @return false if the string could not be interned
+   */
+  bool IsValid() const noexcept { return entry_ != nullptr; }
+
+  /**
+   * @return the id of the string, unique within its table, or 0 for an invalid handle
+   */
+  uint32_t GetId() const noexcept { return entry_ == nullptr ? 0 : entry_->id; }
+
+  /**
+   * @return the interned string, or an empty string for an invalid handle
+   */
+  nostd::string_view GetValue() const noexcept
+  {
+    return entry_ == nullptr ? nostd::string_view{} : nostd::string_view{entry_->value};
+  }
+
+  bool operator==(const InternedString &other) const noexcept { return entry_ == other.entry_; }
+
+  bool operator!=(const InternedString &other) const noexcept { return entry_ != other.entry_; }
+
+private:
+  const InternedStringEntry *entry_ = nullptr;
+};
+
+/**
+ * An append-only table of interned strings, such as span names and attribute
+ * keys, which mostly come from a small fixed set of literals.
+ *
+ * The table is a fixed-size open addressing hash table of atomic pointers.
+ * Lookups never take a lock, and new strings are published with a single
+ * compare-and-swap, so concurrent Intern() calls for the same string agree on
+ * one entry. Entries are never removed: handles and the views they return stay
+ * valid for the lifetime of the table.
+ *
+ * To bound the memory held by the table, strings longer than kMaxLength are not
+ * interned, and no more than half of the slots are ever used. Intern() returns
+ * an invalid handle in both cases, and callers are expected to fall back to an
+ * owned copy of the string.
+ */
+class StringInternTable
+{
+public:
+  /* The default number of slots of a table. */
+  static constexpr size_t kDefaultCapacity = 8192;
+
+  /* The maximum length of an interned string. */
+  static constexpr size_t kMaxLength = 128;
+
+  /**
+   * @param capacity the number of slots, rounded up to a power of two
+   */
+  explicit StringInternTable(size_t capacity = kDefaultCapacity)
+  {
+    capacity_ = 1;
+    while (capacity_ < capacity)
+    {
+      capacity_ <<= 1;
+    }
+    slots_.reset(new std::atomic<const InternedStringEntry *>[capacity_]);
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+      slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  StringInternTable(const StringInternTable &) = delete;
+  StringInternTable &operator=(const StringInternTable &) = delete;
+
+  ~StringInternTable()
+  {
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+      delete slots_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @return the process-wide table. It is never destroyed, so handles remain
+   * valid even for spans exported while static objects are being destroyed.
+   */
+  static StringInternTable &GetInstance() noexcept
+  {
+    static StringInternTable *instance = new StringInternTable;
+    return *instance;
+  }
+
+  /**
+   * Intern a string.
+   * @return a handle to the interned string, which is invalid if the string is
+   * too long or the table is full
+   */
+  InternedString Intern(nostd::string_view value) noexcept
+  {
+    if (value.size() > kMaxLength)
+    {
+      return InternedString{};
+    }
+    uint64_t hash = Hash(value);
+    std::unique_ptr<InternedStringEntry> entry;
+    for (size_t probe = 0, index = hash & (capacity_ - 1); probe < capacity_;
+         ++probe, index = (index + 1) & (capacity_ - 1))
+    {
+      auto current = slots_[index].load(std::memory_order_acquire);
+      if (current == nullptr)
+      {
+        if (size_.load(std::memory_order_relaxed) >= capacity_ / 2)
+        {
+          return InternedString{};
+        }
+        if (entry == nullptr)
+        {
+          entry.reset(new (std::nothrow) InternedStringEntry{0, hash, std::string{}});
+          if (entry == nullptr)
+          {
+            return InternedString{};
+          }
+          entry->value.assign(value.data(), value.size());
+        }
+        entry->id = static_cast<uint32_t>(index + 1);
+        if (slots_[index].compare_exchange_strong(current, entry.get(), std::memory_order_acq_rel,
+                                                  std::memory_order_acquire))
+        {
+          size_.fetch_add(1, std::memory_order_relaxed);
+          return InternedString{entry.release()};
+        }
+        // Another thread filled the slot first, current now points to its entry.
+      }
+      if (Equals(current, hash, value))
+      {
+        return InternedString{current};
+      }
+    }
+    return InternedString{};
+  }
+
+  /**
+   * Look up a string without interning it.
+   * @return a handle to the interned string, or an invalid handle if it was not interned
+   */
+  InternedString Find(nostd::string_view value) const noexcept
+  {
+    uint64_t hash = Hash(value);
+    for (size_t probe = 0, index = hash & (capacity_ - 1); probe < capacity_;
+         ++probe, index = (index + 1) & (capacity_ - 1))
+    {
+      auto current = slots_[index].load(std::memory_order_acquire);
+      if (current == nullptr)
+      {
+        break;
+      }
+      if (Equals(current, hash, value))
+      {
+        return InternedString{current};
+      }
+    }
+    return InternedString{};
+  }
+
+  /**
+   * @return the number of interned strings
+   */
+  size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+private:
+  size_t capacity_;
+  std::unique_ptr<std::atomic<const InternedStringEntry *>[]> slots_;
+  std::atomic<size_t> size_{0};
+
+  // 64-bit FNV-1a
+  static uint64_t Hash(nostd::string_view value) noexcept
+  {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : value)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  static bool Equals(const InternedStringEntry *entry,
+                     uint64_t hash,
+                     nostd::string_view value) noexcept
+  {
+    return entry->hash == hash && entry->value.size() == value.size() &&
+           std::memcmp(entry->value.data(), value.data(), value.size()) == 0;
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
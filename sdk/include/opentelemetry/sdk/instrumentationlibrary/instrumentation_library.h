@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace instrumentationlibrary
+{
+/**
+ * The name and version of the library emitting telemetry, as passed to
+ * TracerProvider::GetTracer.
+ */
+class InstrumentationLibrary
+{
+public:
+  InstrumentationLibrary(const InstrumentationLibrary &) = default;
+
+  /**
+   * Returns a newly created InstrumentationLibrary with the specified name and version.
+   * @param name name of the instrumentation library.
+   * @param version version of the instrumentation library.
+   * @returns the newly created InstrumentationLibrary.
+   */
+  static std::unique_ptr<InstrumentationLibrary> Create(nostd::string_view name,
+                                                        nostd::string_view version = "")
+  {
+    return std::unique_ptr<InstrumentationLibrary>(new InstrumentationLibrary{name, version});
+  }
+
+  /**
+   * Compare two instrumentation libraries.
+   * @param other the instrumentation library to compare to.
+   * @returns true if the name and version of both instrumentation libraries match.
+   */
+  bool operator==(const InstrumentationLibrary &other) const noexcept
+  {
+    return equal(other.name_, other.version_);
+  }
+
+  /**
+   * Check whether the instrumentation library has the given name and version.
+   * @param name name of the instrumentation library to compare.
+   * @param version version of the instrumentation library to compare.
+   * @returns true if the name and version match.
+   */
+  bool equal(const nostd::string_view name, const nostd::string_view version) const noexcept
+  {
+    return name == name_ && version == version_;
+  }
+
+  const std::string &GetName() const noexcept { return name_; }
+
+  const std::string &GetVersion() const noexcept { return version_; }
+
+private:
+  InstrumentationLibrary(nostd::string_view name, nostd::string_view version)
+      : name_(name.data(), name.size()), version_(version.data(), version.size())
+  {}
+
+  std::string name_;
+  std::string version_;
+};
+}  // namespace instrumentationlibrary
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -16,13 +16,16 @@
 
 #pragma once
 
-#include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/sdk/common/batch_queue.h"
+#include "opentelemetry/sdk/common/deadline.h"
+#include "opentelemetry/sdk/common/executor.h"
+#include "opentelemetry/sdk/common/retry_buffer.h"
 #include "opentelemetry/sdk/logs/exporter.h"
 #include "opentelemetry/sdk/logs/processor.h"
 
 #include <atomic>
 #include <condition_variable>
-#include <thread>
+#include <functional>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -31,6 +34,73 @@ namespace sdk
 namespace logs
 {
 
+/**
+ * Struct to hold batch LogProcessor options.
+ */
+struct BatchLogProcessorOptions
+{
+  /**
+   * The maximum buffer/queue size. After the size is reached, logs are
+   * dropped, depending on the overflow policy.
+   */
+  size_t max_queue_size = 2048;
+
+  /* The time interval between two consecutive exports. */
+  std::chrono::milliseconds scheduled_delay_millis = std::chrono::milliseconds(5000);
+
+  /**
+   * The maximum batch size of every export. It must be smaller or
+   * equal to max_queue_size.
+   */
+  size_t max_export_batch_size = 512;
+
+  /* What to do with a log record received while the queue is full. */
+  common::OverflowPolicy overflow_policy = common::OverflowPolicy::kDropNewest;
+
+  /**
+   * How long OnReceive waits for room in the queue with
+   * OverflowPolicy::kBlock, before dropping the log record.
+   */
+  std::chrono::milliseconds max_block_time = std::chrono::milliseconds(1000);
+
+  /**
+   * The priority of a log record for OverflowPolicy::kDropLowestPriority,
+   * where records with lower values are dropped first. If empty, the priority
+   * is the severity of LogRecord recordables; for other recordables, the
+   * priority must be provided.
+   */
+  std::function<int(const Recordable &)> priority;
+
+  /**
+   * The memory budget of the queue, in bytes estimated by
+   * Recordable::GetEstimatedSize. A log record which does not fit into the
+   * budget is handled as if the queue were full. Zero means no budget.
+   */
+  size_t max_queue_size_bytes = 0;
+
+  /**
+   * The maximum estimated size in bytes of every export, in addition to
+   * max_export_batch_size. A larger log record is exported alone. Zero means
+   * no limit.
+   */
+  size_t max_export_batch_size_bytes = 0;
+
+  /**
+   * The executor to run the background work on, which may be shared with
+   * other processors. If empty, the processor creates an executor of its own
+   * with one thread.
+   */
+  std::shared_ptr<common::Executor> executor;
+
+  /**
+   * How batches are retried when the exporter fails with
+   * ExportResult::kFailureRetryable. Retries run on the worker task after
+   * their backoff, right away on ForceFlush, and on Shutdown until the timeout
+   * expires.
+   */
+  common::RetryOptions retry_options;
+};
+
 /**
  * This is an implementation of the LogProcessor which creates batches of finished logs and passes
  * the export-friendly log data representations to the configured LogExporter.
@@ -55,6 +125,16 @@ class BatchLogProcessor : public LogProcessor
       const std::chrono::milliseconds scheduled_delay_millis = std::chrono::milliseconds(5000),
       const size_t max_export_batch_size                     = 512);
 
+  /**
+   * Creates a batch log processor by configuring the specified exporter and other parameters
+   * as per the official, language-agnostic opentelemetry specs.
+   *
+   * @param exporter - The backend exporter to pass the logs to
+   * @param options - The batch LogProcessor options.
+   */
+  BatchLogProcessor(std::unique_ptr<LogExporter> &&exporter,
+                    const BatchLogProcessorOptions &options);
+
   /** Makes a new recordable **/
   std::unique_ptr<Recordable> MakeRecordable() noexcept override;
 
@@ -68,7 +148,11 @@ class BatchLogProcessor : public LogProcessor
   /**
    * Export all log records that have not been exported yet.
    *
-   * NOTE: Timeout functionality not supported yet.
+   * Blocks until the worker task has exported all the log records queued before
+   * the call, or until the timeout expires.
+   *
+   * @return true if all the log records were exported in time, and none of
+   * them waits for a retry after a retryable export failure
    */
   bool ForceFlush(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
@@ -78,7 +162,13 @@ class BatchLogProcessor : public LogProcessor
    * all its logs and passes them to the exporter. Any subsequent calls to
    * ForceFlush or Shutdown will return immediately without doing anything.
    *
-   * NOTE: Timeout functionality not supported yet.
+   * The queue is drained until the timeout expires, and the remaining log records are
+   * discarded. The exporter is shut down with the time left. An export still
+   * running when the timeout expires is abandoned; the destructor then waits for
+   * it, and shuts the exporter down.
+   *
+   * @return false if the queue was not drained in time, or if the exporter failed
+   * to shut down
    */
   bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
@@ -88,11 +178,31 @@ class BatchLogProcessor : public LogProcessor
    */
   virtual ~BatchLogProcessor() override;
 
+  /**
+   * @return the number of log records added to the queue and not dropped later to
+   * make room for other records. Every log record is either accepted or dropped.
+   */
+  uint64_t GetAcceptedCount() const noexcept { return buffer_.accepted_count(); }
+
+  /**
+   * @return the number of log records dropped because the queue was full.
+   */
+  uint64_t GetDroppedCount() const noexcept { return buffer_.dropped_count(); }
+
+  /**
+   * @return the number of log records dropped after a retryable export
+   * failure, because they had no attempts left or the retry buffer was full.
+   */
+  uint64_t GetRetryDroppedCount() const noexcept { return retry_buffer_.dropped_count(); }
+
 private:
   /**
-   * The background routine performed by the worker thread.
+   * The background routine performed by the worker task, on every scheduled
+   * delay or when woken up.
+   *
+   * @return the delay until the next run
    */
-  void DoBackgroundWork();
+  common::Executor::Clock::duration DoBackgroundWork();
 
   /**
    * Exports all logs to the configured exporter.
@@ -105,10 +215,37 @@ class BatchLogProcessor : public LogProcessor
   void Export(const bool was_for_flush_called);
 
   /**
-   * Called when Shutdown() is invoked. Completely drains the queue of all log records and
-   * passes them to the exporter.
+   * Passes a batch to the exporter, and adds it to the retry buffer if the
+   * export failed with ExportResult::kFailureRetryable.
    */
-  void DrainQueue();
+  void ExportOrRetry(nostd::span<std::unique_ptr<Recordable>> batch);
+
+  /**
+   * Exports the batches of the retry buffer whose backoff expired by the
+   * given time again.
+   */
+  void Retry(common::Executor::Clock::time_point time);
+
+  /**
+   * @return the given delay of the worker task, shortened to the next retry.
+   */
+  common::Executor::Clock::duration GetNextDelay(common::Executor::Clock::duration delay) const;
+
+  /**
+   * Called when Shutdown() is invoked. Drains the queue, passing its log records to
+   * the exporter, and retries the failed batches that are due.
+   * @return the delay until the next retry, or the maximum duration if no retry
+   * is due before the shutdown deadline
+   */
+  common::Executor::Clock::duration DrainQueue();
+
+  /**
+   * Marks the flushes up to the given sequence number as completed, and wakes
+   * up the threads waiting for them.
+   * @param succeeded whether all the log records were exported, without any
+   * waiting for a retry
+   */
+  void CompleteFlush(uint64_t flush_sequence, bool succeeded);
 
   /* The configured backend log exporter */
   std::unique_ptr<LogExporter> exporter_;
@@ -117,21 +254,41 @@ class BatchLogProcessor : public LogProcessor
   const size_t max_queue_size_;
   const std::chrono::milliseconds scheduled_delay_millis_;
   const size_t max_export_batch_size_;
+  const size_t max_export_batch_size_bytes_;
 
   /* Synchronization primitives */
-  std::condition_variable cv_, force_flush_cv_;
-  std::mutex cv_m_, force_flush_cv_m_;
+  std::condition_variable force_flush_cv_;
+  std::mutex cv_m_;
+
+  /**
+   * The sequence numbers of the last flush requested and of the last flush
+   * completed by the worker task, guarded by cv_m_. Every flush exports all
+   * the log records queued before it was requested, and succeeded if it, or a
+   * later flush, was the last flush that completed without log records
+   * waiting for a retry.
+   */
+  uint64_t flush_requested_ = 0;
+  uint64_t flush_completed_ = 0;
+  uint64_t flush_succeeded_ = 0;
+
+  /* The deadline to drain the queue by, set before is_shutdown_ */
+  common::Deadline shutdown_deadline_{(std::chrono::microseconds::max)()};
 
   /* The buffer/queue to which the ended logs are added */
-  common::CircularBuffer<Recordable> buffer_;
+  common::BatchQueue<Recordable> buffer_;
 
   /* Important boolean flags to handle the workflow of the processor */
   std::atomic<bool> is_shutdown_{false};
-  std::atomic<bool> is_force_flush_{false};
-  std::atomic<bool> is_force_flush_notified_{false};
 
-  /* The background worker thread */
-  std::thread worker_thread_;
+  /* The batches waiting to be exported again after a retryable failure */
+  common::RetryBuffer<Recordable> retry_buffer_;
+
+  /* Whether Shutdown returned at its deadline while the worker task was running */
+  bool is_work_abandoned_ = false;
+
+  /* The executor and the background worker task running on it */
+  std::shared_ptr<common::Executor> executor_;
+  std::unique_ptr<common::ScheduledTask> worker_;
 };
 
 }  // namespace logs
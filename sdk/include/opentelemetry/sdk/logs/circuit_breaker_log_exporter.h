@@ -0,0 +1,74 @@
+/*
+ * Copyright The OpenTelemetry Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "opentelemetry/sdk/common/circuit_breaker.h"
+#include "opentelemetry/sdk/logs/exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+/**
+ * A log exporter which passes batches to another exporter through a circuit
+ * breaker. After consecutive failed exports, the circuit opens and batches are
+ * rejected before the exporter serializes them, until a probe export after the
+ * open duration succeeds.
+ *
+ * Rejected batches either fail with ExportResult::kFailureRetryable, so that a
+ * batch processor keeps them in its retry buffer, or are dropped, depending on
+ * CircuitBreakerOptions::retry_rejected.
+ */
+class CircuitBreakerLogExporter final : public LogExporter
+{
+public:
+  /**
+   * @param exporter the exporter to pass the batches to
+   * @param options the circuit breaker options
+   */
+  CircuitBreakerLogExporter(std::unique_ptr<LogExporter> &&exporter,
+                            const common::CircuitBreakerOptions &options);
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<Recordable>> &records) noexcept override;
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
+
+  /**
+   * @return the current state of the circuit.
+   */
+  common::CircuitState GetState() const noexcept { return circuit_breaker_.state(); }
+
+  /**
+   * @return the number of batches rejected while the circuit was open.
+   */
+  uint64_t GetRejectedCount() const noexcept { return circuit_breaker_.rejected_count(); }
+
+private:
+  std::unique_ptr<LogExporter> exporter_;
+  common::CircuitBreaker circuit_breaker_;
+};
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
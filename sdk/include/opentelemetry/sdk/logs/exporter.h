@@ -17,8 +17,10 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 #include "opentelemetry/nostd/span.h"
+#include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/common/exporter_utils.h"
 #include "opentelemetry/sdk/logs/processor.h"
 #include "opentelemetry/sdk/logs/recordable.h"
@@ -68,6 +70,31 @@ class LogExporter
   virtual bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept = 0;
 };
+
+/**
+ * A log exporter which can encode a batch into its wire format separately
+ * from sending it, so that an encoded batch can be stored, for example by a
+ * SpoolingLogExporter, and sent later without serializing it again.
+ */
+class EncodingLogExporter : public LogExporter
+{
+public:
+  /**
+   * Encodes a batch of log records, taking them from the batch.
+   * @param records a span of unique pointers to log records
+   * @param data the encoded batch
+   * @return true if the batch was encoded
+   */
+  virtual bool Encode(const nostd::span<std::unique_ptr<Recordable>> &records,
+                      std::string *data) noexcept = 0;
+
+  /**
+   * Sends a batch encoded by Encode. This method must not be called
+   * concurrently with itself or Export for the same exporter instance.
+   * @param data the encoded batch
+   */
+  virtual sdk::common::ExportResult ExportEncoded(nostd::string_view data) noexcept = 0;
+};
 }  // namespace logs
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -17,8 +17,7 @@
 #pragma once
 
 #include <map>
-#include <unordered_map>
-#include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/sdk/common/flat_attribute_map.h"
 #include "opentelemetry/sdk/logs/recordable.h"
 #include "opentelemetry/version.h"
 
@@ -40,8 +39,8 @@ class LogRecord final : public Recordable
   // Default values are set by the respective data structures' constructors for all fields,
   // except the severity field, which must be set manually (an enum with no default value).
   opentelemetry::logs::Severity severity_ = opentelemetry::logs::Severity::kInvalid;
-  common::AttributeMap resource_map_;
-  common::AttributeMap attributes_map_;
+  common::FlatAttributeMap<4> resource_map_;
+  common::FlatAttributeMap<8> attributes_map_;
   std::string name_;
   std::string body_;  // Currently a simple string, but should be changed to "Any" type
   opentelemetry::trace::TraceId trace_id_;
@@ -129,6 +128,19 @@ class LogRecord final : public Recordable
    */
   void SetTimestamp(core::SystemTimestamp timestamp) noexcept override { timestamp_ = timestamp; }
 
+  /**
+   * Estimate the size of this log once encoded for export.
+   * @return the approximate encoded size of this log in bytes
+   */
+  size_t GetEstimatedSize() const noexcept override
+  {
+    // The timestamp, severity, trace id, span id and trace flags.
+    constexpr size_t kFixedSize = 48;
+    return kFixedSize + name_.size() + body_.size() +
+           resource_map_.GetAttributes().GetEstimatedSize() +
+           attributes_map_.GetAttributes().GetEstimatedSize();
+  }
+
   /************************** Getters for each field ****************************/
 
   /**
@@ -153,19 +165,13 @@ class LogRecord final : public Recordable
    * Get the resource field for this log
    * @return the resource field for this log
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetResource() const noexcept
-  {
-    return resource_map_.GetAttributes();
-  }
+  common::AttributeView GetResource() const noexcept { return resource_map_.GetAttributes(); }
 
   /**
    * Get the attributes for this log
    * @return the attributes for this log
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
-  {
-    return attributes_map_.GetAttributes();
-  }
+  common::AttributeView GetAttributes() const noexcept { return attributes_map_.GetAttributes(); }
 
   /**
    * Get the trace id for this log
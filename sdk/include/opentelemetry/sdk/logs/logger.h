@@ -57,7 +57,8 @@ class Logger final : public opentelemetry::logs::Logger
    * @param trace_id the trace id associated with the log event.
    * @param span_id the span id associate with the log event.
    * @param trace_flags the trace flags associated with the log event.
-   * @param timestamp the timestamp the log record was created.
+   * @param timestamp the timestamp the log record was created. If not set, the
+   * clock of the logger provider is read.
    * @throws No exceptions under any circumstances.   */
   void Log(opentelemetry::logs::Severity severity,
            nostd::string_view name,
@@ -26,6 +26,7 @@
 #include "opentelemetry/logs/noop.h"
 #include "opentelemetry/nostd/shared_ptr.h"
 #include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/clock.h"
 #include "opentelemetry/sdk/logs/logger.h"
 #include "opentelemetry/sdk/logs/processor.h"
 
@@ -47,8 +48,11 @@ class LoggerProvider final : public opentelemetry::logs::LoggerProvider,
   /**
    * Initialize a new logger provider. A processor must later be assigned
    * to this logger provider via the SetProcessor() method.
+   * @param clock The clock for the timestamps of log records logged without a
+   * timestamp. This must not be a nullptr.
    */
-  explicit LoggerProvider() noexcept;
+  explicit LoggerProvider(std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+                              opentelemetry::sdk::common::SystemClock::GetInstance()) noexcept;
 
   /**
    * Creates a logger with the given name, and returns a shared pointer to it.
@@ -86,10 +90,18 @@ class LoggerProvider final : public opentelemetry::logs::LoggerProvider,
    */
   void SetProcessor(std::shared_ptr<LogProcessor> processor) noexcept;
 
+  /**
+   * Returns the clock used by the loggers of this logger provider.
+   */
+  opentelemetry::sdk::common::Clock &GetClock() const noexcept;
+
 private:
   // A pointer to the processor stored by this logger provider
   opentelemetry::sdk::common::AtomicSharedPtr<LogProcessor> processor_;
 
+  // The clock for log records logged without a timestamp
+  const std::shared_ptr<opentelemetry::sdk::common::Clock> clock_;
+
   // A vector of pointers to all the loggers that have been created
   std::unordered_map<std::string, opentelemetry::nostd::shared_ptr<opentelemetry::logs::Logger>>
       loggers_;
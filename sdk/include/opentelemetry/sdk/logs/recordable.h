@@ -85,6 +85,15 @@ class Recordable
    * @param trace_flags the trace flags to set
    */
   virtual void SetTraceFlags(opentelemetry::trace::TraceFlags trace_flags) noexcept = 0;
+
+  /**
+   * Estimate the size of the log record once encoded for export, which batch
+   * log processors use to bound the memory used by their queue and the size of
+   * export requests.
+   * @return the approximate encoded size of the log record in bytes, or 0 if
+   * unknown
+   */
+  virtual size_t GetEstimatedSize() const noexcept { return 0; }
 };
 }  // namespace logs
 }  // namespace sdk
@@ -0,0 +1,69 @@
+/*
+ * Copyright The OpenTelemetry Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "opentelemetry/sdk/common/disk_spool.h"
+#include "opentelemetry/sdk/logs/exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+/**
+ * A log exporter which keeps the batches in a disk spool while the backend is
+ * down. Every batch is encoded once by the wrapped exporter. If sending it
+ * fails with ExportResult::kFailureRetryable, the encoded batch is appended to
+ * the spool, and once the backend recovers the spooled batches are sent in
+ * order before new ones, without serializing them again. The backlog is
+ * replayed on the executor of the spool options, and within the timeout of
+ * Shutdown().
+ */
+class SpoolingLogExporter final : public LogExporter
+{
+public:
+  /**
+   * @param exporter the exporter encoding and sending the batches
+   * @param options the disk spool options
+   */
+  SpoolingLogExporter(std::unique_ptr<EncodingLogExporter> &&exporter,
+                      const common::DiskSpoolOptions &options);
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<Recordable>> &records) noexcept override;
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
+
+  /**
+   * @return the number of spool segments deleted because the spool was full,
+   * or because they were corrupted.
+   */
+  uint64_t GetEvictedCount() const noexcept { return spooler_.evicted_count(); }
+
+private:
+  std::unique_ptr<EncodingLogExporter> exporter_;
+  common::Spooler spooler_;
+};
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
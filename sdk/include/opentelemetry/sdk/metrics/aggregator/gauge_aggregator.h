@@ -2,6 +2,7 @@
 
 #include "opentelemetry/core/timestamp.h"
 #include "opentelemetry/metrics/instrument.h"
+#include "opentelemetry/sdk/common/clock.h"
 #include "opentelemetry/sdk/metrics/aggregator/aggregator.h"
 #include "opentelemetry/version.h"
 
@@ -21,7 +22,8 @@ namespace metrics
  * type T where the contents of the vector simply
  * include the last value recorded to the aggregator.
  * The aggregator also maintains a timestamp of when
- * the last value was recorded.
+ * the last value was recorded, read from the clock passed
+ * to the constructor.
  *
  * @tparam T the type of values stored in this aggregator.
  */
@@ -29,19 +31,22 @@ template <class T>
 class GaugeAggregator : public Aggregator<T>
 {
 public:
-  explicit GaugeAggregator<T>(metrics_api::InstrumentKind kind)
+  explicit GaugeAggregator<T>(metrics_api::InstrumentKind kind,
+                              std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+                                  opentelemetry::sdk::common::SystemClock::GetInstance())
+      : clock_(std::move(clock))
   {
     static_assert(std::is_arithmetic<T>::value, "Not an arithmetic type");
     this->kind_        = kind;
     this->values_      = std::vector<T>(1, 0);
     this->checkpoint_  = this->values_;
     this->agg_kind_    = AggregatorKind::Gauge;
-    current_timestamp_ = core::SystemTimestamp(std::chrono::system_clock::now());
+    current_timestamp_ = clock_->SystemNow();
   }
 
   ~GaugeAggregator() = default;
 
-  GaugeAggregator(const GaugeAggregator &cp)
+  GaugeAggregator(const GaugeAggregator &cp) : clock_(cp.clock_)
   {
     this->values_      = cp.values_;
     this->checkpoint_  = cp.checkpoint_;
@@ -61,7 +66,7 @@ class GaugeAggregator : public Aggregator<T>
     this->mu_.lock();
     this->updated_     = true;
     this->values_[0]   = val;
-    current_timestamp_ = core::SystemTimestamp(std::chrono::system_clock::now());
+    current_timestamp_ = clock_->SystemNow();
     this->mu_.unlock();
   }
 
@@ -82,7 +87,7 @@ class GaugeAggregator : public Aggregator<T>
     // Reset the values to default
     this->values_[0]      = 0;
     checkpoint_timestamp_ = current_timestamp_;
-    current_timestamp_    = core::SystemTimestamp(std::chrono::system_clock::now());
+    current_timestamp_    = clock_->SystemNow();
 
     this->mu_.unlock();
   }
@@ -101,7 +106,7 @@ class GaugeAggregator : public Aggregator<T>
       this->values_[0] = other.values_[0];
       // Now merge checkpoints
       this->checkpoint_[0] = other.checkpoint_[0];
-      current_timestamp_   = core::SystemTimestamp(std::chrono::system_clock::now());
+      current_timestamp_   = clock_->SystemNow();
       this->mu_.unlock();
     }
     else
@@ -132,6 +137,7 @@ class GaugeAggregator : public Aggregator<T>
   core::SystemTimestamp get_timestamp() { return current_timestamp_; }
 
 private:
+  std::shared_ptr<opentelemetry::sdk::common::Clock> clock_;
   core::SystemTimestamp current_timestamp_;
   core::SystemTimestamp checkpoint_timestamp_;
 };
@@ -3,10 +3,10 @@
 #include <atomic>
 #include <iostream>
 #include <sstream>
-#include <thread>
 #include <vector>
 #include "opentelemetry/metrics/instrument.h"
 #include "opentelemetry/nostd/unique_ptr.h"
+#include "opentelemetry/sdk/common/executor.h"
 #include "opentelemetry/sdk/metrics/exporter.h"
 #include "opentelemetry/sdk/metrics/meter.h"
 #include "opentelemetry/sdk/metrics/processor.h"
@@ -29,13 +29,15 @@ class PushController
                  nostd::unique_ptr<MetricsExporter> exporter,
                  nostd::shared_ptr<MetricsProcessor> processor,
                  double period,
-                 int timeout = 30)
+                 int timeout                                     = 30,
+                 std::shared_ptr<sdk::common::Executor> executor = nullptr)
   {
     meter_     = meter;
     exporter_  = std::move(exporter);
     processor_ = processor;
     timeout_   = (unsigned int)(timeout * 1000000);  // convert seconds to microseconds
     period_    = (unsigned int)(period * 1000000);
+    executor_  = executor;
   }
 
   /*
@@ -50,8 +52,9 @@ class PushController
 
   /*
    * Begins the data processing and export pipeline.  The function first ensures that the pipeline
-   * is not already running.  If not, it begins and detaches a new thread for the Controller's run
-   * function which periodically polls the instruments for their data.
+   * is not already running.  If not, it schedules a task for the Controller's run function which
+   * periodically polls the instruments for their data, on the executor passed to the constructor
+   * or else on an executor of its own.
    *
    * @param none
    * @return a boolean which is true when the pipeline is successfully started and false when
@@ -61,7 +64,12 @@ class PushController
   {
     if (!active_.exchange(true))
     {
-      runner_ = std::thread(&PushController::run, this);
+      if (executor_ == nullptr)
+      {
+        executor_ = std::make_shared<sdk::common::Executor>();
+      }
+      runner_.reset(new sdk::common::ScheduledTask(
+          executor_, [this] { return run(); }, std::chrono::microseconds(0)));
       return true;
     }
     return false;
@@ -78,7 +86,7 @@ class PushController
   {
     if (active_.exchange(false))
     {
-      runner_.join();
+      runner_->Stop();
       tick();  // flush metrics sitting in the processor
     }
   }
@@ -86,21 +94,14 @@ class PushController
 private:
   /*
    * Run the tick function at a regular interval. This function
-   * should be run in its own thread.
+   * is run by a scheduled task.
    *
-   * Used to wait between collection intervals.
+   * @return the delay until the next collection interval.
    */
-  void run()
+  std::chrono::microseconds run()
   {
-    if (!running_.exchange(true))
-    {
-      while (active_.load())
-      {
-        tick();
-        std::this_thread::sleep_for(std::chrono::microseconds(period_));
-      }
-      running_.exchange(false);
-    }
+    tick();
+    return std::chrono::microseconds(period_);
   }
 
   /*
@@ -129,10 +130,10 @@ class PushController
   nostd::shared_ptr<metrics_api::Meter> meter_;
   nostd::unique_ptr<MetricsExporter> exporter_;
   nostd::shared_ptr<MetricsProcessor> processor_;
-  std::thread runner_;
+  std::shared_ptr<sdk::common::Executor> executor_;
+  std::unique_ptr<sdk::common::ScheduledTask> runner_;
   std::mutex mu_;
-  std::atomic<bool> active_  = ATOMIC_VAR_INIT(false);
-  std::atomic<bool> running_ = ATOMIC_VAR_INIT(false);
+  std::atomic<bool> active_ = ATOMIC_VAR_INIT(false);
   unsigned int period_;
   unsigned int timeout_;
 };
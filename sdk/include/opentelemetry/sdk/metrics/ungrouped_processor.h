@@ -62,7 +62,14 @@ struct KeyStruct_Hash
 class UngroupedMetricsProcessor : public MetricsProcessor
 {
 public:
-  explicit UngroupedMetricsProcessor(bool stateful);
+  /**
+   * @param stateful whether aggregators are kept across collections.
+   * @param clock the clock for the timestamps of gauge aggregators created by
+   * this processor.
+   */
+  explicit UngroupedMetricsProcessor(bool stateful,
+                                     std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+                                         opentelemetry::sdk::common::SystemClock::GetInstance());
 
   std::vector<sdkmetrics::Record> CheckpointSelf() noexcept override;
 
@@ -72,6 +79,7 @@ class UngroupedMetricsProcessor : public MetricsProcessor
 
 private:
   bool stateful_;
+  std::shared_ptr<opentelemetry::sdk::common::Clock> clock_;
   std::unordered_map<KeyStruct, sdkmetrics::AggregatorVariant, KeyStruct_Hash> batch_map_;
 
   /**
@@ -128,7 +136,7 @@ class UngroupedMetricsProcessor : public MetricsProcessor
 
       case sdkmetrics::AggregatorKind::Gauge:
         return std::shared_ptr<sdkmetrics::Aggregator<T>>(
-            new sdkmetrics::GaugeAggregator<T>(ins_kind));
+            new sdkmetrics::GaugeAggregator<T>(ins_kind, clock_));
 
       case sdkmetrics::AggregatorKind::Sketch:
         return std::shared_ptr<sdkmetrics::Aggregator<T>>(new sdkmetrics::SketchAggregator<T>(
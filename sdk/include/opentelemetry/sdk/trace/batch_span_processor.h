@@ -1,12 +1,18 @@
 #pragma once
 
-#include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/sdk/common/batch_queue.h"
+#include "opentelemetry/sdk/common/deadline.h"
+#include "opentelemetry/sdk/common/executor.h"
+#include "opentelemetry/sdk/common/retry_buffer.h"
 #include "opentelemetry/sdk/trace/exporter.h"
 #include "opentelemetry/sdk/trace/processor.h"
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <thread>
+#include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -34,6 +40,73 @@ struct BatchSpanProcessorOptions
    * equal to max_queue_size.
    */
   size_t max_export_batch_size = 512;
+
+  /**
+   * The number of shards the queue is split into. Every thread adds its ended
+   * spans to one shard, which reduces contention between threads ending spans
+   * concurrently. The shards share max_queue_size equally, and are drained
+   * round-robin into export batches. With more than one shard, spans ended by
+   * different threads may be exported in a different order than they ended.
+   * Zero selects one shard per hardware thread.
+   */
+  size_t num_queue_shards = 1;
+
+  /* What to do with a span ending while the queue is full. */
+  common::OverflowPolicy overflow_policy = common::OverflowPolicy::kDropNewest;
+
+  /**
+   * How long OnEnd waits for room in the queue with OverflowPolicy::kBlock,
+   * before dropping the span.
+   */
+  std::chrono::milliseconds max_block_time = std::chrono::milliseconds(1000);
+
+  /**
+   * The priority of a span for OverflowPolicy::kDropLowestPriority, where
+   * spans with lower values are dropped first. If empty, spans with an error
+   * status have priority 1 and other spans 0. This only works if the exporter
+   * makes SpanData recordables; for other recordables, the priority must be
+   * provided.
+   */
+  std::function<int(const Recordable &)> priority;
+
+  /**
+   * The memory budget of the queue, in bytes estimated by
+   * Recordable::GetEstimatedSize. A span which does not fit into the budget is
+   * handled as if the queue were full; with OverflowPolicy::kDropOldest, only
+   * spans queued by the same thread are dropped to make room. Zero means no
+   * budget.
+   */
+  size_t max_queue_size_bytes = 0;
+
+  /**
+   * The maximum estimated size in bytes of every export, in addition to
+   * max_export_batch_size. A larger span is exported alone. Zero means no
+   * limit.
+   */
+  size_t max_export_batch_size_bytes = 0;
+
+  /**
+   * The executor to run the background work on, which may be shared with
+   * other processors. If empty, the processor creates an executor of its own
+   * with one thread.
+   */
+  std::shared_ptr<common::Executor> executor;
+
+  /**
+   * The maximum number of export batches in flight. With more than one, as
+   * many export threads call the exporter concurrently, while the worker
+   * task keeps filling batches from the queue. The exporter must then allow
+   * concurrent calls to Export, and batches may complete out of order.
+   */
+  size_t max_concurrent_exports = 1;
+
+  /**
+   * How batches are retried when the exporter fails with
+   * ExportResult::kFailureRetryable. Retries run on the worker task after
+   * their backoff, right away on ForceFlush, and on Shutdown until the timeout
+   * expires.
+   */
+  common::RetryOptions retry_options;
 };
 
 /**
@@ -81,7 +154,11 @@ class BatchSpanProcessor : public SpanProcessor
   /**
    * Export all ended spans that have not been exported yet.
    *
-   * NOTE: Timeout functionality not supported yet.
+   * Blocks until the worker task has exported all the spans queued before
+   * the call, or until the timeout expires.
+   *
+   * @return true if all the spans were exported in time, and none of them
+   * waits for a retry after a retryable export failure
    */
   bool ForceFlush(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
@@ -91,7 +168,13 @@ class BatchSpanProcessor : public SpanProcessor
    * all its ended spans and passes them to the exporter. Any subsequent calls to OnStart, OnEnd,
    * ForceFlush or Shutdown will return immediately without doing anything.
    *
-   * NOTE: Timeout functionality not supported yet.
+   * The queue is drained until the timeout expires, and the remaining spans are
+   * discarded. The exporter is shut down with the time left. An export still
+   * running when the timeout expires is abandoned; the destructor then waits for
+   * it, and shuts the exporter down.
+   *
+   * @return false if the queue was not drained in time, or if the exporter failed
+   * to shut down
    */
   bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
@@ -104,11 +187,49 @@ class BatchSpanProcessor : public SpanProcessor
    */
   ~BatchSpanProcessor();
 
+  /**
+   * @return the number of ended spans added to the queue and not dropped later to
+   * make room for other spans. Every ended span is either accepted or dropped.
+   */
+  uint64_t GetAcceptedCount() const noexcept { return buffer_.accepted_count(); }
+
+  /**
+   * @return the number of ended spans dropped because the queue was full.
+   */
+  uint64_t GetDroppedCount() const noexcept { return buffer_.dropped_count(); }
+
+  /**
+   * @return the number of spans dropped after a retryable export failure,
+   * because they had no attempts left or the retry buffer was full.
+   */
+  uint64_t GetRetryDroppedCount() const noexcept { return retry_buffer_.dropped_count(); }
+
+  /**
+   * @return the number of ended spans in the queue.
+   */
+  size_t GetQueueSize() const noexcept { return buffer_.size(); }
+
+  /**
+   * @return the maximum number of ended spans in the queue.
+   */
+  size_t GetMaxQueueSize() const noexcept { return max_queue_size_; }
+
+  /**
+   * @return how long the last call to the exporter took.
+   */
+  std::chrono::microseconds GetExportLatency() const noexcept
+  {
+    return std::chrono::microseconds(export_latency_.load(std::memory_order_relaxed));
+  }
+
 private:
   /**
-   * The background routine performed by the worker thread.
+   * The background routine performed by the worker task, on every scheduled
+   * delay or when woken up.
+   *
+   * @return the delay until the next run
    */
-  void DoBackgroundWork();
+  common::Executor::Clock::duration DoBackgroundWork();
 
   /**
    * Exports all ended spans to the configured exporter.
@@ -121,10 +242,56 @@ class BatchSpanProcessor : public SpanProcessor
   void Export(const bool was_for_flush_called);
 
   /**
-   * Called when Shutdown() is invoked. Completely drains the queue of all its ended spans and
-   * passes them to the exporter.
+   * Passes a batch to the exporter, or to an export thread if batches are
+   * exported concurrently. Waits while max_concurrent_exports batches are in
+   * flight.
+   * @param attempts the number of export attempts of the batch so far
+   */
+  void ExportBatch(nostd::span<std::unique_ptr<Recordable>> batch, size_t attempts = 0);
+
+  /**
+   * Passes a batch to the exporter, and adds it to the retry buffer if the
+   * export failed with ExportResult::kFailureRetryable.
+   * @param attempts the number of export attempts of the batch so far
+   */
+  void ExportOrRetry(nostd::span<std::unique_ptr<Recordable>> batch, size_t attempts);
+
+  /**
+   * Exports the batches of the retry buffer whose backoff expired by the
+   * given time again, as ExportBatch does.
+   */
+  void Retry(common::Executor::Clock::time_point time);
+
+  /**
+   * @return the given delay of the worker task, shortened to the next retry.
+   */
+  common::Executor::Clock::duration GetNextDelay(common::Executor::Clock::duration delay) const;
+
+  /**
+   * Waits until all the batches passed to export threads are exported.
+   */
+  void WaitForExports();
+
+  /**
+   * The routine performed by the export threads.
+   */
+  void DoExportWork();
+
+  /**
+   * Called when Shutdown() is invoked. Drains the queue, passing its spans to
+   * the exporter, and retries the failed batches that are due.
+   * @return the delay until the next retry, or the maximum duration if no retry
+   * is due before the shutdown deadline
+   */
+  common::Executor::Clock::duration DrainQueue();
+
+  /**
+   * Marks the flushes up to the given sequence number as completed, and wakes
+   * up the threads waiting for them.
+   * @param succeeded whether all the spans were exported, without any
+   * waiting for a retry
    */
-  void DrainQueue();
+  void CompleteFlush(uint64_t flush_sequence, bool succeeded);
 
   /* The configured backend exporter */
   std::unique_ptr<SpanExporter> exporter_;
@@ -133,21 +300,61 @@ class BatchSpanProcessor : public SpanProcessor
   const size_t max_queue_size_;
   const std::chrono::milliseconds schedule_delay_millis_;
   const size_t max_export_batch_size_;
+  const size_t max_export_batch_size_bytes_;
 
   /* Synchronization primitives */
-  std::condition_variable cv_, force_flush_cv_;
-  std::mutex cv_m_, force_flush_cv_m_;
+  std::condition_variable force_flush_cv_;
+  std::mutex cv_m_;
+
+  /**
+   * The sequence numbers of the last flush requested and of the last flush
+   * completed by the worker task, guarded by cv_m_. Every flush exports all
+   * the spans queued before it was requested, and
+   * succeeded if it, or a later flush, was the last flush that completed
+   * without spans waiting for a retry.
+   */
+  uint64_t flush_requested_ = 0;
+  uint64_t flush_completed_ = 0;
+  uint64_t flush_succeeded_ = 0;
+
+  /* The deadline to drain the queue by, set before is_shutdown_ */
+  common::Deadline shutdown_deadline_{(std::chrono::microseconds::max)()};
 
   /* The buffer/queue to which the ended spans are added */
-  common::CircularBuffer<Recordable> buffer_;
+  common::BatchQueue<Recordable> buffer_;
 
   /* Important boolean flags to handle the workflow of the processor */
   std::atomic<bool> is_shutdown_{false};
-  std::atomic<bool> is_force_flush_{false};
-  std::atomic<bool> is_force_flush_notified_{false};
 
-  /* The background worker thread */
-  std::thread worker_thread_;
+  /* The batches waiting to be exported again after a retryable failure */
+  common::RetryBuffer<Recordable> retry_buffer_;
+
+  /* How long the last call to the exporter took, in microseconds */
+  std::atomic<int64_t> export_latency_{0};
+
+  /* A batch waiting for an export thread, and its number of export attempts so far */
+  struct PendingBatch
+  {
+    std::vector<std::unique_ptr<Recordable>> spans;
+    size_t attempts = 0;
+  };
+
+  /* The batches waiting for an export thread, and the number of batches not exported yet */
+  const size_t max_concurrent_exports_;
+  std::deque<PendingBatch> pending_batches_;
+  size_t num_in_flight_      = 0;
+  size_t num_export_threads_ = 0;
+  bool is_export_stopped_    = false;
+  std::mutex export_m_;
+  std::condition_variable export_cv_;
+  std::vector<std::thread> export_threads_;
+
+  /* Whether Shutdown returned at its deadline while the worker task or an export was running */
+  bool is_work_abandoned_ = false;
+
+  /* The executor and the background worker task running on it */
+  std::shared_ptr<common::Executor> executor_;
+  std::unique_ptr<common::ScheduledTask> worker_;
 };
 
 }  // namespace trace
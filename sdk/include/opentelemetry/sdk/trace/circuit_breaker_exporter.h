@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "opentelemetry/sdk/common/circuit_breaker.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A span exporter which passes batches to another exporter through a circuit
+ * breaker. After consecutive failed exports, the circuit opens and batches are
+ * rejected before the exporter serializes them, until a probe export after the
+ * open duration succeeds.
+ *
+ * Rejected batches either fail with ExportResult::kFailureRetryable, so that a
+ * batch processor keeps them in its retry buffer, or are dropped, depending on
+ * CircuitBreakerOptions::retry_rejected.
+ */
+class CircuitBreakerSpanExporter final : public SpanExporter
+{
+public:
+  /**
+   * @param exporter the exporter to pass the batches to
+   * @param options the circuit breaker options
+   */
+  CircuitBreakerSpanExporter(std::unique_ptr<SpanExporter> &&exporter,
+                             const common::CircuitBreakerOptions &options);
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<Recordable>> &spans) noexcept override;
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * @return the current state of the circuit.
+   */
+  common::CircuitState GetState() const noexcept { return circuit_breaker_.state(); }
+
+  /**
+   * @return the number of batches rejected while the circuit was open.
+   */
+  uint64_t GetRejectedCount() const noexcept { return circuit_breaker_.rejected_count(); }
+
+private:
+  std::unique_ptr<SpanExporter> exporter_;
+  common::CircuitBreaker circuit_breaker_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "opentelemetry/nostd/span.h"
+#include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/common/exporter_utils.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 
@@ -47,6 +49,31 @@ class SpanExporter
   virtual bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept = 0;
 };
+
+/**
+ * A span exporter which can encode a batch into its wire format separately
+ * from sending it, so that an encoded batch can be stored, for example by a
+ * SpoolingSpanExporter, and sent later without serializing it again.
+ */
+class EncodingSpanExporter : public SpanExporter
+{
+public:
+  /**
+   * Encodes a batch of span recordables, taking them from the batch.
+   * @param spans a span of unique pointers to span recordables
+   * @param data the encoded batch
+   * @return true if the batch was encoded
+   */
+  virtual bool Encode(const nostd::span<std::unique_ptr<Recordable>> &spans,
+                      std::string *data) noexcept = 0;
+
+  /**
+   * Sends a batch encoded by Encode. This method must not be called
+   * concurrently with itself or Export for the same exporter instance.
+   * @param data the encoded batch
+   */
+  virtual sdk::common::ExportResult ExportEncoded(nostd::string_view data) noexcept = 0;
+};
 }  // namespace trace
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "opentelemetry/trace/span_id.h"
+#include "opentelemetry/trace/trace_id.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace trace_api = opentelemetry::trace;
+
+/**
+ * IdGenerator generates the trace and span ids of new spans. It is called
+ * concurrently by all threads creating spans, so implementations must be
+ * thread-safe and should avoid contention.
+ *
+ * A custom generator can be used to embed information into the ids, e.g. to
+ * prefix trace ids with a timestamp.
+ */
+class IdGenerator
+{
+public:
+  virtual ~IdGenerator() = default;
+
+  /**
+   * Generate a span id.
+   * @return a valid (non-zero) span id
+   */
+  virtual trace_api::SpanId GenerateSpanId() noexcept = 0;
+
+  /**
+   * Generate a trace id.
+   * @return a valid (non-zero) trace id
+   */
+  virtual trace_api::TraceId GenerateTraceId() noexcept = 0;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
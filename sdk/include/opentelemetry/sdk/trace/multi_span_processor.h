@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "opentelemetry/sdk/trace/processor.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+class SpanData;
+
+/**
+ * The multi span processor passes spans to several span processors, for
+ * example to zPages and to a batch span processor exporting the spans.
+ *
+ * Each span is recorded only once, into a SpanData: the recordable returned
+ * by MakeRecordable is passed to the OnStart of every processor, and once the
+ * span ends, every processor receives a SharedSpanData in OnEnd, all of which
+ * refer to the same span data. The MakeRecordable methods of the composed
+ * processors are never called, so they, and their exporters, must accept a
+ * SharedSpanData in OnEnd.
+ */
+class MultiSpanProcessor : public SpanProcessor
+{
+public:
+  /**
+   * Initialize a multi span processor.
+   * @param processors the span processors to pass spans to, which must not
+   * contain a nullptr.
+   */
+  explicit MultiSpanProcessor(std::vector<std::shared_ptr<SpanProcessor>> processors) noexcept;
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  void OnStart(Recordable &span,
+               const opentelemetry::trace::SpanContext &parent_context) noexcept override;
+
+  void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override;
+
+  /**
+   * Force flush all processors. The timeout applies to all processors
+   * together.
+   */
+  bool ForceFlush(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Shut down all processors. The timeout applies to all processors together.
+   */
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Get the span data a recordable made by a MultiSpanProcessor records the span
+   * into. The span data is modified while the span is running, so it may only
+   * be read in OnStart; once the span has ended, it is shared in OnEnd.
+   * @param recordable the recordable passed to OnStart
+   * @return the span data, or nullptr if the recordable was not made by a
+   * MultiSpanProcessor
+   */
+  static const SpanData *GetSpanData(const Recordable &recordable) noexcept;
+
+private:
+  const std::vector<std::shared_ptr<SpanProcessor>> processors_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
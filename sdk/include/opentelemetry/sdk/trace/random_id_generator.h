@@ -0,0 +1,26 @@
+#pragma once
+
+#include "opentelemetry/sdk/trace/id_generator.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The default id generator, generating random trace and span ids.
+ *
+ * Random numbers are taken from a block pre-generated for each thread, so
+ * generating an id does not need any synchronization. The block is discarded
+ * after fork, so that child processes do not reuse ids of their parent.
+ */
+class RandomIdGenerator : public IdGenerator
+{
+public:
+  trace_api::SpanId GenerateSpanId() noexcept override;
+
+  trace_api::TraceId GenerateTraceId() noexcept override;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -5,6 +5,7 @@
 #include "opentelemetry/core/timestamp.h"
 #include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/common/empty_attributes.h"
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #include "opentelemetry/trace/canonical_code.h"
 #include "opentelemetry/trace/span.h"
 #include "opentelemetry/trace/span_context.h"
@@ -94,6 +95,50 @@ class Recordable
     AddLink(span_context, opentelemetry::sdk::GetEmptyAttributes());
   }
 
+  /**
+   * Add an event to a span, some of whose attributes were dropped because of the
+   * span limits. Recordables which do not record dropped counts can rely on the
+   * default implementation.
+   * @param name the name of the event
+   * @param timestamp the timestamp of the event
+   * @param attributes the attributes associated with the event
+   * @param dropped_attributes_count the number of attributes dropped from the event
+   */
+  virtual void AddEvent(nostd::string_view name,
+                        core::SystemTimestamp timestamp,
+                        const opentelemetry::common::KeyValueIterable &attributes,
+                        uint32_t /*dropped_attributes_count*/) noexcept
+  {
+    AddEvent(name, timestamp, attributes);
+  }
+
+  /**
+   * Add a link to a span, some of whose attributes were dropped because of the
+   * span limits. Recordables which do not record dropped counts can rely on the
+   * default implementation.
+   * @param span_context the span context of the linked span
+   * @param attributes the attributes associated with the link
+   * @param dropped_attributes_count the number of attributes dropped from the link
+   */
+  virtual void AddLink(const opentelemetry::trace::SpanContext &span_context,
+                       const opentelemetry::common::KeyValueIterable &attributes,
+                       uint32_t /*dropped_attributes_count*/) noexcept
+  {
+    AddLink(span_context, attributes);
+  }
+
+  /**
+   * Set the number of attributes, events and links dropped from the span because
+   * of the span limits. This is only called if any were dropped.
+   * @param dropped_attributes_count the number of dropped attributes
+   * @param dropped_events_count the number of dropped events
+   * @param dropped_links_count the number of dropped links
+   */
+  virtual void SetDroppedCounts(uint32_t /*dropped_attributes_count*/,
+                                uint32_t /*dropped_events_count*/,
+                                uint32_t /*dropped_links_count*/) noexcept
+  {}
+
   /**
    * Set the status of the span.
    * @param code the status code
@@ -125,6 +170,44 @@ class Recordable
    * @param duration the duration to set
    */
   virtual void SetDuration(std::chrono::nanoseconds duration) noexcept = 0;
+
+  /**
+   * Set the instrumentation library of the span. The instrumentation library is
+   * shared with the tracer that created the span, so recordables may keep a
+   * reference to it for as long as they exist. Recordables which do not export
+   * the instrumentation library can rely on the default implementation.
+   * @param instrumentation_library the instrumentation library to set
+   */
+  virtual void SetInstrumentationLibrary(
+      const std::shared_ptr<
+          const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+          & /*instrumentation_library*/) noexcept
+  {}
+
+  /**
+   * Estimate the size of the span once encoded for export, which batch span
+   * processors use to bound the memory used by their queue and the size of
+   * export requests. Recordables which cannot estimate their size can rely on
+   * the default implementation, and then only count towards item limits.
+   * @return the approximate encoded size of the span in bytes, or 0 if unknown
+   */
+  virtual size_t GetEstimatedSize() const noexcept { return 0; }
+
+  /**
+   * Look up the attributes set so far, so that spans can enforce the attribute
+   * count limit without keeping a copy of every key. Recordables which do not
+   * keep their attributes can rely on the default implementation.
+   * @param key the attribute key to look up
+   * @param num_attributes set to the number of distinct attribute keys set
+   * @param has_key set to whether an attribute with the key is set
+   * @return true if the attributes were looked up, false if not supported
+   */
+  virtual bool LookUpAttribute(nostd::string_view /*key*/,
+                               size_t * /*num_attributes*/,
+                               bool * /*has_key*/) const noexcept
+  {
+    return false;
+  }
 };
 }  // namespace trace
 }  // namespace sdk
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A process-wide pool of recycled recordables of type T.
+ *
+ * Exporters hand drained recordables back with Release() once a batch has been
+ * exported, and their MakeRecordable() implementations obtain them again with
+ * Acquire(). Every thread keeps a small free list that is accessed without any
+ * synchronization. Recordables migrate between threads (typically from the
+ * export thread back to the threads creating spans) in batches of kBatchSize
+ * through a shared free list, so its lock is taken at most once per batch.
+ *
+ * T must be default constructible and provide a `void Reset() noexcept` method
+ * which restores its initial state while keeping the capacity of its internal
+ * buffers.
+ */
+template <class T>
+class RecordablePool
+{
+public:
+  /* The number of recordables moved between a thread and the shared free list at once. */
+  static constexpr size_t kBatchSize = 64;
+
+  /* The maximum number of recordables retained in the shared free list. */
+  static constexpr size_t kMaxSharedSize = 4096;
+
+  /**
+   * Obtain a recordable, either recycled or newly allocated.
+   * @return a recordable in its initial state, or nullptr if allocation failed
+   */
+  static std::unique_ptr<T> Acquire() noexcept
+  {
+    auto &local = GetLocalFreeList();
+    if (local.empty())
+    {
+      GetSharedFreeList().TakeBatch(local);
+      if (local.empty())
+      {
+        return std::unique_ptr<T>(new (std::nothrow) T);
+      }
+    }
+    std::unique_ptr<T> recordable = std::move(local.back());
+    local.pop_back();
+    return recordable;
+  }
+
+  /**
+   * Return a recordable to the pool so that it can be reused.
+   * @param recordable the recordable to recycle, may be nullptr
+   */
+  static void Release(std::unique_ptr<T> &&recordable) noexcept
+  {
+    if (recordable == nullptr)
+    {
+      return;
+    }
+    recordable->Reset();
+
+    auto &local = GetLocalFreeList();
+    local.push_back(std::move(recordable));
+    if (local.size() >= kLocalCapacity)
+    {
+      GetSharedFreeList().PutBatch(local);
+    }
+  }
+
+private:
+  /* A thread's free list never holds more than kLocalCapacity recordables. */
+  static constexpr size_t kLocalCapacity = 2 * kBatchSize;
+
+  class LocalFreeList
+  {
+  public:
+    LocalFreeList() { recordables.reserve(kLocalCapacity); }
+
+    std::vector<std::unique_ptr<T>> recordables;
+  };
+
+  class SharedFreeList
+  {
+  public:
+    SharedFreeList() { recordables_.reserve(kMaxSharedSize); }
+
+    /**
+     * Move up to kBatchSize recordables into the (empty) thread-local list.
+     */
+    void TakeBatch(std::vector<std::unique_ptr<T>> &local) noexcept
+    {
+      std::lock_guard<opentelemetry::common::SpinLockMutex> guard{lock_};
+      size_t n = recordables_.size() < kBatchSize ? recordables_.size() : kBatchSize;
+      for (size_t i = 0; i < n; ++i)
+      {
+        local.push_back(std::move(recordables_.back()));
+        recordables_.pop_back();
+      }
+    }
+
+    /**
+     * Move kBatchSize recordables out of the (full) thread-local list. Those that
+     * do not fit into the shared list are freed.
+     */
+    void PutBatch(std::vector<std::unique_ptr<T>> &local) noexcept
+    {
+      {
+        std::lock_guard<opentelemetry::common::SpinLockMutex> guard{lock_};
+        for (size_t i = 0; i < kBatchSize && recordables_.size() < kMaxSharedSize; ++i)
+        {
+          recordables_.push_back(std::move(local.back()));
+          local.pop_back();
+        }
+      }
+      // Free the overflow outside of the lock.
+      local.resize(kLocalCapacity - kBatchSize);
+    }
+
+  private:
+    opentelemetry::common::SpinLockMutex lock_;
+    std::vector<std::unique_ptr<T>> recordables_;
+  };
+
+  static std::vector<std::unique_ptr<T>> &GetLocalFreeList() noexcept
+  {
+    static thread_local LocalFreeList free_list;
+    return free_list.recordables;
+  }
+
+  static SharedFreeList &GetSharedFreeList() noexcept
+  {
+    static SharedFreeList free_list;
+    return free_list;
+  }
+};
+
+template <class T>
+constexpr size_t RecordablePool<T>::kBatchSize;
+
+template <class T>
+constexpr size_t RecordablePool<T>::kMaxSharedSize;
+
+template <class T>
+constexpr size_t RecordablePool<T>::kLocalCapacity;
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
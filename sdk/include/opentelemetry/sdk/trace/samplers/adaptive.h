@@ -0,0 +1,173 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/executor.h"
+#include "opentelemetry/sdk/trace/batch_span_processor.h"
+#include "opentelemetry/sdk/trace/sampler.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace trace_api = opentelemetry::trace;
+
+/**
+ * The state of the span pipeline the AdaptiveSampler adjusts to.
+ */
+struct AdaptiveSamplerFeedback
+{
+  /* The number of ended spans accepted by the queue so far. */
+  uint64_t accepted_count = 0;
+
+  /* The number of ended spans dropped because the queue was full so far. */
+  uint64_t dropped_count = 0;
+
+  /* The number of ended spans in the queue, and its maximum. */
+  size_t queue_size     = 0;
+  size_t max_queue_size = 0;
+
+  /* How long the last export took. */
+  std::chrono::microseconds export_latency = std::chrono::microseconds(0);
+};
+
+/**
+ * Struct to hold adaptive sampler options.
+ */
+struct AdaptiveSamplerOptions
+{
+  /* The number of spans per second the pipeline should export. */
+  double target_spans_per_second = 1000;
+
+  /* The interval at which the ratio is adjusted. */
+  std::chrono::milliseconds adjustment_interval = std::chrono::milliseconds(1000);
+
+  /* The ratio sampled before the first adjustment. */
+  double initial_ratio = 1.0;
+
+  /**
+   * The ratio is never adjusted below this value, so that some traces are kept.
+   * Lower values, including 0, are raised to about 1.1e-16, the smallest ratio
+   * still sampling traces.
+   */
+  double min_ratio = 0.0001;
+
+  /**
+   * The fraction of the queue above which the ratio is cut in proportion to the
+   * room left, so that spans stop being recorded before the queue overflows.
+   */
+  double queue_high_watermark = 0.5;
+
+  /**
+   * The export latency above which the ratio is cut in proportion, or 0 to
+   * ignore the export latency.
+   */
+  std::chrono::milliseconds max_export_latency = std::chrono::milliseconds(0);
+
+  /**
+   * The executor to run the adjustments on, which may be shared with other
+   * components. If empty, the sampler creates an executor of its own with one
+   * thread.
+   */
+  std::shared_ptr<common::Executor> executor;
+};
+
+/**
+ * The Adaptive sampler samples a ratio of the traces, which it adjusts at a
+ * fixed interval from the feedback of the span pipeline: the ratio moves
+ * towards the target number of spans per second, and is cut when the queue
+ * fills up, spans are dropped, or exports slow down. Wrapped in a
+ * ParentBasedSampler, it decides for root spans, and so for whole traces.
+ *
+ * Traces are sampled consistently by the randomness of their trace id, as in
+ * the OpenTelemetry probability sampling specification, and the sampling
+ * threshold is recorded in the "ot" entry of the TraceState of sampled spans,
+ * e.g. ot=th:c, so that backends can weight the spans by the inverse of the
+ * effective probability.
+ */
+class AdaptiveSampler : public Sampler
+{
+public:
+  using FeedbackSource = std::function<AdaptiveSamplerFeedback()>;
+
+  /**
+   * @param feedback_source returns the current state of the span pipeline
+   * @param options the adaptive sampler options
+   */
+  AdaptiveSampler(FeedbackSource feedback_source, const AdaptiveSamplerOptions &options);
+
+  /**
+   * @param processor the batch span processor of the spans sampled
+   * @param options the adaptive sampler options
+   */
+  AdaptiveSampler(std::shared_ptr<BatchSpanProcessor> processor,
+                  const AdaptiveSamplerOptions &options);
+
+  /**
+   * @return Returns RECORD_AND_SAMPLE with the sampling threshold in the
+   * TraceState if the trace_id falls into the current ratio, and DROP
+   * otherwise.
+   */
+  SamplingResult ShouldSample(
+      const trace_api::SpanContext &parent_context,
+      trace_api::TraceId trace_id,
+      nostd::string_view /*name*/,
+      trace_api::SpanKind /*span_kind*/,
+      const opentelemetry::common::KeyValueIterable & /*attributes*/,
+      const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept override;
+
+  /**
+   * @return Description MUST be AdaptiveSampler{1000.000000}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+  /**
+   * Adjusts the ratio from the current feedback. This is called at every
+   * adjustment interval.
+   */
+  void Adjust() noexcept;
+
+  /**
+   * @return the current ratio of traces sampled.
+   */
+  double GetRatio() const noexcept;
+
+private:
+  const FeedbackSource feedback_source_;
+  const AdaptiveSamplerOptions options_;
+  std::string description_;
+
+  /**
+   * A sampling threshold, with its value in the "ot" TraceState entry.
+   */
+  struct Threshold
+  {
+    uint64_t value;
+    std::string encoded;
+  };
+
+  // Traces whose randomness is at least this threshold are sampled. It is
+  // replaced as a whole, so that the value and its encoding always match.
+  common::AtomicSharedPtr<const Threshold> threshold_;
+
+  // The feedback and the time of the last adjustment, guarded by adjust_mutex_.
+  AdaptiveSamplerFeedback last_feedback_;
+  common::Executor::Clock::time_point last_time_;
+  std::mutex adjust_mutex_;
+
+  /* The executor and the adjustment task running on it */
+  std::shared_ptr<common::Executor> executor_;
+  std::unique_ptr<common::ScheduledTask> worker_;
+
+  static std::shared_ptr<const Threshold> MakeThreshold(uint64_t value) noexcept;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "opentelemetry/sdk/trace/sampler.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace trace_api = opentelemetry::trace;
+/**
+ * The RateLimiting sampler samples at most a given number of spans per second,
+ * independent of the number of spans started. Wrapped in a ParentBasedSampler,
+ * it limits the number of sampled root spans, and so of sampled traces.
+ *
+ * The budget is held in a token bucket, which is split into one bucket per
+ * shard so that threads sampling concurrently do not contend: a thread takes
+ * tokens from the bucket of its shard, and only refills it from the shared
+ * bucket once it is empty. Every 100 milliseconds, the tokens left in the
+ * shards are returned to the shared bucket, so that the budget of idle threads
+ * goes to busy ones.
+ */
+class RateLimitingSampler : public Sampler
+{
+public:
+  /**
+   * @param max_spans_per_second the maximum number of spans sampled per second,
+   * which is also the largest burst sampled at once
+   * @param num_shards the number of buckets the budget is split into, or 0 for
+   * one per hardware thread
+   */
+  explicit RateLimitingSampler(double max_spans_per_second, size_t num_shards = 0);
+
+  ~RateLimitingSampler() override;
+
+  /**
+   * @return Returns RECORD_AND_SAMPLE if the budget of the current second is
+   * not used up, and DROP otherwise.
+   */
+  SamplingResult ShouldSample(
+      const trace_api::SpanContext & /*parent_context*/,
+      trace_api::TraceId /*trace_id*/,
+      nostd::string_view /*name*/,
+      trace_api::SpanKind /*span_kind*/,
+      const opentelemetry::common::KeyValueIterable & /*attributes*/,
+      const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept override;
+
+  /**
+   * @return Description MUST be RateLimitingSampler{100.000000}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+private:
+  struct Shard;
+
+  /**
+   * Refills the bucket of a shard from the shared bucket, and takes a token.
+   * @return false if the shared bucket is empty
+   */
+  bool RefillAndAcquire(Shard &shard) noexcept;
+
+  /**
+   * Adds the tokens accrued since the last rebalancing to the shared bucket,
+   * and returns the tokens left in the shards to it, unless the last
+   * rebalancing is too recent or another thread is rebalancing.
+   */
+  void Rebalance(int64_t now) noexcept;
+
+  std::string description_;
+  // Tokens are counted in fractions, so that low rates accrue tokens steadily.
+  const double tokens_per_nanosecond_;
+  const int64_t capacity_;
+  const int64_t batch_size_;
+  const size_t num_shards_;
+  // The shards are aligned to cache lines within their storage.
+  std::unique_ptr<char[]> shard_storage_;
+  Shard *shards_;
+
+  std::atomic<int64_t> pool_;
+  std::atomic<int64_t> last_rebalance_time_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/executor.h"
+#include "opentelemetry/sdk/trace/sampler.h"
+#include "opentelemetry/trace/span.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace trace_api = opentelemetry::trace;
+
+/**
+ * A rule of a RuleBasedSampler, which samples a ratio of the spans matching
+ * all of its conditions. Empty conditions match all spans.
+ */
+struct SamplingRule
+{
+  /* The exact name of the span. */
+  std::string name;
+
+  /* A prefix of the name of the span. */
+  std::string name_prefix;
+
+  /* The kind of the span, if has_span_kind is set. */
+  bool has_span_kind            = false;
+  trace_api::SpanKind span_kind = trace_api::SpanKind::kInternal;
+
+  /**
+   * Attribute keys and the values they must have. String, boolean and integer
+   * attributes are compared by their text, e.g. "true" or "200".
+   */
+  std::vector<std::pair<std::string, std::string>> attributes;
+
+  /* The ratio of the matching spans sampled, by trace id. */
+  double ratio = 1.0;
+};
+
+/**
+ * The RuleBased sampler samples spans by the first of its rules they match,
+ * by name, kind and attribute values, e.g. all spans named /checkout, and
+ * 0.1% of the spans whose name starts with /health.
+ *
+ * The rules are compiled into a decision table: rules by exact name are found
+ * by a hash lookup, and rules by name prefix through a trie, so that only the
+ * rules which may match a span are evaluated, and only the attributes they
+ * reference are compared. The matching rule samples by trace id like a
+ * TraceIdRatioBasedSampler. Spans matching no rule are sampled by a default
+ * ratio.
+ *
+ * The rules may be loaded from a file, one rule per line, with the conditions
+ * and the ratio as whitespace separated key=value pairs. Values containing
+ * whitespace are enclosed in double quotes. Empty lines and lines starting
+ * with # are ignored:
+ *
+ *   # The first matching rule applies.
+ *   name=/checkout ratio=1
+ *   name_prefix=/health ratio=0.001
+ *   kind=server attribute.http.method=POST ratio=0.5
+ *   name="GET /search" ratio=0.1
+ *
+ * The file is checked for changes at an interval, and the rules are replaced
+ * without restarting the process.
+ */
+class RuleBasedSampler : public Sampler
+{
+public:
+  /**
+   * @param rules the rules, the first matching of which applies to a span
+   * @param default_ratio the ratio of spans sampled which match no rule
+   */
+  explicit RuleBasedSampler(std::vector<SamplingRule> rules, double default_ratio = 1.0);
+
+  /**
+   * Loads the rules from a file, and reloads them whenever the file changed.
+   * If the file cannot be read or parsed, no rules apply until it can.
+   *
+   * @param path the path of the rules file
+   * @param default_ratio the ratio of spans sampled which match no rule
+   * @param reload_interval the interval at which the file is checked for changes
+   * @param executor the executor to check the file on, or empty for an executor
+   * of its own with one thread
+   */
+  RuleBasedSampler(std::string path,
+                   double default_ratio,
+                   std::chrono::milliseconds reload_interval,
+                   std::shared_ptr<common::Executor> executor = nullptr);
+
+  ~RuleBasedSampler() override;
+
+  /**
+   * @return Returns the decision of the first rule matching the span, or of
+   * the default ratio if none matches.
+   */
+  SamplingResult ShouldSample(
+      const trace_api::SpanContext &parent_context,
+      trace_api::TraceId trace_id,
+      nostd::string_view name,
+      trace_api::SpanKind span_kind,
+      const opentelemetry::common::KeyValueIterable &attributes,
+      const trace_api::SpanContextKeyValueIterable &links) noexcept override;
+
+  /**
+   * @return Description MUST be RuleBasedSampler
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+  /**
+   * Replaces the rules. Spans sampled concurrently use either the old or the
+   * new rules.
+   */
+  void SetRules(std::vector<SamplingRule> rules);
+
+  /**
+   * Reads the rules file, and replaces the rules if it changed since the last
+   * call. This is called at every reload interval.
+   *
+   * @return false if the file could not be read or parsed, in which case the
+   * rules are kept.
+   */
+  bool Reload() noexcept;
+
+  /**
+   * Parses rules in the format of a rules file.
+   *
+   * @param text the content of the rules file
+   * @param rules the vector to append the parsed rules to
+   * @param error set to the reason if the text could not be parsed
+   * @return false if the text could not be parsed
+   */
+  static bool ParseRules(nostd::string_view text,
+                         std::vector<SamplingRule> &rules,
+                         std::string &error);
+
+private:
+  class DecisionTable;
+
+  const double default_ratio_;
+  common::AtomicSharedPtr<const DecisionTable> table_;
+
+  const std::string path_;
+  // The content of the rules file when last read, guarded by reload_mutex_.
+  std::string content_;
+  std::mutex reload_mutex_;
+
+  /* The executor and the reload task running on it */
+  std::shared_ptr<common::Executor> executor_;
+  std::unique_ptr<common::ScheduledTask> worker_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
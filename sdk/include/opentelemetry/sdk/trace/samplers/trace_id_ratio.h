@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
 #include "opentelemetry/sdk/trace/sampler.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -38,13 +43,21 @@ class TraceIdRatioBasedSampler : public Sampler
       const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept override;
 
   /**
-   * @return Description MUST be TraceIdRatioBasedSampler{0.000100}
+   * @return Description MUST be TraceIdRatioBasedSampler{0.000100}. The view
+   * is valid until the ratio is changed; a caller viewing it while SetRatio may
+   * be called must hold a common::EpochGuard.
    */
   nostd::string_view GetDescription() const noexcept override;
 
+  /**
+   * Changes the ratio of the sampler while spans are sampled, e.g. to lower it
+   * during an incident. Ratios out of bounds [0.0, 1.0] are clamped.
+   */
+  void SetRatio(double ratio) noexcept;
+
 private:
-  std::string description_;
-  const uint64_t threshold_;
+  std::atomic<uint64_t> threshold_;
+  common::AtomicSharedPtr<const std::string> description_;
 };
 }  // namespace trace
 }  // namespace sdk
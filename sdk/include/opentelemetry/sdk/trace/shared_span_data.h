@@ -0,0 +1,107 @@
+#pragma once
+
+#include <memory>
+
+#include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A read-only, reference counted view of the SpanData of an ended span.
+ *
+ * A MultiSpanProcessor records each span once, and passes every processor it
+ * composes a SharedSpanData referring to the same SpanData. The span data is
+ * released once the last view is destroyed.
+ *
+ * The span has ended when it is shared, so all setters are no-ops. Exporters
+ * reading SpanData can use GetSpanData() directly, while exporters with a
+ * recordable of their own can convert the span with CopyTo().
+ */
+class SharedSpanData final : public Recordable
+{
+public:
+  /**
+   * @param span_data the span data to share, must not be nullptr
+   */
+  explicit SharedSpanData(std::shared_ptr<const SpanData> span_data) noexcept
+      : span_data_{std::move(span_data)}
+  {}
+
+  /**
+   * Get the shared span data
+   * @return the span data
+   */
+  const SpanData &GetSpanData() const noexcept { return *span_data_; }
+
+  /**
+   * Get a reference to the shared span data, which can be kept after this
+   * view is destroyed.
+   * @return the span data
+   */
+  const std::shared_ptr<const SpanData> &GetSharedSpanData() const noexcept { return span_data_; }
+
+  /**
+   * Record the span in another recordable.
+   * @param recordable the recordable to record the span in
+   */
+  void CopyTo(Recordable &recordable) const noexcept;
+
+  /**
+   * Get the span data of a recordable which is either a SpanData or a
+   * SharedSpanData.
+   * @param recordable the recordable
+   * @return the span data, or nullptr if the recordable is of another type
+   */
+  static const SpanData *FromRecordable(const Recordable &recordable) noexcept
+  {
+    auto span_data = dynamic_cast<const SpanData *>(&recordable);
+    if (span_data != nullptr)
+    {
+      return span_data;
+    }
+    auto shared_span_data = dynamic_cast<const SharedSpanData *>(&recordable);
+    return shared_span_data != nullptr ? &shared_span_data->GetSpanData() : nullptr;
+  }
+
+  size_t GetEstimatedSize() const noexcept override { return span_data_->GetEstimatedSize(); }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext & /*span_context*/,
+                   opentelemetry::trace::SpanId /*parent_span_id*/) noexcept override
+  {}
+
+  void SetAttribute(nostd::string_view /*key*/,
+                    const opentelemetry::common::AttributeValue & /*value*/) noexcept override
+  {}
+
+  void AddEvent(nostd::string_view /*name*/,
+                core::SystemTimestamp /*timestamp*/,
+                const opentelemetry::common::KeyValueIterable & /*attributes*/) noexcept override
+  {}
+
+  void AddLink(const opentelemetry::trace::SpanContext & /*span_context*/,
+               const opentelemetry::common::KeyValueIterable & /*attributes*/) noexcept override
+  {}
+
+  void SetStatus(opentelemetry::trace::StatusCode /*code*/,
+                 nostd::string_view /*description*/) noexcept override
+  {}
+
+  void SetName(nostd::string_view /*name*/) noexcept override {}
+
+  void SetSpanKind(opentelemetry::trace::SpanKind /*span_kind*/) noexcept override {}
+
+  void SetStartTime(opentelemetry::core::SystemTimestamp /*start_time*/) noexcept override {}
+
+  void SetDuration(std::chrono::nanoseconds /*duration*/) noexcept override {}
+
+private:
+  const std::shared_ptr<const SpanData> span_data_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
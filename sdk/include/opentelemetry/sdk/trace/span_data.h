@@ -1,12 +1,13 @@
 #pragma once
 
 #include <chrono>
-#include <unordered_map>
 #include <vector>
 #include "opentelemetry/common/attribute_value.h"
 #include "opentelemetry/core/timestamp.h"
 #include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/sdk/common/flat_attribute_map.h"
+#include "opentelemetry/sdk/common/string_intern_table.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/trace/canonical_code.h"
 #include "opentelemetry/trace/span.h"
@@ -20,6 +21,11 @@ namespace sdk
 {
 namespace trace
 {
+/* The number of attributes stored without heap allocation, for spans, events and links. */
+constexpr size_t kSpanAttributesInlineCapacity  = 8;
+constexpr size_t kEventAttributesInlineCapacity = 2;
+constexpr size_t kLinkAttributesInlineCapacity  = 2;
+
 /**
  * Class for storing events in SpanData.
  */
@@ -28,8 +34,12 @@ class SpanDataEvent
 public:
   SpanDataEvent(std::string name,
                 core::SystemTimestamp timestamp,
-                const opentelemetry::common::KeyValueIterable &attributes)
-      : name_(name), timestamp_(timestamp), attribute_map_(attributes)
+                const opentelemetry::common::KeyValueIterable &attributes,
+                uint32_t dropped_attributes_count = 0)
+      : name_(name),
+        timestamp_(timestamp),
+        attribute_map_(attributes),
+        dropped_attributes_count_(dropped_attributes_count)
   {}
 
   /**
@@ -48,15 +58,30 @@ class SpanDataEvent
    * Get the attributes for this event
    * @return the attributes for this event
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
+  common::AttributeView GetAttributes() const noexcept { return attribute_map_.GetAttributes(); }
+
+  /**
+   * Get the number of attributes dropped from this event because of the span limits
+   * @return the number of dropped attributes
+   */
+  uint32_t GetDroppedAttributesCount() const noexcept { return dropped_attributes_count_; }
+
+  /**
+   * Get the approximate size of this event once encoded for export
+   * @return the approximate encoded size in bytes
+   */
+  size_t GetEstimatedSize() const noexcept
   {
-    return attribute_map_.GetAttributes();
+    // The timestamp and the dropped attributes count.
+    constexpr size_t kFixedSize = 16;
+    return kFixedSize + name_.size() + attribute_map_.GetAttributes().GetEstimatedSize();
   }
 
 private:
   std::string name_;
   core::SystemTimestamp timestamp_;
-  common::AttributeMap attribute_map_;
+  common::FlatAttributeMap<kEventAttributesInlineCapacity> attribute_map_;
+  uint32_t dropped_attributes_count_;
 };
 
 /**
@@ -66,18 +91,18 @@ class SpanDataLink
 {
 public:
   SpanDataLink(opentelemetry::trace::SpanContext span_context,
-               const opentelemetry::common::KeyValueIterable &attributes)
-      : span_context_(span_context), attribute_map_(attributes)
+               const opentelemetry::common::KeyValueIterable &attributes,
+               uint32_t dropped_attributes_count = 0)
+      : span_context_(span_context),
+        attribute_map_(attributes),
+        dropped_attributes_count_(dropped_attributes_count)
   {}
 
   /**
    * Get the attributes for this link
    * @return the attributes for this link
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
-  {
-    return attribute_map_.GetAttributes();
-  }
+  common::AttributeView GetAttributes() const noexcept { return attribute_map_.GetAttributes(); }
 
   /**
    * Get the span context for this link
@@ -85,9 +110,27 @@ class SpanDataLink
    */
   const opentelemetry::trace::SpanContext &GetSpanContext() const noexcept { return span_context_; }
 
+  /**
+   * Get the number of attributes dropped from this link because of the span limits
+   * @return the number of dropped attributes
+   */
+  uint32_t GetDroppedAttributesCount() const noexcept { return dropped_attributes_count_; }
+
+  /**
+   * Get the approximate size of this link once encoded for export
+   * @return the approximate encoded size in bytes
+   */
+  size_t GetEstimatedSize() const noexcept
+  {
+    // The trace id, span id and the dropped attributes count.
+    constexpr size_t kFixedSize = 32;
+    return kFixedSize + attribute_map_.GetAttributes().GetEstimatedSize();
+  }
+
 private:
   opentelemetry::trace::SpanContext span_context_;
-  common::AttributeMap attribute_map_;
+  common::FlatAttributeMap<kLinkAttributesInlineCapacity> attribute_map_;
+  uint32_t dropped_attributes_count_;
 };
 
 /**
@@ -124,7 +167,17 @@ class SpanData final : public Recordable
    * Get the name for this span
    * @return the name for this span
    */
-  opentelemetry::nostd::string_view GetName() const noexcept { return name_; }
+  opentelemetry::nostd::string_view GetName() const noexcept
+  {
+    return interned_name_.IsValid() ? interned_name_.GetValue() : nostd::string_view{name_};
+  }
+
+  /**
+   * Get the interned name for this span
+   * @return the interned name for this span, or an invalid handle if the name
+   * could not be interned
+   */
+  common::InternedString GetInternedName() const noexcept { return interned_name_; }
 
   /**
    * Get the kind of this span
@@ -160,10 +213,7 @@ class SpanData final : public Recordable
    * Get the attributes for this span
    * @return the attributes for this span
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
-  {
-    return attribute_map_.GetAttributes();
-  }
+  common::AttributeView GetAttributes() const noexcept { return attribute_map_.GetAttributes(); }
 
   /**
    * Get the events associated with this span
@@ -177,6 +227,47 @@ class SpanData final : public Recordable
    */
   const std::vector<SpanDataLink> &GetLinks() const noexcept { return links_; }
 
+  /**
+   * Get the number of attributes dropped from this span because of the span limits
+   * @return the number of dropped attributes
+   */
+  uint32_t GetDroppedAttributesCount() const noexcept { return dropped_attributes_count_; }
+
+  /**
+   * Get the number of events dropped from this span because of the span limits
+   * @return the number of dropped events
+   */
+  uint32_t GetDroppedEventsCount() const noexcept { return dropped_events_count_; }
+
+  /**
+   * Get the number of links dropped from this span because of the span limits
+   * @return the number of dropped links
+   */
+  uint32_t GetDroppedLinksCount() const noexcept { return dropped_links_count_; }
+
+  /**
+   * Get the instrumentation library of this span
+   * @return the instrumentation library of the tracer that created this span
+   */
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary &
+  GetInstrumentationLibrary() const noexcept
+  {
+    static const auto kEmptyInstrumentationLibrary =
+        opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create("");
+    return instrumentation_library_ != nullptr ? *instrumentation_library_
+                                               : *kEmptyInstrumentationLibrary;
+  }
+
+  /**
+   * Get the instrumentation library of this span, to share it with another span
+   * @return the instrumentation library of this span, or nullptr if none was set
+   */
+  const std::shared_ptr<const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+      &GetSharedInstrumentationLibrary() const noexcept
+  {
+    return instrumentation_library_;
+  }
+
   void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
                    opentelemetry::trace::SpanId parent_span_id) noexcept override
   {
@@ -190,6 +281,15 @@ class SpanData final : public Recordable
     attribute_map_.SetAttribute(key, value);
   }
 
+  bool LookUpAttribute(nostd::string_view key,
+                       size_t *num_attributes,
+                       bool *has_key) const noexcept override
+  {
+    *num_attributes = attribute_map_.size();
+    *has_key        = attribute_map_.count(key) != 0;
+    return true;
+  }
+
   void AddEvent(
       nostd::string_view name,
       core::SystemTimestamp timestamp = core::SystemTimestamp(std::chrono::system_clock::now()),
@@ -201,6 +301,14 @@ class SpanData final : public Recordable
     events_.push_back(event);
   }
 
+  void AddEvent(nostd::string_view name,
+                core::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes,
+                uint32_t dropped_attributes_count) noexcept override
+  {
+    events_.emplace_back(std::string(name), timestamp, attributes, dropped_attributes_count);
+  }
+
   void AddLink(const opentelemetry::trace::SpanContext &span_context,
                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
   {
@@ -208,6 +316,22 @@ class SpanData final : public Recordable
     links_.push_back(link);
   }
 
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes,
+               uint32_t dropped_attributes_count) noexcept override
+  {
+    links_.emplace_back(span_context, attributes, dropped_attributes_count);
+  }
+
+  void SetDroppedCounts(uint32_t dropped_attributes_count,
+                        uint32_t dropped_events_count,
+                        uint32_t dropped_links_count) noexcept override
+  {
+    dropped_attributes_count_ = dropped_attributes_count;
+    dropped_events_count_     = dropped_events_count;
+    dropped_links_count_      = dropped_links_count;
+  }
+
   void SetStatus(opentelemetry::trace::StatusCode code,
                  nostd::string_view description) noexcept override
   {
@@ -217,7 +341,17 @@ class SpanData final : public Recordable
 
   void SetName(nostd::string_view name) noexcept override
   {
-    name_ = std::string(name.data(), name.length());
+    // Span names mostly come from a small set of literals, so intern them rather than copying
+    // them for every span. Names which cannot be interned are copied.
+    interned_name_ = common::StringInternTable::GetInstance().Intern(name);
+    if (interned_name_.IsValid())
+    {
+      name_.clear();
+    }
+    else
+    {
+      name_.assign(name.data(), name.length());
+    }
   }
 
   void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
@@ -232,18 +366,74 @@ class SpanData final : public Recordable
 
   void SetDuration(std::chrono::nanoseconds duration) noexcept override { duration_ = duration; }
 
+  void SetInstrumentationLibrary(
+      const std::shared_ptr<
+          const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+          &instrumentation_library) noexcept override
+  {
+    instrumentation_library_ = instrumentation_library;
+  }
+
+  size_t GetEstimatedSize() const noexcept override
+  {
+    // The trace id, span id, parent span id, timestamps, kind and status code.
+    constexpr size_t kFixedSize = 64;
+
+    size_t size = kFixedSize + GetName().size() + status_desc_.size() +
+                  attribute_map_.GetAttributes().GetEstimatedSize();
+    for (auto &event : events_)
+    {
+      size += event.GetEstimatedSize();
+    }
+    for (auto &link : links_)
+    {
+      size += link.GetEstimatedSize();
+    }
+    return size;
+  }
+
+  /**
+   * Restore the initial state of this span data so that it can be reused for
+   * another span. The capacity of the internal containers is retained.
+   */
+  void Reset() noexcept
+  {
+    span_context_   = opentelemetry::trace::SpanContext{false, false};
+    parent_span_id_ = opentelemetry::trace::SpanId();
+    start_time_     = core::SystemTimestamp();
+    duration_       = std::chrono::nanoseconds{0};
+    interned_name_  = common::InternedString{};
+    name_.clear();
+    status_code_ = opentelemetry::trace::StatusCode::kUnset;
+    status_desc_.clear();
+    attribute_map_.Clear();
+    events_.clear();
+    links_.clear();
+    dropped_attributes_count_ = 0;
+    dropped_events_count_     = 0;
+    dropped_links_count_      = 0;
+    span_kind_                = opentelemetry::trace::SpanKind::kInternal;
+    instrumentation_library_.reset();
+  }
+
 private:
   opentelemetry::trace::SpanContext span_context_{false, false};
   opentelemetry::trace::SpanId parent_span_id_;
   core::SystemTimestamp start_time_;
   std::chrono::nanoseconds duration_{0};
+  common::InternedString interned_name_;
   std::string name_;
   opentelemetry::trace::StatusCode status_code_{opentelemetry::trace::StatusCode::kUnset};
   std::string status_desc_;
-  common::AttributeMap attribute_map_;
+  common::FlatAttributeMap<kSpanAttributesInlineCapacity> attribute_map_;
   std::vector<SpanDataEvent> events_;
   std::vector<SpanDataLink> links_;
+  uint32_t dropped_attributes_count_{0};
+  uint32_t dropped_events_count_{0};
+  uint32_t dropped_links_count_{0};
   opentelemetry::trace::SpanKind span_kind_{opentelemetry::trace::SpanKind::kInternal};
+  std::shared_ptr<const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+      instrumentation_library_;
 };
 }  // namespace trace
 }  // namespace sdk
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * SpanLimits bound the amount of data a single span can accumulate. Attributes,
+ * events and links exceeding the limits are dropped by the span before they
+ * reach the recordable, and the number of dropped items is recorded on the
+ * recordable when the span ends.
+ *
+ * The defaults follow the OpenTelemetry specification.
+ */
+struct SpanLimits
+{
+  static constexpr uint32_t kUnlimited = std::numeric_limits<uint32_t>::max();
+
+  // The maximum number of attributes of a span.
+  uint32_t attribute_count_limit = 128;
+
+  // The maximum number of events of a span.
+  uint32_t event_count_limit = 128;
+
+  // The maximum number of links of a span.
+  uint32_t link_count_limit = 128;
+
+  // The maximum number of attributes of an event.
+  uint32_t attribute_per_event_count_limit = 128;
+
+  // The maximum number of attributes of a link.
+  uint32_t attribute_per_link_count_limit = 128;
+
+  // The maximum length of string attribute values, and of each string in array
+  // attribute values. Longer values are truncated.
+  uint32_t attribute_value_length_limit = kUnlimited;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "opentelemetry/sdk/common/disk_spool.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A span exporter which keeps the batches in a disk spool while the backend is
+ * down. Every batch is encoded once by the wrapped exporter. If sending it
+ * fails with ExportResult::kFailureRetryable, the encoded batch is appended to
+ * the spool, and once the backend recovers the spooled batches are sent in
+ * order before new ones, without serializing them again. The backlog is
+ * replayed on the executor of the spool options, and within the timeout of
+ * Shutdown().
+ *
+ * Spooled batches are exported successfully as far as the caller is concerned.
+ * The spool outlives the process, so batches spooled before a restart are
+ * sent after it.
+ */
+class SpoolingSpanExporter final : public SpanExporter
+{
+public:
+  /**
+   * @param exporter the exporter encoding and sending the batches
+   * @param options the disk spool options
+   */
+  SpoolingSpanExporter(std::unique_ptr<EncodingSpanExporter> &&exporter,
+                       const common::DiskSpoolOptions &options);
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<Recordable>> &spans) noexcept override;
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * @return the number of spool segments deleted because the spool was full,
+   * or because they were corrupted.
+   */
+  uint64_t GetEvictedCount() const noexcept { return spooler_.evicted_count(); }
+
+private:
+  std::unique_ptr<EncodingSpanExporter> exporter_;
+  common::Spooler spooler_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
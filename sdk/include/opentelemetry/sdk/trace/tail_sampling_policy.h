@@ -0,0 +1,159 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A policy of a TailSamplingSpanProcessor, which decides whether to keep a
+ * trace once it is complete, seeing all of its spans.
+ */
+class TailSamplingPolicy
+{
+public:
+  virtual ~TailSamplingPolicy() = default;
+
+  /**
+   * @param spans the ended spans of a trace, in the order they ended
+   * @return true if the trace should be kept
+   *
+   * Note: This method must be callable from multiple threads.
+   */
+  virtual bool ShouldKeep(const std::vector<std::unique_ptr<SpanData>> &spans) const noexcept = 0;
+};
+
+/**
+ * Keeps the traces with a span with an error status.
+ */
+class ErrorStatusPolicy final : public TailSamplingPolicy
+{
+public:
+  bool ShouldKeep(const std::vector<std::unique_ptr<SpanData>> &spans) const noexcept override
+  {
+    for (auto &span : spans)
+    {
+      if (span->GetStatus() == opentelemetry::trace::StatusCode::kError)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/**
+ * Keeps the traces whose root span lasted longer than a threshold. If the root
+ * span was not received, the longest span is used instead.
+ */
+class LatencyPolicy final : public TailSamplingPolicy
+{
+public:
+  explicit LatencyPolicy(std::chrono::nanoseconds threshold) noexcept : threshold_{threshold} {}
+
+  bool ShouldKeep(const std::vector<std::unique_ptr<SpanData>> &spans) const noexcept override
+  {
+    auto duration = std::chrono::nanoseconds::zero();
+    for (auto &span : spans)
+    {
+      if (!span->GetParentSpanId().IsValid())
+      {
+        return span->GetDuration() > threshold_;
+      }
+      duration = (std::max)(duration, span->GetDuration());
+    }
+    return duration > threshold_;
+  }
+
+private:
+  const std::chrono::nanoseconds threshold_;
+};
+
+/**
+ * Keeps the traces with a span with a matching attribute.
+ */
+class AttributePolicy final : public TailSamplingPolicy
+{
+public:
+  using Matcher = std::function<bool(const common::OwnedAttributeValue &)>;
+
+  /**
+   * @param key the key of the attribute
+   * @param matcher returns true for the matching values of the attribute
+   */
+  AttributePolicy(std::string key, Matcher matcher)
+      : key_{std::move(key)}, matcher_{std::move(matcher)}
+  {}
+
+  /**
+   * @param key the key of the attribute
+   * @param value the matching string value of the attribute
+   */
+  AttributePolicy(std::string key, std::string value)
+      : AttributePolicy(std::move(key), [value](const common::OwnedAttributeValue &attribute) {
+          return nostd::holds_alternative<std::string>(attribute) &&
+                 nostd::get<std::string>(attribute) == value;
+        })
+  {}
+
+  bool ShouldKeep(const std::vector<std::unique_ptr<SpanData>> &spans) const noexcept override
+  {
+    for (auto &span : spans)
+    {
+      auto attributes = span->GetAttributes();
+      auto it         = attributes.find(key_);
+      if (it != attributes.end() && matcher_(it->second))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  const std::string key_;
+  const Matcher matcher_;
+};
+
+/**
+ * Keeps a ratio of the traces, chosen by trace id in the same way as the
+ * TraceIdRatioBasedSampler, so that both keep the same traces for the same
+ * ratio.
+ */
+class RatioPolicy final : public TailSamplingPolicy
+{
+public:
+  /**
+   * @param ratio the ratio of traces to keep, between 0.0 and 1.0
+   */
+  explicit RatioPolicy(double ratio) noexcept : ratio_{ratio} {}
+
+  bool ShouldKeep(const std::vector<std::unique_ptr<SpanData>> &spans) const noexcept override
+  {
+    if (spans.empty())
+    {
+      return false;
+    }
+    // Like the TraceIdRatioBasedSampler, only the first 8 bytes of the trace id are used.
+    uint64_t value = 0;
+    std::memcpy(&value, spans.front()->GetTraceId().Id().data(), sizeof(value));
+    return static_cast<double>(value) / static_cast<double>(UINT64_MAX) < ratio_;
+  }
+
+private:
+  const double ratio_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "opentelemetry/sdk/common/executor.h"
+#include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/tail_sampling_policy.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+/**
+ * Struct to hold tail sampling SpanProcessor options.
+ */
+struct TailSamplingSpanProcessorOptions
+{
+  /**
+   * The policies deciding whether to keep a trace. A trace is kept if any
+   * policy keeps it. With no policies, all traces are kept.
+   */
+  std::vector<std::shared_ptr<TailSamplingPolicy>> policies;
+
+  /* How long after its last span ended a trace is decided. */
+  std::chrono::milliseconds decision_wait = std::chrono::milliseconds(5000);
+
+  /* How long after its first span ended a trace is decided at the latest. */
+  std::chrono::milliseconds max_trace_duration = std::chrono::milliseconds(30000);
+
+  /**
+   * The memory budget of the buffered spans, in bytes estimated by
+   * Recordable::GetEstimatedSize. A span which does not fit decides the oldest
+   * traces of all shards early, and is dropped if that does not make room.
+   */
+  size_t max_buffer_size_bytes = 64 * 1024 * 1024;
+
+  /**
+   * The number of shards the buffered traces are split into by trace id, each
+   * with a lock of its own, so that threads ending spans of different traces
+   * rarely contend.
+   */
+  size_t num_shards = 64;
+
+  /**
+   * The number of decisions remembered for the spans ending after their trace
+   * was decided, which follow the decision of their trace.
+   */
+  size_t max_decisions = 65536;
+
+  /**
+   * The executor to run the decisions on, which may be shared with other
+   * processors. If empty, the processor creates an executor of its own with
+   * one thread.
+   */
+  std::shared_ptr<common::Executor> executor;
+};
+
+/**
+ * The tail sampling span processor buffers the ended spans of every trace, and
+ * decides whether to keep the trace once it is complete, so that policies can
+ * keep traces by their errors or latency. The spans of kept traces are passed
+ * to another span processor; the others are dropped.
+ *
+ * A trace is considered complete when no span of it ended for decision_wait,
+ * or max_trace_duration after its first span ended. Spans ending after the
+ * decision follow it.
+ *
+ * Like the processors of a MultiSpanProcessor, the downstream processor
+ * receives a SharedSpanData in OnEnd, so it, and its exporter, must accept
+ * one. The processor itself accepts a SharedSpanData as well, which it copies
+ * to buffer it. The tracer provider should sample all spans, since spans dropped by
+ * the sampler never reach this processor.
+ */
+class TailSamplingSpanProcessor : public SpanProcessor
+{
+public:
+  /**
+   * @param processor the span processor to pass the spans of kept traces to
+   * @param options the tail sampling SpanProcessor options
+   */
+  TailSamplingSpanProcessor(std::shared_ptr<SpanProcessor> processor,
+                            const TailSamplingSpanProcessorOptions &options);
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  void OnStart(Recordable &span,
+               const opentelemetry::trace::SpanContext &parent_context) noexcept override;
+
+  void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override;
+
+  /**
+   * Decides all buffered traces, and force flushes the downstream processor.
+   */
+  bool ForceFlush(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Decides all buffered traces, and shuts down the downstream processor.
+   */
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  ~TailSamplingSpanProcessor();
+
+  /**
+   * @return the number of traces kept.
+   */
+  uint64_t GetKeptTraceCount() const noexcept { return kept_trace_count_.load(); }
+
+  /**
+   * @return the number of traces dropped.
+   */
+  uint64_t GetDroppedTraceCount() const noexcept { return dropped_trace_count_.load(); }
+
+  /**
+   * @return the number of spans dropped because they did not fit into the
+   * memory budget.
+   */
+  uint64_t GetDroppedSpanCount() const noexcept { return dropped_span_count_.load(); }
+
+private:
+  struct TraceIdHash
+  {
+    size_t operator()(const opentelemetry::trace::TraceId &trace_id) const noexcept;
+  };
+
+  struct Trace
+  {
+    std::vector<std::unique_ptr<SpanData>> spans;
+    size_t size = 0;
+    common::Executor::Clock::time_point first_time;
+    common::Executor::Clock::time_point last_time;
+  };
+
+  using TraceMap = std::unordered_map<opentelemetry::trace::TraceId, Trace, TraceIdHash>;
+
+  /**
+   * The traces of a range of trace ids, and the recent decisions for them.
+   */
+  struct Shard
+  {
+    std::mutex mutex;
+    TraceMap traces;
+    // The trace ids by their first span, some of which may have been decided.
+    std::deque<opentelemetry::trace::TraceId> trace_order;
+    std::unordered_map<opentelemetry::trace::TraceId, bool, TraceIdHash> decisions;
+    std::deque<opentelemetry::trace::TraceId> decision_order;
+  };
+
+  /**
+   * The background routine deciding the complete traces.
+   *
+   * @return the delay until the next run
+   */
+  common::Executor::Clock::duration DoBackgroundWork();
+
+  /**
+   * Decides the traces of every shard which are complete at the given time,
+   * or all traces if the time is Clock::time_point::max().
+   */
+  void DecideTraces(common::Executor::Clock::time_point time) noexcept;
+
+  /**
+   * Decides a trace of a shard, and removes it from the shard. The spans of a
+   * kept trace are moved to kept_spans.
+   *
+   * Note: The shard must be locked.
+   *
+   * @return the iterator following the removed trace
+   */
+  TraceMap::iterator DecideTrace(Shard &shard,
+                                 TraceMap::iterator it,
+                                 std::vector<std::unique_ptr<SpanData>> &kept_spans) noexcept;
+
+  /**
+   * Decides the buffered trace whose first span ended first, over all shards,
+   * apart from the given trace. The spans of a kept trace are moved to
+   * kept_spans.
+   *
+   * Note: No shard may be locked.
+   *
+   * @return false if there is no trace to decide
+   */
+  bool DecideOldestTrace(const opentelemetry::trace::TraceId &excluded_trace_id,
+                         std::vector<std::unique_ptr<SpanData>> &kept_spans) noexcept;
+
+  /**
+   * Finds the oldest trace of a shard apart from the given trace.
+   *
+   * Note: The shard must be locked.
+   *
+   * @return the trace, or the end of the traces of the shard
+   */
+  TraceMap::iterator FindOldestTrace(
+      Shard &shard,
+      const opentelemetry::trace::TraceId &excluded_trace_id) noexcept;
+
+  /**
+   * Reserves memory budget for a span.
+   * @return false if the span does not fit into the budget
+   */
+  bool TryReserve(size_t size) noexcept;
+
+  /**
+   * Passes the spans of kept traces to the downstream processor.
+   */
+  void Forward(std::vector<std::unique_ptr<SpanData>> &spans) noexcept;
+
+  Shard &GetShard(const opentelemetry::trace::TraceId &trace_id) noexcept;
+
+  const std::shared_ptr<SpanProcessor> processor_;
+  const std::vector<std::shared_ptr<TailSamplingPolicy>> policies_;
+  const common::Executor::Clock::duration decision_wait_;
+  const common::Executor::Clock::duration max_trace_duration_;
+  const size_t max_buffer_size_bytes_;
+  const size_t max_decisions_per_shard_;
+  const common::Executor::Clock::duration scan_interval_;
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<size_t> buffer_size_bytes_{0};
+
+  std::atomic<uint64_t> kept_trace_count_{0};
+  std::atomic<uint64_t> dropped_trace_count_{0};
+  std::atomic<uint64_t> dropped_span_count_{0};
+  std::atomic<bool> is_shutdown_{false};
+
+  /* The executor and the background worker task running on it */
+  std::shared_ptr<common::Executor> executor_;
+  std::unique_ptr<common::ScheduledTask> worker_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -1,9 +1,14 @@
 #pragma once
 
-#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/clock.h"
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/id_generator.h"
 #include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/random_id_generator.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
+#include "opentelemetry/sdk/trace/span_limits.h"
+#include "opentelemetry/sdk/trace/tracer_context.h"
 #include "opentelemetry/trace/noop.h"
 #include "opentelemetry/trace/tracer.h"
 #include "opentelemetry/version.h"
@@ -19,13 +24,44 @@ class Tracer final : public trace_api::Tracer, public std::enable_shared_from_th
 {
 public:
   /**
-   * Initialize a new tracer.
+   * Initialize a new tracer sharing the configuration of a tracer provider.
+   *
+   * Spans created by this tracer refer to the tracer's context without owning
+   * it; the context is kept alive until they have ended, even if the tracer is
+   * destroyed before.
+   *
+   * @param context The configuration shared with the other tracers of the
+   * tracer provider. This must not be a nullptr.
+   * @param instrumentation_library The library this tracer instruments.
+   */
+  explicit Tracer(std::shared_ptr<TracerContext> context,
+                  std::unique_ptr<opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+                      instrumentation_library =
+                          opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create(
+                              "")) noexcept;
+
+  /**
+   * Initialize a new tracer with a context of its own.
+   *
+   * Processors replaced by SetProcessor are released once the spans started
+   * before have ended.
+   *
    * @param processor The span processor for this tracer. This must not be a
    * nullptr.
+   * @param id_generator The generator for the trace and span ids of new spans.
+   * This must not be a nullptr.
+   * @param clock The clock for the timestamps of new spans. This must not be a
+   * nullptr.
+   * @param span_limits The limits for the attributes, events and links of new spans.
    */
-  explicit Tracer(std::shared_ptr<SpanProcessor> processor,
-                  const opentelemetry::sdk::resource::Resource &resource,
-                  std::shared_ptr<Sampler> sampler = std::make_shared<AlwaysOnSampler>()) noexcept;
+  explicit Tracer(
+      std::shared_ptr<SpanProcessor> processor,
+      const opentelemetry::sdk::resource::Resource &resource,
+      std::shared_ptr<Sampler> sampler           = std::make_shared<AlwaysOnSampler>(),
+      std::shared_ptr<IdGenerator> id_generator = std::make_shared<RandomIdGenerator>(),
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          opentelemetry::sdk::common::SystemClock::GetInstance(),
+      const SpanLimits &span_limits = SpanLimits()) noexcept;
 
   /**
    * Set the span processor associated with this tracer.
@@ -40,12 +76,47 @@ class Tracer final : public trace_api::Tracer, public std::enable_shared_from_th
    */
   std::shared_ptr<SpanProcessor> GetProcessor() const noexcept;
 
+  /**
+   * Set the sampler associated with this tracer.
+   * @param sampler The new sampler for this tracer. This must not be a
+   * nullptr.
+   */
+  void SetSampler(std::shared_ptr<Sampler> sampler) noexcept;
+
   /**
    * Obtain the sampler associated with this tracer.
    * @return The sampler for this tracer.
    */
   std::shared_ptr<Sampler> GetSampler() const noexcept;
 
+  /**
+   * Obtain the id generator associated with this tracer.
+   * @return The id generator for this tracer.
+   */
+  std::shared_ptr<IdGenerator> GetIdGenerator() const noexcept;
+
+  /**
+   * Obtain the clock associated with this tracer.
+   * @return The clock for this tracer.
+   */
+  std::shared_ptr<opentelemetry::sdk::common::Clock> GetClock() const noexcept;
+
+  /**
+   * Obtain the span limits associated with this tracer.
+   * @return The span limits for this tracer.
+   */
+  const SpanLimits &GetSpanLimits() const noexcept;
+
+  /**
+   * Obtain the instrumentation library of this tracer.
+   * @return The instrumentation library of this tracer.
+   */
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary &
+  GetInstrumentationLibrary() const noexcept
+  {
+    return *instrumentation_library_;
+  }
+
   nostd::shared_ptr<trace_api::Span> StartSpan(
       nostd::string_view name,
       const opentelemetry::common::KeyValueIterable &attributes,
@@ -57,9 +128,10 @@ class Tracer final : public trace_api::Tracer, public std::enable_shared_from_th
   void CloseWithMicroseconds(uint64_t timeout) noexcept override;
 
 private:
-  opentelemetry::sdk::common::AtomicSharedPtr<SpanProcessor> processor_;
-  const std::shared_ptr<Sampler> sampler_;
-  const opentelemetry::sdk::resource::Resource &resource_;
+  const std::shared_ptr<TracerContext> context_;
+  // Shared with the spans of this tracer, which may outlive it.
+  const std::shared_ptr<const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+      instrumentation_library_;
 };
 }  // namespace trace
 }  // namespace sdk
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <memory>
+
+#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/clock.h"
+#include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/id_generator.h"
+#include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/random_id_generator.h"
+#include "opentelemetry/sdk/trace/sampler.h"
+#include "opentelemetry/sdk/trace/samplers/always_on.h"
+#include "opentelemetry/sdk/trace/span_limits.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The configuration shared by all tracers of a tracer provider: the span
+ * processor, resource, sampler, id generator, clock and span limits.
+ *
+ * Spans hold a reference to the context and to the processor they started
+ * with. Samplers are read without acquiring a reference, under an EpochGuard,
+ * and samplers replaced by SetSampler are released after a grace period.
+ */
+class TracerContext
+{
+public:
+  /**
+   * Initialize a new tracer context.
+   * @param processor The span processor. This must not be a nullptr.
+   * @param resource The resource of the spans.
+   * @param sampler The sampler. This must not be a nullptr.
+   * @param id_generator The generator for the trace and span ids of new spans.
+   * This must not be a nullptr.
+   * @param clock The clock for the timestamps of new spans. This must not be a
+   * nullptr.
+   * @param span_limits The limits for the attributes, events and links of new spans.
+   */
+  explicit TracerContext(
+      std::shared_ptr<SpanProcessor> processor,
+      opentelemetry::sdk::resource::Resource resource =
+          opentelemetry::sdk::resource::Resource::Create({}),
+      std::shared_ptr<Sampler> sampler           = std::make_shared<AlwaysOnSampler>(),
+      std::shared_ptr<IdGenerator> id_generator = std::make_shared<RandomIdGenerator>(),
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          opentelemetry::sdk::common::SystemClock::GetInstance(),
+      const SpanLimits &span_limits = SpanLimits()) noexcept;
+
+  /**
+   * Set the span processor of this context.
+   * @param processor The new span processor. This must not be a nullptr.
+   */
+  void SetProcessor(std::shared_ptr<SpanProcessor> processor) noexcept;
+
+  /**
+   * Obtain the span processor of this context.
+   * @return The span processor.
+   */
+  std::shared_ptr<SpanProcessor> GetProcessor() const noexcept;
+
+  /**
+   * Obtain the span processor of this context without acquiring a reference to
+   * it. The processor stays valid while the caller holds an EpochGuard.
+   * @return The span processor.
+   */
+  SpanProcessor &GetActiveProcessor() const noexcept { return *processor_.get(); }
+
+  /**
+   * Set the sampler of this context. Spans started concurrently use either the
+   * old or the new sampler.
+   * @param sampler The new sampler. This must not be a nullptr.
+   */
+  void SetSampler(std::shared_ptr<Sampler> sampler) noexcept;
+
+  /**
+   * Obtain the sampler of this context.
+   * @return The sampler.
+   */
+  std::shared_ptr<Sampler> GetSampler() const noexcept;
+
+  /**
+   * Obtain the sampler of this context without acquiring a reference to it.
+   * The sampler stays valid while the caller holds an EpochGuard.
+   * @return The sampler.
+   */
+  Sampler &GetActiveSampler() const noexcept { return *sampler_.get(); }
+
+  const std::shared_ptr<IdGenerator> &GetIdGenerator() const noexcept { return id_generator_; }
+
+  const std::shared_ptr<opentelemetry::sdk::common::Clock> &GetClock() const noexcept
+  {
+    return clock_;
+  }
+
+  const SpanLimits &GetSpanLimits() const noexcept { return span_limits_; }
+
+  const opentelemetry::sdk::resource::Resource &GetResource() const noexcept { return resource_; }
+
+private:
+  opentelemetry::sdk::common::AtomicSharedPtr<SpanProcessor> processor_;
+  const opentelemetry::sdk::resource::Resource resource_;
+  opentelemetry::sdk::common::AtomicSharedPtr<Sampler> sampler_;
+  const std::shared_ptr<IdGenerator> id_generator_;
+  const std::shared_ptr<opentelemetry::sdk::common::Clock> clock_;
+  const SpanLimits span_limits_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -2,13 +2,20 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "opentelemetry/nostd/shared_ptr.h"
+#include "opentelemetry/sdk/common/clock.h"
 #include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/id_generator.h"
 #include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/random_id_generator.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
+#include "opentelemetry/sdk/trace/span_limits.h"
 #include "opentelemetry/sdk/trace/tracer.h"
+#include "opentelemetry/sdk/trace/tracer_context.h"
 #include "opentelemetry/trace/tracer_provider.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -25,13 +32,37 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
    * not be a nullptr.
    * @param sampler The sampler for this tracer provider. This must
    * not be a nullptr.
+   * @param id_generator The generator for the trace and span ids of new
+   * spans. This must not be a nullptr.
+   * @param clock The clock for the timestamps of new spans. This must not be a
+   * nullptr.
+   * @param span_limits The limits for the attributes, events and links of new spans.
    */
   explicit TracerProvider(
       std::shared_ptr<SpanProcessor> processor,
       opentelemetry::sdk::resource::Resource &&resource =
           opentelemetry::sdk::resource::Resource::Create({}),
-      std::shared_ptr<Sampler> sampler = std::make_shared<AlwaysOnSampler>()) noexcept;
+      std::shared_ptr<Sampler> sampler           = std::make_shared<AlwaysOnSampler>(),
+      std::shared_ptr<IdGenerator> id_generator = std::make_shared<RandomIdGenerator>(),
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          opentelemetry::sdk::common::SystemClock::GetInstance(),
+      const SpanLimits &span_limits = SpanLimits()) noexcept;
 
+  /**
+   * Initialize a new tracer provider with the configuration of a tracer context.
+   * @param context The configuration shared by all tracers of this tracer
+   * provider. This must not be a nullptr.
+   */
+  explicit TracerProvider(std::shared_ptr<TracerContext> context) noexcept;
+
+  /**
+   * Obtain the tracer for an instrumentation library. Tracers are created on
+   * first use and kept until the tracer provider is destroyed. Looking up an
+   * existing tracer does not take a lock.
+   * @param library_name The name of the instrumentation library.
+   * @param library_version The version of the instrumentation library.
+   * @return The tracer for the instrumentation library.
+   */
   opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer> GetTracer(
       nostd::string_view library_name,
       nostd::string_view library_version = "") noexcept override;
@@ -49,12 +80,39 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
    */
   std::shared_ptr<SpanProcessor> GetProcessor() const noexcept;
 
+  /**
+   * Set the sampler associated with this tracer provider, e.g. to lower the
+   * sampling ratio without restarting the process. Spans started concurrently
+   * use either the old or the new sampler.
+   * @param sampler The new sampler for this tracer provider. This must not be
+   * a nullptr.
+   */
+  void SetSampler(std::shared_ptr<Sampler> sampler) noexcept;
+
   /**
    * Obtain the sampler associated with this tracer provider.
    * @return The sampler for this tracer provider.
    */
   std::shared_ptr<Sampler> GetSampler() const noexcept;
 
+  /**
+   * Obtain the id generator associated with this tracer provider.
+   * @return The id generator for this tracer provider.
+   */
+  std::shared_ptr<IdGenerator> GetIdGenerator() const noexcept;
+
+  /**
+   * Obtain the clock associated with this tracer provider.
+   * @return The clock for this tracer provider.
+   */
+  std::shared_ptr<opentelemetry::sdk::common::Clock> GetClock() const noexcept;
+
+  /**
+   * Obtain the span limits associated with this tracer provider.
+   * @return The span limits for this tracer provider.
+   */
+  const SpanLimits &GetSpanLimits() const noexcept;
+
   /**
    * Obtain the resource associated with this tracer provider.
    * @return The resource for this tracer provider.
@@ -72,10 +130,17 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
   bool ForceFlush(std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept;
 
 private:
-  opentelemetry::sdk::common::AtomicSharedPtr<SpanProcessor> processor_;
-  std::shared_ptr<opentelemetry::trace::Tracer> tracer_;
-  const std::shared_ptr<Sampler> sampler_;
-  const opentelemetry::sdk::resource::Resource resource_;
+  using TracerList = std::vector<std::shared_ptr<Tracer>>;
+
+  const std::shared_ptr<TracerContext> context_;
+
+  // The tracers created so far. Creating a tracer publishes a copy of the list,
+  // so readers can use the current list without locking; retired lists are kept
+  // until the tracer provider is destroyed.
+  opentelemetry::sdk::common::AtomicSharedPtr<TracerList> tracers_;
+
+  // Serializes the creation of tracers.
+  std::mutex tracers_mutex_;
 };
 }  // namespace trace
 }  // namespace sdk
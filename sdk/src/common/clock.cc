@@ -0,0 +1,260 @@
+#include "opentelemetry/sdk/common/clock.h"
+
+#include <thread>
+
+#if defined(__linux__)
+#  include <time.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#  define OTEL_SDK_HAVE_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  include <cpuid.h>
+#  include <x86intrin.h>
+#  define OTEL_SDK_HAVE_RDTSC
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+core::SystemTimestamp SystemClock::SystemNow() noexcept
+{
+  return core::SystemTimestamp(std::chrono::system_clock::now());
+}
+
+core::SteadyTimestamp SystemClock::SteadyNow() noexcept
+{
+  return core::SteadyTimestamp(std::chrono::steady_clock::now());
+}
+
+std::shared_ptr<Clock> SystemClock::GetInstance() noexcept
+{
+  static std::shared_ptr<Clock> instance{new SystemClock};
+  return instance;
+}
+
+namespace
+{
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE) && defined(CLOCK_MONOTONIC_COARSE)
+std::chrono::nanoseconds ReadClock(clockid_t clock_id) noexcept
+{
+  struct timespec ts;
+  clock_gettime(clock_id, &ts);
+  return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+#endif
+}  // namespace
+
+core::SystemTimestamp CoarseClock::SystemNow() noexcept
+{
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+  return core::SystemTimestamp(ReadClock(CLOCK_REALTIME_COARSE));
+#else
+  return core::SystemTimestamp(std::chrono::system_clock::now());
+#endif
+}
+
+core::SteadyTimestamp CoarseClock::SteadyNow() noexcept
+{
+  // std::chrono::steady_clock is CLOCK_MONOTONIC on Linux, which shares its
+  // epoch with CLOCK_MONOTONIC_COARSE, so both timestamps can be compared.
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+  return core::SteadyTimestamp(ReadClock(CLOCK_MONOTONIC_COARSE));
+#else
+  return core::SteadyTimestamp(std::chrono::steady_clock::now());
+#endif
+}
+
+namespace
+{
+int64_t ReadSteadyNanos() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int64_t ReadSystemNanos() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+TscClock::TscClock(std::chrono::microseconds calibration_duration) noexcept
+    : use_tsc_(HasInvariantTsc())
+{
+  Calibrate(calibration_duration);
+}
+
+bool TscClock::HasInvariantTsc() noexcept
+{
+  // The invariant TSC flag is bit 8 of EDX in the extended leaf 0x80000007.
+  constexpr unsigned int kPowerManagementLeaf = 0x80000007;
+  constexpr unsigned int kInvariantTscBit     = 1u << 8;
+#if defined(OTEL_SDK_HAVE_RDTSC) && defined(_MSC_VER)
+  int registers[4];
+  __cpuid(registers, 0x80000000);
+  if (static_cast<unsigned int>(registers[0]) < kPowerManagementLeaf)
+  {
+    return false;
+  }
+  __cpuid(registers, kPowerManagementLeaf);
+  return (static_cast<unsigned int>(registers[3]) & kInvariantTscBit) != 0;
+#elif defined(OTEL_SDK_HAVE_RDTSC)
+  unsigned int eax, ebx, ecx, edx;
+  // __get_cpuid checks that the leaf is supported.
+  if (!__get_cpuid(kPowerManagementLeaf, &eax, &ebx, &ecx, &edx))
+  {
+    return false;
+  }
+  return (edx & kInvariantTscBit) != 0;
+#else
+  (void)kPowerManagementLeaf;
+  (void)kInvariantTscBit;
+  return false;
+#endif
+}
+
+uint64_t TscClock::ReadTicks() const noexcept
+{
+#if defined(OTEL_SDK_HAVE_RDTSC)
+  if (use_tsc_)
+  {
+    return __rdtsc();
+  }
+#endif
+  return static_cast<uint64_t>(ReadSteadyNanos());
+}
+
+void TscClock::Calibrate(std::chrono::microseconds calibration_duration) noexcept
+{
+  double nanos_per_tick = 1.0;
+  if (use_tsc_)
+  {
+    auto start_steady = ReadSteadyNanos();
+    auto start_ticks  = ReadTicks();
+    std::this_thread::sleep_for(calibration_duration);
+    auto end_steady = ReadSteadyNanos();
+    auto end_ticks  = ReadTicks();
+    if (end_ticks > start_ticks)
+    {
+      nanos_per_tick = static_cast<double>(end_steady - start_steady) / (end_ticks - start_ticks);
+    }
+  }
+
+  std::lock_guard<std::mutex> guard{calibrate_mutex_};
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  anchor_ticks_.store(ReadTicks(), std::memory_order_relaxed);
+  nanos_per_tick_.store(nanos_per_tick, std::memory_order_relaxed);
+  anchor_system_nanos_.store(ReadSystemNanos(), std::memory_order_relaxed);
+  anchor_steady_nanos_.store(ReadSteadyNanos(), std::memory_order_relaxed);
+
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+TscClock::Calibration TscClock::LoadCalibration() const noexcept
+{
+  Calibration calibration;
+  uint64_t sequence;
+  do
+  {
+    sequence                        = sequence_.load(std::memory_order_acquire);
+    calibration.anchor_ticks        = anchor_ticks_.load(std::memory_order_relaxed);
+    calibration.nanos_per_tick      = nanos_per_tick_.load(std::memory_order_relaxed);
+    calibration.anchor_system_nanos = anchor_system_nanos_.load(std::memory_order_relaxed);
+    calibration.anchor_steady_nanos = anchor_steady_nanos_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) != 0 || sequence != sequence_.load(std::memory_order_relaxed));
+  return calibration;
+}
+
+ClockTimestamps TscClock::ToTimestamps(const Calibration &calibration,
+                                       uint64_t ticks) const noexcept
+{
+  // The difference is signed, as the counters of different cores may be
+  // slightly apart.
+  auto elapsed = static_cast<int64_t>(static_cast<int64_t>(ticks - calibration.anchor_ticks) *
+                                      calibration.nanos_per_tick);
+  return {
+      core::SystemTimestamp(std::chrono::nanoseconds{calibration.anchor_system_nanos + elapsed}),
+      core::SteadyTimestamp(std::chrono::nanoseconds{calibration.anchor_steady_nanos + elapsed})};
+}
+
+core::SystemTimestamp TscClock::SystemNow() noexcept
+{
+  return Now().system_time;
+}
+
+core::SteadyTimestamp TscClock::SteadyNow() noexcept
+{
+  return Now().steady_time;
+}
+
+ClockTimestamps TscClock::Now() noexcept
+{
+  auto calibration = LoadCalibration();
+  return ToTimestamps(calibration, ReadTicks());
+}
+
+namespace
+{
+// The wall clock anchor of a thread, taken by the clock with the given id. It
+// is trivially constructible, so that accessing the thread_local instance does
+// not need an initialization check.
+struct WallClockAnchor
+{
+  uint64_t clock_id;
+  int64_t system_nanos;
+  int64_t steady_nanos;
+};
+
+thread_local WallClockAnchor wall_clock_anchor;
+
+// Ids start at 1, so that no clock matches the initial anchor of a thread.
+std::atomic<uint64_t> next_clock_id{1};
+}  // namespace
+
+AnchoredClock::AnchoredClock(std::chrono::nanoseconds resync_interval) noexcept
+    : resync_interval_{resync_interval}, id_{next_clock_id.fetch_add(1)}
+{}
+
+core::SystemTimestamp AnchoredClock::SystemNow() noexcept
+{
+  return Now().system_time;
+}
+
+core::SteadyTimestamp AnchoredClock::SteadyNow() noexcept
+{
+  return core::SteadyTimestamp(std::chrono::steady_clock::now());
+}
+
+ClockTimestamps AnchoredClock::Now() noexcept
+{
+  auto steady_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+  // A thread using several clocks re-anchors whenever it switches between them.
+  auto &anchor = wall_clock_anchor;
+  if (anchor.clock_id != id_ || steady_nanos - anchor.steady_nanos > resync_interval_.count())
+  {
+    anchor.clock_id     = id_;
+    anchor.system_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+    anchor.steady_nanos = steady_nanos;
+  }
+  return {core::SystemTimestamp(
+              std::chrono::nanoseconds{anchor.system_nanos + steady_nanos - anchor.steady_nanos}),
+          core::SteadyTimestamp(std::chrono::nanoseconds{steady_nanos})};
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
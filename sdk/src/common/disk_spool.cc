@@ -0,0 +1,408 @@
+#include "opentelemetry/sdk/common/disk_spool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+namespace
+{
+// Every record is framed as: magic, payload length, CRC-32 of the payload,
+// each a little-endian uint32_t, followed by the payload.
+constexpr uint32_t kFrameMagic      = 0x4c4f4f53;  // "SPOL"
+constexpr size_t kFrameHeaderSize   = 12;
+constexpr size_t kMaxSequenceDigits = 20;
+
+uint32_t GetCrc32(const char *data, size_t size) noexcept
+{
+  static const struct Table
+  {
+    uint32_t values[256];
+    Table()
+    {
+      for (uint32_t i = 0; i < 256; ++i)
+      {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+          value = (value & 1) != 0 ? 0xedb88320 ^ (value >> 1) : value >> 1;
+        }
+        values[i] = value;
+      }
+    }
+  } table;
+
+  uint32_t crc = 0xffffffff;
+  for (size_t i = 0; i < size; ++i)
+  {
+    crc = table.values[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+  }
+  return crc ^ 0xffffffff;
+}
+
+void EncodeUint32(uint32_t value, char *out) noexcept
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+uint32_t DecodeUint32(const char *in) noexcept
+{
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    value |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @return the size of a file, or -1 if it does not exist.
+ */
+long GetFileSize(const std::string &path) noexcept
+{
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr)
+  {
+    return -1;
+  }
+  long size = -1;
+  if (std::fseek(file, 0, SEEK_END) == 0)
+  {
+    size = std::ftell(file);
+  }
+  std::fclose(file);
+  return size;
+}
+}  // namespace
+
+DiskSpool::DiskSpool(const DiskSpoolOptions &options) : options_{options}
+{
+  uint64_t sequence = 0;
+  std::FILE *head   = std::fopen(GetHeadPath().c_str(), "rb");
+  if (head != nullptr)
+  {
+    char buffer[kMaxSequenceDigits + 1] = {};
+    std::fread(buffer, 1, kMaxSequenceDigits, head);
+    std::fclose(head);
+    sequence = std::strtoull(buffer, nullptr, 10);
+
+    // A crash may have left the segment removed last.
+    if (sequence > 0)
+    {
+      std::remove(GetSegmentPath(sequence - 1).c_str());
+    }
+  }
+
+  for (long size; (size = GetFileSize(GetSegmentPath(sequence))) >= 0; ++sequence)
+  {
+    segments_.push_back(Segment{sequence, static_cast<size_t>(size)});
+    total_size_ += static_cast<size_t>(size);
+  }
+  next_sequence_ = sequence;
+  if (segments_.empty())
+  {
+    std::remove(GetHeadPath().c_str());
+    next_sequence_ = 0;
+  }
+}
+
+DiskSpool::~DiskSpool()
+{
+  if (writer_ != nullptr)
+  {
+    std::fclose(writer_);
+  }
+  if (reader_ != nullptr)
+  {
+    std::fclose(reader_);
+  }
+}
+
+bool DiskSpool::Append(nostd::string_view data) noexcept
+{
+  const size_t frame_size = kFrameHeaderSize + data.size();
+  if (frame_size > options_.max_total_size || data.size() > 0xffffffff)
+  {
+    return false;
+  }
+
+  if (writer_ == nullptr ||
+      segments_.back().size + frame_size > (std::max)(options_.max_segment_size, frame_size))
+  {
+    if (!StartSegment())
+    {
+      return false;
+    }
+  }
+
+  // Make room by deleting the oldest segments, but not the one written.
+  while (total_size_ + frame_size > options_.max_total_size && segments_.size() > 1)
+  {
+    RemoveFront();
+    ++evicted_count_;
+  }
+
+  char header[kFrameHeaderSize];
+  EncodeUint32(kFrameMagic, header);
+  EncodeUint32(static_cast<uint32_t>(data.size()), header + 4);
+  EncodeUint32(GetCrc32(data.data(), data.size()), header + 8);
+  bool is_written = std::fwrite(header, 1, kFrameHeaderSize, writer_) == kFrameHeaderSize &&
+                    std::fwrite(data.data(), 1, data.size(), writer_) == data.size() &&
+                    std::fflush(writer_) == 0;
+
+  // A partly written record is detected by its CRC when read.
+  segments_.back().size += frame_size;
+  total_size_ += frame_size;
+  if (!is_written)
+  {
+    std::fclose(writer_);
+    writer_ = nullptr;
+  }
+  return is_written;
+}
+
+bool DiskSpool::Peek(std::string *data) noexcept
+{
+  while (!segments_.empty())
+  {
+    const bool is_written = writer_ != nullptr && segments_.size() == 1;
+    if (reader_ == nullptr)
+    {
+      reader_ = std::fopen(GetSegmentPath(segments_.front().sequence).c_str(), "rb");
+    }
+
+    // Seeking also clears the end of file reached while the segment was shorter.
+    char header[kFrameHeaderSize];
+    if (reader_ != nullptr &&
+        std::fseek(reader_, static_cast<long>(read_offset_), SEEK_SET) == 0 &&
+        std::fread(header, 1, kFrameHeaderSize, reader_) == kFrameHeaderSize)
+    {
+      const size_t size = DecodeUint32(header + 4);
+      if (DecodeUint32(header) == kFrameMagic &&
+          read_offset_ + kFrameHeaderSize + size <= segments_.front().size)
+      {
+        data->resize(size);
+        if (std::fread(&(*data)[0], 1, size, reader_) == size &&
+            GetCrc32(data->data(), size) == DecodeUint32(header + 8))
+        {
+          peek_size_ = kFrameHeaderSize + size;
+          return true;
+        }
+      }
+    }
+    else if (is_written && read_offset_ == segments_.front().size)
+    {
+      // All the records written so far were read.
+      return false;
+    }
+
+    // The rest of the segment is exhausted, torn or corrupted.
+    if (read_offset_ < segments_.front().size)
+    {
+      ++evicted_count_;
+    }
+    RemoveFront();
+  }
+  return false;
+}
+
+void DiskSpool::Pop() noexcept
+{
+  if (segments_.empty() || peek_size_ == 0)
+  {
+    return;
+  }
+  read_offset_ += peek_size_;
+  peek_size_ = 0;
+  if (read_offset_ >= segments_.front().size)
+  {
+    RemoveFront();
+  }
+}
+
+std::string DiskSpool::GetSegmentPath(uint64_t sequence) const
+{
+  std::string digits = std::to_string(sequence);
+  return options_.directory + "/" + options_.name + "-" +
+         std::string(kMaxSequenceDigits - digits.size(), '0') + digits + ".spool";
+}
+
+std::string DiskSpool::GetHeadPath() const
+{
+  return options_.directory + "/" + options_.name + ".head";
+}
+
+void DiskSpool::WriteHead(uint64_t sequence) noexcept
+{
+  // The head file is replaced by renaming, so that it is never torn.
+  std::string path      = GetHeadPath();
+  std::string temp_path = path + ".tmp";
+  std::FILE *file       = std::fopen(temp_path.c_str(), "wb");
+  if (file == nullptr)
+  {
+    return;
+  }
+  std::string digits = std::to_string(sequence);
+  bool is_written    = std::fwrite(digits.data(), 1, digits.size(), file) == digits.size();
+  is_written         = std::fclose(file) == 0 && is_written;
+  if (is_written && std::rename(temp_path.c_str(), path.c_str()) != 0)
+  {
+    // Renaming onto an existing file fails on some platforms.
+    std::remove(path.c_str());
+    std::rename(temp_path.c_str(), path.c_str());
+  }
+}
+
+void DiskSpool::RemoveFront() noexcept
+{
+  if (reader_ != nullptr)
+  {
+    std::fclose(reader_);
+    reader_ = nullptr;
+  }
+  read_offset_ = 0;
+  peek_size_   = 0;
+  if (writer_ != nullptr && segments_.size() == 1)
+  {
+    std::fclose(writer_);
+    writer_ = nullptr;
+  }
+
+  const Segment segment = segments_.front();
+  segments_.pop_front();
+  total_size_ -= segment.size;
+  if (segments_.empty())
+  {
+    std::remove(GetSegmentPath(segment.sequence).c_str());
+    std::remove(GetHeadPath().c_str());
+    next_sequence_ = 0;
+    return;
+  }
+
+  // The head moves on before the segment is deleted, so that a crash in between
+  // leaves a segment which is deleted on recovery.
+  WriteHead(segments_.front().sequence);
+  std::remove(GetSegmentPath(segment.sequence).c_str());
+}
+
+bool DiskSpool::StartSegment() noexcept
+{
+  if (writer_ != nullptr)
+  {
+    std::fclose(writer_);
+    writer_ = nullptr;
+  }
+  const uint64_t sequence = next_sequence_;
+  writer_                 = std::fopen(GetSegmentPath(sequence).c_str(), "wb");
+  if (writer_ == nullptr)
+  {
+    return false;
+  }
+  if (segments_.empty())
+  {
+    WriteHead(sequence);
+  }
+  segments_.push_back(Segment{sequence, 0});
+  ++next_sequence_;
+  return true;
+}
+
+Spooler::Spooler(const DiskSpoolOptions &options, ExportEncoded export_encoded)
+    : replay_interval_{options.replay_interval},
+      max_replay_batches_{(std::max)(options.max_replay_batches, size_t{1})},
+      export_encoded_{std::move(export_encoded)},
+      spool_{options}
+{
+  // The batches left by a previous process are replayed right away.
+  replay_task_.reset(new ScheduledTask(
+      options.executor ? options.executor : std::make_shared<Executor>(),
+      [this] { return Replay(); }, Executor::Clock::duration::zero()));
+}
+
+ExportResult Spooler::Export(std::string &&data) noexcept
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  auto now = Executor::Clock::now();
+  if (spool_.empty() && now >= retry_time_)
+  {
+    auto result = export_encoded_(data);
+    if (result != ExportResult::kFailureRetryable)
+    {
+      return result;
+    }
+    retry_time_ = now + replay_interval_;
+  }
+
+  // Keep the batch until the backend recovers, behind the rest of the backlog.
+  if (!spool_.Append(data))
+  {
+    return ExportResult::kFailure;
+  }
+  replay_task_->Wake();
+  return ExportResult::kSuccess;
+}
+
+Executor::Clock::duration Spooler::Replay() noexcept
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (spool_.empty())
+  {
+    return (Executor::Clock::duration::max)();
+  }
+  auto now = Executor::Clock::now();
+  if (now < retry_time_)
+  {
+    return retry_time_ - now;
+  }
+
+  // Batches failing permanently are dropped. The mutex is released between
+  // rounds to let the exports waiting for it spool their batches.
+  std::string spooled;
+  for (size_t i = 0; i < max_replay_batches_; ++i)
+  {
+    if (!spool_.Peek(&spooled))
+    {
+      return (Executor::Clock::duration::max)();
+    }
+    if (export_encoded_(spooled) == ExportResult::kFailureRetryable)
+    {
+      retry_time_ = Executor::Clock::now() + replay_interval_;
+      return replay_interval_;
+    }
+    spool_.Pop();
+  }
+  return Executor::Clock::duration::zero();
+}
+
+void Spooler::Shutdown(const Deadline &deadline) noexcept
+{
+  replay_task_->Stop(deadline);
+
+  std::lock_guard<std::mutex> guard{mutex_};
+  std::string spooled;
+  while (!deadline.IsExpired() && spool_.Peek(&spooled))
+  {
+    if (export_encoded_(spooled) == ExportResult::kFailureRetryable)
+    {
+      break;
+    }
+    spool_.Pop();
+  }
+}
+
+uint64_t Spooler::evicted_count() const noexcept
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return spool_.evicted_count();
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
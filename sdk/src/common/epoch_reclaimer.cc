@@ -0,0 +1,166 @@
+#include "opentelemetry/sdk/common/epoch_reclaimer.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+namespace
+{
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kNumShards     = 64;
+
+// The minimum interval in nanoseconds between the passes releasing retired
+// values on the release of a guard.
+constexpr int64_t kAdvanceInterval = 10 * 1000 * 1000;
+
+/**
+ * The number of readers in each of the two most recent epochs, by parity of
+ * the epoch, for the threads of one shard.
+ */
+struct alignas(kCacheLineSize) Shard
+{
+  std::atomic<int64_t> readers[2];
+};
+
+// These are trivially destructible, so guards may still be released during the
+// destruction of static objects.
+Shard shards[kNumShards];
+std::atomic<uint64_t> epoch{0};
+std::atomic<size_t> num_retired{0};
+std::atomic<int64_t> last_advance_time{0};
+
+/**
+ * The values retired in the current epoch, and those retired in the previous
+ * epoch, which are released when the epoch advances again.
+ */
+struct RetiredValues
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<const void>> current;
+  std::vector<std::shared_ptr<const void>> previous;
+};
+
+RetiredValues &GetRetiredValues() noexcept
+{
+  // Never destroyed, for the same reason as the shards.
+  static RetiredValues *retired_values = new RetiredValues;
+  return *retired_values;
+}
+
+size_t GetThreadIndex() noexcept
+{
+  static std::atomic<size_t> next_thread_index{0};
+  thread_local size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index;
+}
+
+/**
+ * @return true if no reader of the given epoch parity remains.
+ */
+bool IsQuiescent(size_t parity) noexcept
+{
+  for (auto &shard : shards)
+  {
+    if (shard.readers[parity].load() != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Advances the epoch as far as the readers allow, moving the values that are
+ * safe to release to released. The mutex of the retired values must be held.
+ *
+ * The epoch advances once no reader of the previous epoch remains. Readers
+ * which may have read a value retired in epoch e entered at epoch e at the
+ * latest, so the value is released when the epoch advances from e + 1, after
+ * the readers of both parities were seen to leave.
+ */
+void Advance(RetiredValues &retired_values, std::vector<std::shared_ptr<const void>> &released)
+{
+  for (int i = 0; i < 2 && !(retired_values.current.empty() && retired_values.previous.empty());
+       ++i)
+  {
+    const uint64_t current_epoch = epoch.load();
+    if (!IsQuiescent((current_epoch + 1) & 1))
+    {
+      return;
+    }
+    released.insert(released.end(), retired_values.previous.begin(),
+                    retired_values.previous.end());
+    retired_values.previous.clear();
+    retired_values.previous.swap(retired_values.current);
+    num_retired.store(retired_values.previous.size(), std::memory_order_relaxed);
+    epoch.store(current_epoch + 1);
+  }
+}
+}  // namespace
+
+EpochGuard::EpochGuard() noexcept
+{
+  auto &shard = shards[GetThreadIndex() % kNumShards];
+  counter_    = &shard.readers[epoch.load() & 1];
+  counter_->fetch_add(1);
+}
+
+void EpochGuard::Release() noexcept
+{
+  if (counter_ == nullptr)
+  {
+    return;
+  }
+  counter_->fetch_sub(1);
+  counter_ = nullptr;
+
+  // Values retired while guards were held are released by a pass at most
+  // every kAdvanceInterval, so that releasing a guard does not take the lock
+  // or scan the shards while values are waiting.
+  if (num_retired.load(std::memory_order_relaxed) == 0)
+  {
+    return;
+  }
+  const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+  int64_t last = last_advance_time.load(std::memory_order_relaxed);
+  if (now - last < kAdvanceInterval ||
+      !last_advance_time.compare_exchange_strong(last, now, std::memory_order_relaxed))
+  {
+    return;
+  }
+  auto &retired_values = GetRetiredValues();
+  std::vector<std::shared_ptr<const void>> released;
+  {
+    std::unique_lock<std::mutex> lock{retired_values.mutex, std::try_to_lock};
+    if (!lock.owns_lock())
+    {
+      return;
+    }
+    Advance(retired_values, released);
+  }
+}
+
+void RetireAfterGracePeriod(std::shared_ptr<const void> value) noexcept
+{
+  auto &retired_values = GetRetiredValues();
+  // Released values may retire other values when destroyed, so they are
+  // destroyed after the mutex is unlocked.
+  std::vector<std::shared_ptr<const void>> released;
+  {
+    std::lock_guard<std::mutex> guard{retired_values.mutex};
+    retired_values.current.push_back(std::move(value));
+    num_retired.store(retired_values.current.size() + retired_values.previous.size(),
+                      std::memory_order_relaxed);
+    Advance(retired_values, released);
+  }
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
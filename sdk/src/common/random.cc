@@ -1,6 +1,7 @@
 #include "src/common/random.h"
 #include "src/common/platform/fork.h"
 
+#include <atomic>
 #include <cstring>
 #include <random>
 
@@ -41,6 +42,82 @@ class TlsRandomNumberGenerator
 };
 
 thread_local FastRandomNumberGenerator TlsRandomNumberGenerator::engine_{};
+
+// The number of independent xorshift128+ generators used to fill a block. They
+// are stepped in lockstep, so that filling a block is a loop without dependencies
+// between neighbouring values, which compilers vectorize.
+constexpr size_t kBlockLanes = 4;
+
+// The number of random numbers pre-generated at once for a thread.
+constexpr size_t kBlockSize = 64;
+
+// Incremented in the child process after every fork, so that child processes
+// do not hand out numbers pre-generated by their parent.
+std::atomic<uint64_t> fork_generation{0};
+
+void OnForkChild() noexcept
+{
+  fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+// A block of pre-generated random numbers. It is trivially constructible, so
+// that accessing the thread_local instance does not need an initialization check.
+struct RandomBlock
+{
+  uint64_t state_a[kBlockLanes];
+  uint64_t state_b[kBlockLanes];
+  uint64_t values[kBlockSize];
+
+  // The number of values not yet handed out, taken from the end of values.
+  size_t remaining;
+
+  // One plus the fork generation the generators were seeded in, 0 if not yet seeded.
+  uint64_t seed_generation;
+
+  void Seed(uint64_t generation) noexcept
+  {
+    static const bool fork_handler_registered =
+        platform::AtFork(nullptr, nullptr, OnForkChild) == 0;
+    (void)fork_handler_registered;
+
+    std::random_device random_device;
+    std::seed_seq seed_seq{random_device(), random_device(), random_device(), random_device()};
+    FastRandomNumberGenerator engine{seed_seq};
+    for (size_t lane = 0; lane < kBlockLanes; ++lane)
+    {
+      // xorshift128+ must not be seeded with all zeros.
+      do
+      {
+        state_a[lane] = engine();
+        state_b[lane] = engine();
+      } while (state_a[lane] == 0 && state_b[lane] == 0);
+    }
+    remaining       = 0;
+    seed_generation = generation + 1;
+  }
+
+  void Refill() noexcept
+  {
+    for (size_t i = 0; i < kBlockSize; i += kBlockLanes)
+    {
+      for (size_t lane = 0; lane < kBlockLanes; ++lane)
+      {
+        // xorshift128+, as in FastRandomNumberGenerator
+        uint64_t t    = state_a[lane];
+        uint64_t s    = state_b[lane];
+        state_a[lane] = s;
+        t ^= t << 23;
+        t ^= t >> 17;
+        t ^= s ^ (s >> 26);
+        state_b[lane]    = t;
+        values[i + lane] = t + s;
+      }
+    }
+    remaining = kBlockSize;
+  }
+};
+
+thread_local RandomBlock random_block;
 }  // namespace
 
 FastRandomNumberGenerator &Random::GetRandomNumberGenerator() noexcept
@@ -71,6 +148,24 @@ void Random::GenerateRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) no
     }
   }
 }
+
+void Random::GenerateRandomBatch(opentelemetry::nostd::span<uint64_t> values) noexcept
+{
+  auto &block     = random_block;
+  auto generation = fork_generation.load(std::memory_order_relaxed);
+  if (block.seed_generation != generation + 1)
+  {
+    block.Seed(generation);
+  }
+  for (auto &value : values)
+  {
+    if (block.remaining == 0)
+    {
+      block.Refill();
+    }
+    value = block.values[--block.remaining];
+  }
+}
 }  // namespace common
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -27,6 +27,17 @@ class Random
    */
   static void GenerateRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) noexcept;
 
+  /**
+   * Fill the passed span with random numbers taken from a block of numbers
+   * pre-generated for the calling thread. The block is refilled in bulk once it
+   * is used up, which makes this considerably cheaper per number than
+   * GenerateRandom64 when called frequently, e.g. to generate trace and span
+   * ids. The block is discarded in a child process after fork.
+   *
+   * @param values A span of numbers.
+   */
+  static void GenerateRandomBatch(opentelemetry::nostd::span<uint64_t> values) noexcept;
+
 private:
   /**
    * @return a seeded thread-local random number generator.
@@ -15,7 +15,10 @@
  */
 
 #include "opentelemetry/sdk/logs/batch_log_processor.h"
+#include "opentelemetry/sdk/logs/log_record.h"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 using opentelemetry::sdk::common::AtomicUniquePtr;
 using opentelemetry::sdk::common::CircularBufferRange;
@@ -25,18 +28,70 @@ namespace sdk
 {
 namespace logs
 {
+namespace
+{
+BatchLogProcessorOptions MakeOptions(const size_t max_queue_size,
+                                     const std::chrono::milliseconds scheduled_delay_millis,
+                                     const size_t max_export_batch_size)
+{
+  BatchLogProcessorOptions options;
+  options.max_queue_size         = max_queue_size;
+  options.scheduled_delay_millis = scheduled_delay_millis;
+  options.max_export_batch_size  = max_export_batch_size;
+  return options;
+}
+
+common::BatchQueue<Recordable>::Priority GetPriority(const BatchLogProcessorOptions &options)
+{
+  if (options.priority)
+  {
+    return options.priority;
+  }
+  return [](const Recordable &recordable) {
+    auto log_record = dynamic_cast<const LogRecord *>(&recordable);
+    if (log_record == nullptr)
+    {
+      return 0;
+    }
+    return static_cast<int>(log_record->GetSeverity());
+  };
+}
+
+size_t GetEstimatedSize(const Recordable &recordable)
+{
+  return recordable.GetEstimatedSize();
+}
+}  // namespace
+
 BatchLogProcessor::BatchLogProcessor(std::unique_ptr<LogExporter> &&exporter,
                                      const size_t max_queue_size,
                                      const std::chrono::milliseconds scheduled_delay_millis,
                                      const size_t max_export_batch_size)
-    : exporter_(std::move(exporter)),
-      max_queue_size_(max_queue_size),
-      scheduled_delay_millis_(scheduled_delay_millis),
-      max_export_batch_size_(max_export_batch_size),
-      buffer_(max_queue_size_),
-      worker_thread_(&BatchLogProcessor::DoBackgroundWork, this)
+    : BatchLogProcessor(std::move(exporter),
+                        MakeOptions(max_queue_size, scheduled_delay_millis, max_export_batch_size))
 {}
 
+BatchLogProcessor::BatchLogProcessor(std::unique_ptr<LogExporter> &&exporter,
+                                     const BatchLogProcessorOptions &options)
+    : exporter_(std::move(exporter)),
+      max_queue_size_(options.max_queue_size),
+      scheduled_delay_millis_(options.scheduled_delay_millis),
+      max_export_batch_size_(options.max_export_batch_size),
+      max_export_batch_size_bytes_(options.max_export_batch_size_bytes),
+      buffer_(max_queue_size_,
+              1,
+              options.overflow_policy,
+              options.max_block_time,
+              GetPriority(options),
+              options.max_queue_size_bytes,
+              GetEstimatedSize),
+      retry_buffer_(options.retry_options, GetEstimatedSize),
+      executor_(options.executor ? options.executor : std::make_shared<common::Executor>())
+{
+  worker_.reset(new common::ScheduledTask(
+      executor_, [this] { return DoBackgroundWork(); }, scheduled_delay_millis_));
+}
+
 std::unique_ptr<Recordable> BatchLogProcessor::MakeRecordable() noexcept
 {
   return exporter_->MakeRecordable();
@@ -49,18 +104,12 @@ void BatchLogProcessor::OnReceive(std::unique_ptr<Recordable> &&record) noexcept
     return;
   }
 
-  if (buffer_.Add(record) == false)
-  {
-    return;
-  }
-
   // If the queue gets at least half full a preemptive notification is
-  // sent to the worker thread to start a new export cycle.
-  if (buffer_.size() >= max_queue_size_ / 2)
-  {
-    // signal the worker thread
-    cv_.notify_one();
-  }
+  // sent to the worker task to start a new export cycle.
+  buffer_.Add(record, [this] {
+    // signal the worker task
+    worker_->Wake();
+  });
 }
 
 bool BatchLogProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
@@ -70,72 +119,82 @@ bool BatchLogProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
     return false;
   }
 
-  is_force_flush_ = true;
+  common::Deadline deadline(timeout);
+  std::unique_lock<std::mutex> lk(cv_m_);
+  const uint64_t flush_sequence = ++flush_requested_;
+  worker_->Wake();
 
-  // Keep attempting to wake up the worker thread
-  while (is_force_flush_.load() == true)
+  // Wait for the worker task to export everything queued before this call.
+  // The flush failed if batches were left waiting for a retry.
+  return deadline.Wait(force_flush_cv_, lk,
+                       [&] { return flush_completed_ >= flush_sequence; }) &&
+         flush_succeeded_ >= flush_sequence;
+}
+
+common::Executor::Clock::duration BatchLogProcessor::DoBackgroundWork()
+{
+  uint64_t flush_sequence;
   {
-    cv_.notify_one();
+    std::lock_guard<std::mutex> guard(cv_m_);
+    flush_sequence = flush_requested_;
   }
 
-  // Now wait for the worker thread to signal back from the Export method
-  std::unique_lock<std::mutex> lk(force_flush_cv_m_);
-  while (is_force_flush_notified_.load() == false)
+  if (is_shutdown_.load() == true)
   {
-    force_flush_cv_.wait(lk);
+    // Run again when the next retry is due, rather than sleeping on the
+    // executor thread.
+    auto delay = DrainQueue();
+    if (delay != (common::Executor::Clock::duration::max)())
+    {
+      return delay;
+    }
+    // Also complete the flushes requested after this point.
+    CompleteFlush((std::numeric_limits<uint64_t>::max)(),
+                  buffer_.empty() && retry_buffer_.empty());
+    return delay;
   }
 
-  // Notify the worker thread
-  is_force_flush_notified_ = false;
+  // Only the worker task writes `flush_completed_`.
+  bool was_force_flush_called = flush_sequence != flush_completed_;
 
-  return true;
-}
-
-void BatchLogProcessor::DoBackgroundWork()
-{
-  auto timeout = scheduled_delay_millis_;
+  // A force flush retries the failed batches without waiting for their backoff.
+  Retry(was_force_flush_called ? (common::Executor::Clock::time_point::max)()
+                               : common::Executor::Clock::now());
 
-  while (true)
+  // If the buffer was empty during the entire scheduled delay, wait for
+  // another delay. If the task was woken up early, we export only if `buffer_`
+  // is not empty. This is acceptable because batching is a best mechanism
+  // effort here.
+  if (was_force_flush_called == false && buffer_.empty() == true)
   {
-    // Wait for `timeout` milliseconds
-    std::unique_lock<std::mutex> lk(cv_m_);
-    cv_.wait_for(lk, timeout);
+    return GetNextDelay(scheduled_delay_millis_);
+  }
 
-    if (is_shutdown_.load() == true)
-    {
-      DrainQueue();
-      return;
-    }
+  auto start = std::chrono::steady_clock::now();
+  Export(was_force_flush_called);
+  auto end      = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+  if (was_force_flush_called == true)
+  {
+    CompleteFlush(flush_sequence, retry_buffer_.empty());
+  }
 
-    bool was_force_flush_called = is_force_flush_.load();
+  // Subtract the duration of this export call from the next delay.
+  return GetNextDelay(scheduled_delay_millis_ - duration);
+}
 
-    // Check if this export was the result of a force flush.
-    if (was_force_flush_called == true)
-    {
-      // Since this export was the result of a force flush, signal the
-      // main thread that the worker thread has been notified
-      is_force_flush_ = false;
-    }
-    else
+void BatchLogProcessor::CompleteFlush(uint64_t flush_sequence, bool succeeded)
+{
+  {
+    std::lock_guard<std::mutex> guard(cv_m_);
+    flush_completed_ = flush_sequence;
+    if (succeeded)
     {
-      // If the buffer was empty during the entire `timeout` time interval,
-      // go back to waiting. If this was a spurious wake-up, we export only if
-      // `buffer_` is not empty. This is acceptable because batching is a best
-      // mechanism effort here.
-      if (buffer_.empty() == true)
-      {
-        continue;
-      }
+      flush_succeeded_ = flush_sequence;
     }
-
-    auto start = std::chrono::steady_clock::now();
-    Export(was_force_flush_called);
-    auto end      = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-
-    // Subtract the duration of this export call from the next `timeout`.
-    timeout = scheduled_delay_millis_ - duration;
   }
+  force_flush_cv_.notify_all();
 }
 
 void BatchLogProcessor::Export(const bool was_force_flush_called)
@@ -164,40 +223,103 @@ void BatchLogProcessor::Export(const bool was_force_flush_called)
                     });
                   });
 
-  exporter_->Export(
-      nostd::span<std::unique_ptr<Recordable>>(records_arr.data(), records_arr.size()));
+  common::ForEachExportBatch(
+      nostd::span<std::unique_ptr<Recordable>>(records_arr.data(), records_arr.size()),
+      max_export_batch_size_, max_export_batch_size_bytes_, GetEstimatedSize,
+      [this](nostd::span<std::unique_ptr<Recordable>> batch) { ExportOrRetry(batch); });
+}
 
-  // Notify the main thread in case this export was the result of a force flush.
-  if (was_force_flush_called == true)
+void BatchLogProcessor::ExportOrRetry(nostd::span<std::unique_ptr<Recordable>> batch)
+{
+  if (exporter_->Export(batch) == common::ExportResult::kFailureRetryable)
   {
-    is_force_flush_notified_ = true;
-    while (is_force_flush_notified_.load() == true)
-    {
-      force_flush_cv_.notify_one();
-    }
+    retry_buffer_.Add(batch, 1);
   }
 }
 
-void BatchLogProcessor::DrainQueue()
+void BatchLogProcessor::Retry(common::Executor::Clock::time_point time)
+{
+  retry_buffer_.Retry(time, [this](nostd::span<std::unique_ptr<Recordable>> batch) {
+    return exporter_->Export(batch);
+  });
+}
+
+common::Executor::Clock::duration BatchLogProcessor::GetNextDelay(
+    common::Executor::Clock::duration delay) const
 {
-  while (buffer_.empty() == false)
+  auto retry_time = retry_buffer_.next_retry_time();
+  if (retry_time == (common::Executor::Clock::time_point::max)())
+  {
+    return delay;
+  }
+  return (std::min)(delay, retry_time - common::Executor::Clock::now());
+}
+
+common::Executor::Clock::duration BatchLogProcessor::DrainQueue()
+{
+  while (buffer_.empty() == false && shutdown_deadline_.IsExpired() == false)
   {
     Export(false);
   }
+  Retry(common::Executor::Clock::now());
+
+  // The failed batches left are retried after their backoff, as long as the
+  // retry is due before the deadline.
+  if (retry_buffer_.empty() == true)
+  {
+    return (common::Executor::Clock::duration::max)();
+  }
+  auto delay = retry_buffer_.next_retry_time() - common::Executor::Clock::now();
+  if (std::chrono::duration_cast<std::chrono::microseconds>(delay) >=
+      shutdown_deadline_.GetRemaining())
+  {
+    return (common::Executor::Clock::duration::max)();
+  }
+  return delay;
 }
 
 bool BatchLogProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
 {
-  is_shutdown_.store(true);
+  {
+    std::lock_guard<std::mutex> guard(cv_m_);
+    if (is_shutdown_.load() == true)
+    {
+      return false;
+    }
+    shutdown_deadline_ = common::Deadline(timeout);
+    is_shutdown_.store(true);
+  }
+
+  // Wait for the worker task to drain the queue, and stop it.
+  worker_->Wake();
+  {
+    std::unique_lock<std::mutex> lk(cv_m_);
+    shutdown_deadline_.Wait(force_flush_cv_, lk, [this] {
+      return flush_completed_ == (std::numeric_limits<uint64_t>::max)();
+    });
+  }
+  bool is_stopped = worker_->Stop(shutdown_deadline_);
+
+  // Release the flushes still waiting if the queue was not drained in time.
+  CompleteFlush((std::numeric_limits<uint64_t>::max)(), false);
+
+  // An export still running at the deadline is abandoned. The destructor waits
+  // for it before shutting the exporter down.
+  if (is_stopped == false)
+  {
+    is_work_abandoned_ = true;
+    return false;
+  }
 
-  cv_.notify_one();
-  worker_thread_.join();
+  // The queue was drained unless the deadline expired, or log records were left
+  // waiting for a retry.
+  bool is_drained = shutdown_deadline_.IsExpired() == false && retry_buffer_.empty();
   if (exporter_ != nullptr)
   {
-    return exporter_->Shutdown();
+    return exporter_->Shutdown(shutdown_deadline_.GetRemaining()) && is_drained;
   }
 
-  return true;
+  return is_drained;
 }
 
 BatchLogProcessor::~BatchLogProcessor()
@@ -206,6 +328,15 @@ BatchLogProcessor::~BatchLogProcessor()
   {
     Shutdown();
   }
+
+  if (is_work_abandoned_)
+  {
+    worker_->Stop();
+    if (exporter_ != nullptr)
+    {
+      exporter_->Shutdown();
+    }
+  }
 }
 
 }  // namespace logs
@@ -0,0 +1,62 @@
+/*
+ * Copyright The OpenTelemetry Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "opentelemetry/sdk/logs/circuit_breaker_log_exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+CircuitBreakerLogExporter::CircuitBreakerLogExporter(
+    std::unique_ptr<LogExporter> &&exporter,
+    const common::CircuitBreakerOptions &options)
+    : exporter_{std::move(exporter)}, circuit_breaker_{options}
+{}
+
+std::unique_ptr<Recordable> CircuitBreakerLogExporter::MakeRecordable() noexcept
+{
+  return exporter_->MakeRecordable();
+}
+
+sdk::common::ExportResult CircuitBreakerLogExporter::Export(
+    const nostd::span<std::unique_ptr<Recordable>> &records) noexcept
+{
+  if (circuit_breaker_.AllowExport() == false)
+  {
+    if (circuit_breaker_.options().retry_rejected)
+    {
+      return sdk::common::ExportResult::kFailureRetryable;
+    }
+    for (auto &record : records)
+    {
+      record.reset();
+    }
+    return sdk::common::ExportResult::kFailure;
+  }
+
+  auto result = exporter_->Export(records);
+  circuit_breaker_.RecordResult(result);
+  return result;
+}
+
+bool CircuitBreakerLogExporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  return exporter_->Shutdown(timeout);
+}
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -48,7 +48,8 @@ void Logger::Log(opentelemetry::logs::Severity severity,
                  core::SystemTimestamp timestamp) noexcept
 {
   // If this logger does not have a processor, no need to create a log record
-  auto processor = logger_provider_.lock()->GetProcessor();
+  auto logger_provider = logger_provider_.lock();
+  auto processor       = logger_provider->GetProcessor();
   if (processor == nullptr)
   {
     return;
@@ -64,6 +65,10 @@ void Logger::Log(opentelemetry::logs::Severity severity,
   }
 
   // Populate recordable fields
+  if (timestamp == core::SystemTimestamp())
+  {
+    timestamp = logger_provider->GetClock().SystemNow();
+  }
   recordable->SetTimestamp(timestamp);
   recordable->SetSeverity(severity);
   recordable->SetName(name);
@@ -22,7 +22,9 @@ namespace sdk
 namespace logs
 {
 
-LoggerProvider::LoggerProvider() noexcept : processor_{nullptr} {}
+LoggerProvider::LoggerProvider(std::shared_ptr<opentelemetry::sdk::common::Clock> clock) noexcept
+    : processor_{nullptr}, clock_{clock}
+{}
 
 opentelemetry::nostd::shared_ptr<opentelemetry::logs::Logger> LoggerProvider::GetLogger(
     opentelemetry::nostd::string_view name,
@@ -76,6 +78,11 @@ void LoggerProvider::SetProcessor(std::shared_ptr<LogProcessor> processor) noexc
 {
   processor_.store(processor);
 }
+
+opentelemetry::sdk::common::Clock &LoggerProvider::GetClock() const noexcept
+{
+  return *clock_;
+}
 }  // namespace logs
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,56 @@
+/*
+ * Copyright The OpenTelemetry Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "opentelemetry/sdk/logs/spooling_log_exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+SpoolingLogExporter::SpoolingLogExporter(std::unique_ptr<EncodingLogExporter> &&exporter,
+                                         const common::DiskSpoolOptions &options)
+    : exporter_{std::move(exporter)},
+      spooler_{options,
+               [this](nostd::string_view encoded) { return exporter_->ExportEncoded(encoded); }}
+{}
+
+std::unique_ptr<Recordable> SpoolingLogExporter::MakeRecordable() noexcept
+{
+  return exporter_->MakeRecordable();
+}
+
+sdk::common::ExportResult SpoolingLogExporter::Export(
+    const nostd::span<std::unique_ptr<Recordable>> &records) noexcept
+{
+  std::string data;
+  if (exporter_->Encode(records, &data) == false)
+  {
+    return sdk::common::ExportResult::kFailure;
+  }
+  return spooler_.Export(std::move(data));
+}
+
+bool SpoolingLogExporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  // Replay the backlog before shutting the exporter down.
+  common::Deadline deadline(timeout);
+  spooler_.Shutdown(deadline);
+  return exporter_->Shutdown(deadline.GetRemaining());
+}
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
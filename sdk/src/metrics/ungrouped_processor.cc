@@ -8,7 +8,10 @@ namespace sdk
 namespace metrics
 {
 
-UngroupedMetricsProcessor::UngroupedMetricsProcessor(bool stateful)
+UngroupedMetricsProcessor::UngroupedMetricsProcessor(
+    bool stateful,
+    std::shared_ptr<opentelemetry::sdk::common::Clock> clock)
+    : clock_(std::move(clock))
 {
   stateful_ = stateful;
 }
@@ -1,8 +1,11 @@
 #include "opentelemetry/sdk/trace/batch_span_processor.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
 
+#include <algorithm>
+#include <limits>
+#include <thread>
 #include <vector>
 using opentelemetry::sdk::common::AtomicUniquePtr;
-using opentelemetry::sdk::common::CircularBuffer;
 using opentelemetry::sdk::common::CircularBufferRange;
 using opentelemetry::trace::SpanContext;
 
@@ -11,15 +14,68 @@ namespace sdk
 {
 namespace trace
 {
+namespace
+{
+size_t GetNumQueueShards(const BatchSpanProcessorOptions &options) noexcept
+{
+  if (options.num_queue_shards != 0)
+  {
+    return options.num_queue_shards;
+  }
+  return (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+common::BatchQueue<Recordable>::Priority GetPriority(const BatchSpanProcessorOptions &options)
+{
+  if (options.priority)
+  {
+    return options.priority;
+  }
+  return [](const Recordable &recordable) {
+    auto span_data = SharedSpanData::FromRecordable(recordable);
+    if (span_data != nullptr && span_data->GetStatus() == opentelemetry::trace::StatusCode::kError)
+    {
+      return 1;
+    }
+    return 0;
+  };
+}
+
+size_t GetEstimatedSize(const Recordable &recordable)
+{
+  return recordable.GetEstimatedSize();
+}
+}  // namespace
+
 BatchSpanProcessor::BatchSpanProcessor(std::unique_ptr<SpanExporter> &&exporter,
                                        const BatchSpanProcessorOptions &options)
     : exporter_(std::move(exporter)),
       max_queue_size_(options.max_queue_size),
       schedule_delay_millis_(options.schedule_delay_millis),
       max_export_batch_size_(options.max_export_batch_size),
-      buffer_(max_queue_size_),
-      worker_thread_(&BatchSpanProcessor::DoBackgroundWork, this)
-{}
+      max_export_batch_size_bytes_(options.max_export_batch_size_bytes),
+      buffer_(max_queue_size_,
+              GetNumQueueShards(options),
+              options.overflow_policy,
+              options.max_block_time,
+              GetPriority(options),
+              options.max_queue_size_bytes,
+              GetEstimatedSize),
+      retry_buffer_(options.retry_options, GetEstimatedSize),
+      max_concurrent_exports_((std::max)(options.max_concurrent_exports, size_t{1})),
+      executor_(options.executor ? options.executor : std::make_shared<common::Executor>())
+{
+  if (max_concurrent_exports_ > 1)
+  {
+    num_export_threads_ = max_concurrent_exports_;
+    for (size_t i = 0; i < max_concurrent_exports_; ++i)
+    {
+      export_threads_.emplace_back(&BatchSpanProcessor::DoExportWork, this);
+    }
+  }
+  worker_.reset(new common::ScheduledTask(
+      executor_, [this] { return DoBackgroundWork(); }, schedule_delay_millis_));
+}
 
 std::unique_ptr<Recordable> BatchSpanProcessor::MakeRecordable() noexcept
 {
@@ -38,18 +94,12 @@ void BatchSpanProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
     return;
   }
 
-  if (buffer_.Add(span) == false)
-  {
-    return;
-  }
-
-  // If the queue gets at least half full a preemptive notification is
-  // sent to the worker thread to start a new export cycle.
-  if (buffer_.size() >= max_queue_size_ / 2)
-  {
-    // signal the worker thread
-    cv_.notify_one();
-  }
+  // If the shard of this thread gets at least half full a preemptive
+  // notification is sent to the worker task to start a new export cycle.
+  buffer_.Add(span, [this] {
+    // signal the worker task
+    worker_->Wake();
+  });
 }
 
 bool BatchSpanProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
@@ -59,72 +109,82 @@ bool BatchSpanProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
     return false;
   }
 
-  is_force_flush_ = true;
+  common::Deadline deadline(timeout);
+  std::unique_lock<std::mutex> lk(cv_m_);
+  const uint64_t flush_sequence = ++flush_requested_;
+  worker_->Wake();
+
+  // Wait for the worker task to export everything queued before this call. The
+  // flush failed if batches were left waiting for a retry.
+  return deadline.Wait(force_flush_cv_, lk,
+                       [&] { return flush_completed_ >= flush_sequence; }) &&
+         flush_succeeded_ >= flush_sequence;
+}
 
-  // Keep attempting to wake up the worker thread
-  while (is_force_flush_.load() == true)
+common::Executor::Clock::duration BatchSpanProcessor::DoBackgroundWork()
+{
+  uint64_t flush_sequence;
   {
-    cv_.notify_one();
+    std::lock_guard<std::mutex> guard(cv_m_);
+    flush_sequence = flush_requested_;
   }
 
-  // Now wait for the worker thread to signal back from the Export method
-  std::unique_lock<std::mutex> lk(force_flush_cv_m_);
-  while (is_force_flush_notified_.load() == false)
+  if (is_shutdown_.load() == true)
   {
-    force_flush_cv_.wait(lk);
+    // Run again when the next retry is due, rather than sleeping on the
+    // executor thread.
+    auto delay = DrainQueue();
+    if (delay != (common::Executor::Clock::duration::max)())
+    {
+      return delay;
+    }
+    // Also complete the flushes requested after this point.
+    CompleteFlush((std::numeric_limits<uint64_t>::max)(),
+                  buffer_.empty() && retry_buffer_.empty());
+    return delay;
   }
 
-  // Notify the worker thread
-  is_force_flush_notified_ = false;
+  // Only the worker task writes `flush_completed_`.
+  bool was_force_flush_called = flush_sequence != flush_completed_;
 
-  return true;
-}
-
-void BatchSpanProcessor::DoBackgroundWork()
-{
-  auto timeout = schedule_delay_millis_;
+  // A force flush retries the failed batches without waiting for their backoff.
+  Retry(was_force_flush_called ? (common::Executor::Clock::time_point::max)()
+                               : common::Executor::Clock::now());
 
-  while (true)
+  // If the buffer was empty during the entire scheduled delay, wait for
+  // another delay. If the task was woken up early, we export only if `buffer_`
+  // is not empty. This is acceptable because batching is a best mechanism
+  // effort here.
+  if (was_force_flush_called == false && buffer_.empty() == true)
   {
-    // Wait for `timeout` milliseconds
-    std::unique_lock<std::mutex> lk(cv_m_);
-    cv_.wait_for(lk, timeout);
+    return GetNextDelay(schedule_delay_millis_);
+  }
 
-    if (is_shutdown_.load() == true)
-    {
-      DrainQueue();
-      return;
-    }
+  auto start = std::chrono::steady_clock::now();
+  Export(was_force_flush_called);
+  auto end      = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-    bool was_force_flush_called = is_force_flush_.load();
+  if (was_force_flush_called == true)
+  {
+    CompleteFlush(flush_sequence, retry_buffer_.empty());
+  }
 
-    // Check if this export was the result of a force flush.
-    if (was_force_flush_called == true)
-    {
-      // Since this export was the result of a force flush, signal the
-      // main thread that the worker thread has been notified
-      is_force_flush_ = false;
-    }
-    else
+  // Subtract the duration of this export call from the next delay.
+  return GetNextDelay(schedule_delay_millis_ - duration);
+}
+
+void BatchSpanProcessor::CompleteFlush(uint64_t flush_sequence, bool succeeded)
+{
+  {
+    std::lock_guard<std::mutex> guard(cv_m_);
+    flush_completed_ = flush_sequence;
+    if (succeeded)
     {
-      // If the buffer was empty during the entire `timeout` time interval,
-      // go back to waiting. If this was a spurious wake-up, we export only if
-      // `buffer_` is not empty. This is acceptable because batching is a best
-      // mechanism effort here.
-      if (buffer_.empty() == true)
-      {
-        continue;
-      }
+      flush_succeeded_ = flush_sequence;
     }
-
-    auto start = std::chrono::steady_clock::now();
-    Export(was_force_flush_called);
-    auto end      = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-
-    // Subtract the duration of this export call from the next `timeout`.
-    timeout = schedule_delay_millis_ - duration;
   }
+  force_flush_cv_.notify_all();
 }
 
 void BatchSpanProcessor::Export(const bool was_force_flush_called)
@@ -153,39 +213,212 @@ void BatchSpanProcessor::Export(const bool was_force_flush_called)
                     });
                   });
 
-  exporter_->Export(nostd::span<std::unique_ptr<Recordable>>(spans_arr.data(), spans_arr.size()));
+  common::ForEachExportBatch(
+      nostd::span<std::unique_ptr<Recordable>>(spans_arr.data(), spans_arr.size()),
+      max_export_batch_size_, max_export_batch_size_bytes_, GetEstimatedSize,
+      [this](nostd::span<std::unique_ptr<Recordable>> batch) { ExportBatch(batch); });
 
-  // Notify the main thread in case this export was the result of a force flush.
+  // A force flush is complete when all its batches are exported.
   if (was_force_flush_called == true)
   {
-    is_force_flush_notified_ = true;
-    while (is_force_flush_notified_.load() == true)
+    WaitForExports();
+  }
+}
+
+void BatchSpanProcessor::ExportBatch(nostd::span<std::unique_ptr<Recordable>> batch,
+                                     size_t attempts)
+{
+  if (max_concurrent_exports_ == 1)
+  {
+    ExportOrRetry(batch, attempts);
+    return;
+  }
+  if (batch.empty())
+  {
+    return;
+  }
+
+  PendingBatch pending_batch;
+  pending_batch.spans.reserve(batch.size());
+  for (auto &span : batch)
+  {
+    pending_batch.spans.push_back(std::move(span));
+  }
+  pending_batch.attempts = attempts;
+
+  std::unique_lock<std::mutex> lk(export_m_);
+  export_cv_.wait(lk, [this] {
+    return num_in_flight_ < max_concurrent_exports_ || is_export_stopped_;
+  });
+  // The export threads are stopped once Shutdown abandons the worker task at
+  // its deadline, and the batches left are discarded.
+  if (is_export_stopped_)
+  {
+    return;
+  }
+  ++num_in_flight_;
+  pending_batches_.push_back(std::move(pending_batch));
+  lk.unlock();
+  export_cv_.notify_all();
+}
+
+void BatchSpanProcessor::ExportOrRetry(nostd::span<std::unique_ptr<Recordable>> batch,
+                                       size_t attempts)
+{
+  auto start  = std::chrono::steady_clock::now();
+  auto result = exporter_->Export(batch);
+  export_latency_.store(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count(),
+                        std::memory_order_relaxed);
+  if (result == common::ExportResult::kFailureRetryable)
+  {
+    retry_buffer_.Add(batch, attempts + 1);
+  }
+}
+
+void BatchSpanProcessor::Retry(common::Executor::Clock::time_point time)
+{
+  // Retried batches count against max_concurrent_exports like other batches.
+  retry_buffer_.TakeDue(time, [this](std::vector<std::unique_ptr<Recordable>> &batch,
+                                     size_t attempts) {
+    ExportBatch(nostd::span<std::unique_ptr<Recordable>>(batch.data(), batch.size()), attempts);
+  });
+}
+
+common::Executor::Clock::duration BatchSpanProcessor::GetNextDelay(
+    common::Executor::Clock::duration delay) const
+{
+  auto retry_time = retry_buffer_.next_retry_time();
+  if (retry_time == (common::Executor::Clock::time_point::max)())
+  {
+    return delay;
+  }
+  return (std::min)(delay, retry_time - common::Executor::Clock::now());
+}
+
+void BatchSpanProcessor::WaitForExports()
+{
+  std::unique_lock<std::mutex> lk(export_m_);
+  export_cv_.wait(lk, [this] { return num_in_flight_ == 0; });
+}
+
+void BatchSpanProcessor::DoExportWork()
+{
+  while (true)
+  {
+    PendingBatch batch;
+    {
+      std::unique_lock<std::mutex> lk(export_m_);
+      export_cv_.wait(lk, [this] { return !pending_batches_.empty() || is_export_stopped_; });
+
+      // Pending batches are exported before stopping.
+      if (pending_batches_.empty())
+      {
+        --num_export_threads_;
+        export_cv_.notify_all();
+        return;
+      }
+      batch = std::move(pending_batches_.front());
+      pending_batches_.pop_front();
+    }
+
+    // Batches left after the shutdown deadline are discarded.
+    if (is_shutdown_.load() == false || shutdown_deadline_.IsExpired() == false)
+    {
+      ExportOrRetry(
+          nostd::span<std::unique_ptr<Recordable>>(batch.spans.data(), batch.spans.size()),
+          batch.attempts);
+    }
+
     {
-      force_flush_cv_.notify_one();
+      std::lock_guard<std::mutex> guard(export_m_);
+      --num_in_flight_;
     }
+    export_cv_.notify_all();
   }
 }
 
-void BatchSpanProcessor::DrainQueue()
+common::Executor::Clock::duration BatchSpanProcessor::DrainQueue()
 {
-  while (buffer_.empty() == false)
+  while (buffer_.empty() == false && shutdown_deadline_.IsExpired() == false)
   {
     Export(false);
   }
+  Retry(common::Executor::Clock::now());
+  WaitForExports();
+
+  // The failed batches left are retried after their backoff, as long as the
+  // retry is due before the deadline.
+  if (retry_buffer_.empty() == true)
+  {
+    return (common::Executor::Clock::duration::max)();
+  }
+  auto delay = retry_buffer_.next_retry_time() - common::Executor::Clock::now();
+  if (std::chrono::duration_cast<std::chrono::microseconds>(delay) >=
+      shutdown_deadline_.GetRemaining())
+  {
+    return (common::Executor::Clock::duration::max)();
+  }
+  return delay;
 }
 
 bool BatchSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
 {
-  is_shutdown_.store(true);
+  {
+    std::lock_guard<std::mutex> guard(cv_m_);
+    if (is_shutdown_.load() == true)
+    {
+      return false;
+    }
+    shutdown_deadline_ = common::Deadline(timeout);
+    is_shutdown_.store(true);
+  }
+
+  // Wait for the worker task to drain the queue, and stop it.
+  worker_->Wake();
+  {
+    std::unique_lock<std::mutex> lk(cv_m_);
+    shutdown_deadline_.Wait(force_flush_cv_, lk, [this] {
+      return flush_completed_ == (std::numeric_limits<uint64_t>::max)();
+    });
+  }
+  bool is_stopped = worker_->Stop(shutdown_deadline_);
+
+  // Release the flushes still waiting if the queue was not drained in time.
+  CompleteFlush((std::numeric_limits<uint64_t>::max)(), false);
 
-  cv_.notify_one();
-  worker_thread_.join();
+  // Wait for the batches in flight before shutting the exporter down.
+  {
+    std::unique_lock<std::mutex> lk(export_m_);
+    is_export_stopped_ = true;
+    export_cv_.notify_all();
+    is_stopped = shutdown_deadline_.Wait(export_cv_, lk,
+                                         [this] { return num_export_threads_ == 0; }) &&
+                 is_stopped;
+  }
+
+  // An export still running at the deadline is abandoned. The destructor waits
+  // for it before shutting the exporter down.
+  if (is_stopped == false)
+  {
+    is_work_abandoned_ = true;
+    return false;
+  }
+  for (auto &export_thread : export_threads_)
+  {
+    export_thread.join();
+  }
+
+  // All the spans were exported unless the deadline expired, or spans were left
+  // waiting for a retry.
+  bool is_drained = shutdown_deadline_.IsExpired() == false && retry_buffer_.empty();
   if (exporter_ != nullptr)
   {
-    return exporter_->Shutdown();
+    return exporter_->Shutdown(shutdown_deadline_.GetRemaining()) && is_drained;
   }
 
-  return true;
+  return is_drained;
 }
 
 BatchSpanProcessor::~BatchSpanProcessor()
@@ -194,6 +427,19 @@ BatchSpanProcessor::~BatchSpanProcessor()
   {
     Shutdown();
   }
+
+  if (is_work_abandoned_)
+  {
+    worker_->Stop();
+    for (auto &export_thread : export_threads_)
+    {
+      export_thread.join();
+    }
+    if (exporter_ != nullptr)
+    {
+      exporter_->Shutdown();
+    }
+  }
 }
 
 }  // namespace trace
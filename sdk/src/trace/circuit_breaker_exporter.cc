@@ -0,0 +1,46 @@
+#include "opentelemetry/sdk/trace/circuit_breaker_exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+CircuitBreakerSpanExporter::CircuitBreakerSpanExporter(
+    std::unique_ptr<SpanExporter> &&exporter,
+    const common::CircuitBreakerOptions &options)
+    : exporter_{std::move(exporter)}, circuit_breaker_{options}
+{}
+
+std::unique_ptr<Recordable> CircuitBreakerSpanExporter::MakeRecordable() noexcept
+{
+  return exporter_->MakeRecordable();
+}
+
+sdk::common::ExportResult CircuitBreakerSpanExporter::Export(
+    const nostd::span<std::unique_ptr<Recordable>> &spans) noexcept
+{
+  if (circuit_breaker_.AllowExport() == false)
+  {
+    if (circuit_breaker_.options().retry_rejected)
+    {
+      return sdk::common::ExportResult::kFailureRetryable;
+    }
+    for (auto &span : spans)
+    {
+      span.reset();
+    }
+    return sdk::common::ExportResult::kFailure;
+  }
+
+  auto result = exporter_->Export(spans);
+  circuit_breaker_.RecordResult(result);
+  return result;
+}
+
+bool CircuitBreakerSpanExporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  return exporter_->Shutdown(timeout);
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,221 @@
+#include "opentelemetry/sdk/trace/multi_span_processor.h"
+#include "opentelemetry/sdk/trace/recordable_pool.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+/**
+ * Records a span into a single SpanData on behalf of all processors of a
+ * MultiSpanProcessor.
+ */
+class MultiRecordable final : public Recordable
+{
+public:
+  explicit MultiRecordable(std::unique_ptr<SpanData> &&span_data) noexcept
+      : span_data_{std::move(span_data)}
+  {}
+
+  ~MultiRecordable() override { RecordablePool<SpanData>::Release(std::move(span_data_)); }
+
+  const SpanData &GetSpanData() const noexcept { return *span_data_; }
+
+  /**
+   * Hand over the recorded span data for sharing. The span data returns to
+   * the recordable pool once it is no longer shared.
+   */
+  std::shared_ptr<const SpanData> Share() noexcept
+  {
+    return std::shared_ptr<const SpanData>(span_data_.release(), [](const SpanData *span_data) {
+      RecordablePool<SpanData>::Release(
+          std::unique_ptr<SpanData>(const_cast<SpanData *>(span_data)));
+    });
+  }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
+                   opentelemetry::trace::SpanId parent_span_id) noexcept override
+  {
+    span_data_->SetIdentity(span_context, parent_span_id);
+  }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override
+  {
+    span_data_->SetAttribute(key, value);
+  }
+
+  bool LookUpAttribute(nostd::string_view key,
+                       size_t *num_attributes,
+                       bool *has_key) const noexcept override
+  {
+    return span_data_->LookUpAttribute(key, num_attributes, has_key);
+  }
+
+  void AddEvent(nostd::string_view name,
+                core::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    span_data_->AddEvent(name, timestamp, attributes);
+  }
+
+  void AddEvent(nostd::string_view name,
+                core::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes,
+                uint32_t dropped_attributes_count) noexcept override
+  {
+    span_data_->AddEvent(name, timestamp, attributes, dropped_attributes_count);
+  }
+
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    span_data_->AddLink(span_context, attributes);
+  }
+
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes,
+               uint32_t dropped_attributes_count) noexcept override
+  {
+    span_data_->AddLink(span_context, attributes, dropped_attributes_count);
+  }
+
+  void SetDroppedCounts(uint32_t dropped_attributes_count,
+                        uint32_t dropped_events_count,
+                        uint32_t dropped_links_count) noexcept override
+  {
+    span_data_->SetDroppedCounts(dropped_attributes_count, dropped_events_count,
+                                 dropped_links_count);
+  }
+
+  void SetStatus(opentelemetry::trace::StatusCode code,
+                 nostd::string_view description) noexcept override
+  {
+    span_data_->SetStatus(code, description);
+  }
+
+  void SetName(nostd::string_view name) noexcept override { span_data_->SetName(name); }
+
+  void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
+  {
+    span_data_->SetSpanKind(span_kind);
+  }
+
+  void SetStartTime(opentelemetry::core::SystemTimestamp start_time) noexcept override
+  {
+    span_data_->SetStartTime(start_time);
+  }
+
+  void SetDuration(std::chrono::nanoseconds duration) noexcept override
+  {
+    span_data_->SetDuration(duration);
+  }
+
+  void SetInstrumentationLibrary(
+      const std::shared_ptr<
+          const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+          &instrumentation_library) noexcept override
+  {
+    span_data_->SetInstrumentationLibrary(instrumentation_library);
+  }
+
+  size_t GetEstimatedSize() const noexcept override { return span_data_->GetEstimatedSize(); }
+
+private:
+  std::unique_ptr<SpanData> span_data_;
+};
+
+/**
+ * Call a function for every processor, sharing a timeout between all calls.
+ * All processors are called, even if the timeout expired.
+ * @return whether the function returned true for all processors
+ */
+template <class Function>
+bool ForEachProcessor(const std::vector<std::shared_ptr<SpanProcessor>> &processors,
+                      std::chrono::microseconds timeout,
+                      Function function) noexcept
+{
+  auto start  = std::chrono::steady_clock::now();
+  bool result = true;
+  for (auto &processor : processors)
+  {
+    auto remaining = timeout;
+    if (timeout != (std::chrono::microseconds::max)())
+    {
+      auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+      remaining = elapsed < timeout ? timeout - elapsed : std::chrono::microseconds::zero();
+    }
+    result = function(*processor, remaining) && result;
+  }
+  return result;
+}
+}  // namespace
+
+MultiSpanProcessor::MultiSpanProcessor(
+    std::vector<std::shared_ptr<SpanProcessor>> processors) noexcept
+    : processors_(std::move(processors))
+{}
+
+std::unique_ptr<Recordable> MultiSpanProcessor::MakeRecordable() noexcept
+{
+  auto span_data = RecordablePool<SpanData>::Acquire();
+  if (span_data == nullptr)
+  {
+    return nullptr;
+  }
+  return std::unique_ptr<Recordable>(new MultiRecordable(std::move(span_data)));
+}
+
+void MultiSpanProcessor::OnStart(Recordable &span,
+                                 const opentelemetry::trace::SpanContext &parent_context) noexcept
+{
+  for (auto &processor : processors_)
+  {
+    processor->OnStart(span, parent_context);
+  }
+}
+
+void MultiSpanProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
+{
+  if (span == nullptr)
+  {
+    return;
+  }
+  auto span_data = static_cast<MultiRecordable *>(span.get())->Share();
+  span.reset();
+
+  for (auto &processor : processors_)
+  {
+    processor->OnEnd(std::unique_ptr<Recordable>(new SharedSpanData(span_data)));
+  }
+}
+
+const SpanData *MultiSpanProcessor::GetSpanData(const Recordable &recordable) noexcept
+{
+  auto multi_recordable = dynamic_cast<const MultiRecordable *>(&recordable);
+  return multi_recordable != nullptr ? &multi_recordable->GetSpanData() : nullptr;
+}
+
+bool MultiSpanProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+  return ForEachProcessor(processors_, timeout,
+                          [](SpanProcessor &processor, std::chrono::microseconds remaining) {
+                            return processor.ForceFlush(remaining);
+                          });
+}
+
+bool MultiSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  return ForEachProcessor(processors_, timeout,
+                          [](SpanProcessor &processor, std::chrono::microseconds remaining) {
+                            return processor.Shutdown(remaining);
+                          });
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
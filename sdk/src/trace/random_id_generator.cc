@@ -0,0 +1,41 @@
+#include "opentelemetry/sdk/trace/random_id_generator.h"
+#include "opentelemetry/version.h"
+#include "src/common/random.h"
+
+#include <cstring>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+trace_api::SpanId RandomIdGenerator::GenerateSpanId() noexcept
+{
+  uint64_t value[1];
+  do
+  {
+    sdk::common::Random::GenerateRandomBatch(value);
+  } while (value[0] == 0);
+
+  uint8_t span_id_buf[trace_api::SpanId::kSize];
+  static_assert(sizeof(span_id_buf) == sizeof(value), "unexpected span id size");
+  memcpy(span_id_buf, value, sizeof(span_id_buf));
+  return trace_api::SpanId(span_id_buf);
+}
+
+trace_api::TraceId RandomIdGenerator::GenerateTraceId() noexcept
+{
+  uint64_t value[2];
+  do
+  {
+    sdk::common::Random::GenerateRandomBatch(value);
+  } while (value[0] == 0 && value[1] == 0);
+
+  uint8_t trace_id_buf[trace_api::TraceId::kSize];
+  static_assert(sizeof(trace_id_buf) == sizeof(value), "unexpected trace id size");
+  memcpy(trace_id_buf, value, sizeof(trace_id_buf));
+  return trace_api::TraceId(trace_id_buf);
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
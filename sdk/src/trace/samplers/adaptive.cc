@@ -0,0 +1,204 @@
+#include "opentelemetry/sdk/trace/samplers/adaptive.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+// Thresholds and randomness are 56-bit values, as in the OpenTelemetry
+// probability sampling specification.
+constexpr int kRandomnessBits    = 56;
+constexpr uint64_t kMaxThreshold = uint64_t{1} << kRandomnessBits;
+
+// The smallest ratio the sampler adjusts to. Below it, 1 - ratio rounds to 1
+// and nothing would be sampled, so the ratio could never grow again.
+constexpr double kMinRatio = std::numeric_limits<double>::epsilon() / 2;
+
+/**
+ * @return the threshold of a ratio: traces whose randomness is at least the
+ * threshold are sampled.
+ */
+uint64_t CalculateThreshold(double ratio) noexcept
+{
+  if (ratio >= 1.0)
+    return 0;
+  if (ratio <= 0.0)
+    return kMaxThreshold;
+  return static_cast<uint64_t>(std::ldexp(1.0 - ratio, kRandomnessBits));
+}
+
+/**
+ * @return the randomness of a trace id, its 7 least significant bytes.
+ */
+uint64_t GetRandomness(const trace_api::TraceId &trace_id) noexcept
+{
+  uint64_t randomness = 0;
+  for (size_t i = trace_api::TraceId::kSize - kRandomnessBits / 8; i < trace_api::TraceId::kSize;
+       ++i)
+  {
+    randomness = (randomness << 8) | trace_id.Id()[i];
+  }
+  return randomness;
+}
+
+/**
+ * @return the value of the "ot" TraceState entry of a threshold: its 14 hex
+ * digits, with trailing zeros removed.
+ */
+std::string EncodeThreshold(uint64_t threshold)
+{
+  static const char kHexDigits[] = "0123456789abcdef";
+  std::string digits(kRandomnessBits / 4, '0');
+  for (size_t i = digits.size(); i > 0; --i)
+  {
+    digits[i - 1] = kHexDigits[threshold & 0xf];
+    threshold >>= 4;
+  }
+  auto end = digits.find_last_not_of('0');
+  return "th:" + (end == std::string::npos ? std::string("0") : digits.substr(0, end + 1));
+}
+}  // namespace
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+AdaptiveSampler::AdaptiveSampler(FeedbackSource feedback_source,
+                                 const AdaptiveSamplerOptions &options)
+    : feedback_source_(std::move(feedback_source)),
+      options_(options),
+      description_("AdaptiveSampler{" + std::to_string(options.target_spans_per_second) + "}"),
+      threshold_(MakeThreshold(CalculateThreshold(options.initial_ratio))),
+      last_feedback_(feedback_source_()),
+      last_time_(common::Executor::Clock::now()),
+      executor_(options.executor ? options.executor : std::make_shared<common::Executor>())
+{
+  worker_.reset(new common::ScheduledTask(
+      executor_,
+      [this] {
+        Adjust();
+        return common::Executor::Clock::duration(options_.adjustment_interval);
+      },
+      options_.adjustment_interval));
+}
+
+AdaptiveSampler::AdaptiveSampler(std::shared_ptr<BatchSpanProcessor> processor,
+                                 const AdaptiveSamplerOptions &options)
+    : AdaptiveSampler(
+          [processor] {
+            AdaptiveSamplerFeedback feedback;
+            feedback.accepted_count = processor->GetAcceptedCount();
+            feedback.dropped_count  = processor->GetDroppedCount();
+            feedback.queue_size     = processor->GetQueueSize();
+            feedback.max_queue_size = processor->GetMaxQueueSize();
+            feedback.export_latency = processor->GetExportLatency();
+            return feedback;
+          },
+          options)
+{}
+
+SamplingResult AdaptiveSampler::ShouldSample(
+    const trace_api::SpanContext &parent_context,
+    trace_api::TraceId trace_id,
+    nostd::string_view /*name*/,
+    trace_api::SpanKind /*span_kind*/,
+    const opentelemetry::common::KeyValueIterable & /*attributes*/,
+    const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
+{
+  // Keeps the threshold alive, without contending on its reference count.
+  common::EpochGuard guard;
+  const Threshold *threshold = threshold_.get();
+  if (threshold->value >= kMaxThreshold || GetRandomness(trace_id) < threshold->value)
+  {
+    return {Decision::DROP, nullptr};
+  }
+
+  // Replace the threshold of the parent, if any.
+  auto trace_state = parent_context.trace_state();
+  std::string value;
+  if (trace_state->Get("ot", value))
+  {
+    trace_state = trace_state->Delete("ot");
+  }
+  return {Decision::RECORD_AND_SAMPLE, nullptr, trace_state->Set("ot", threshold->encoded)};
+}
+
+nostd::string_view AdaptiveSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+
+void AdaptiveSampler::Adjust() noexcept
+{
+  std::lock_guard<std::mutex> guard(adjust_mutex_);
+  const auto feedback = feedback_source_();
+  const auto now      = common::Executor::Clock::now();
+  const double elapsed =
+      std::chrono::duration_cast<std::chrono::duration<double>>(now - last_time_).count();
+  const double dropped = static_cast<double>(feedback.dropped_count - last_feedback_.dropped_count);
+  const double ended =
+      static_cast<double>(feedback.accepted_count - last_feedback_.accepted_count) + dropped;
+  last_feedback_ = feedback;
+  last_time_     = now;
+
+  // Move towards the ratio at which the spans ended meet the target. Without
+  // spans, the ratio grows at most twofold per adjustment.
+  const double ratio = GetRatio();
+  double new_ratio   = 2 * ratio;
+  if (ended > 0 && elapsed > 0)
+  {
+    new_ratio = (std::min)(new_ratio, ratio * options_.target_spans_per_second * elapsed / ended);
+  }
+
+  // Shed load before the queue overflows, in proportion to the room left above
+  // the high watermark.
+  if (feedback.max_queue_size > 0)
+  {
+    const double occupancy = static_cast<double>(feedback.queue_size) / feedback.max_queue_size;
+    if (occupancy > options_.queue_high_watermark && options_.queue_high_watermark < 1.0)
+    {
+      new_ratio = (std::min)(new_ratio, ratio * (1.0 - occupancy) /
+                                            (1.0 - options_.queue_high_watermark));
+    }
+  }
+
+  // Spans were dropped anyway: keep only the share the queue accepted.
+  if (dropped > 0)
+  {
+    new_ratio = (std::min)(new_ratio, ratio * (ended - dropped) / ended);
+  }
+
+  if (options_.max_export_latency.count() > 0 &&
+      feedback.export_latency > options_.max_export_latency)
+  {
+    const double latency_ratio =
+        std::chrono::duration<double>(options_.max_export_latency).count() /
+        std::chrono::duration<double>(feedback.export_latency).count();
+    new_ratio = (std::min)(new_ratio, ratio * latency_ratio);
+  }
+
+  new_ratio = (std::max)(new_ratio, (std::max)(options_.min_ratio, kMinRatio));
+  const uint64_t threshold = CalculateThreshold((std::min)(new_ratio, 1.0));
+  if (threshold != threshold_.load()->value)
+  {
+    threshold_.store(MakeThreshold(threshold));
+  }
+}
+
+double AdaptiveSampler::GetRatio() const noexcept
+{
+  return 1.0 - std::ldexp(static_cast<double>(threshold_.load()->value), -kRandomnessBits);
+}
+
+std::shared_ptr<const AdaptiveSampler::Threshold> AdaptiveSampler::MakeThreshold(
+    uint64_t value) noexcept
+{
+  return std::shared_ptr<const Threshold>(new Threshold{value, EncodeThreshold(value)});
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,187 @@
+#include "opentelemetry/sdk/trace/samplers/rate_limiting.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+// The fractions a token is counted in.
+constexpr int64_t kTokenScale = 1 << 16;
+
+// The interval in nanoseconds between rebalancings.
+constexpr int64_t kRebalanceInterval = 100 * 1000 * 1000;
+
+// The number of refills from the shared bucket a shard's full share of the
+// budget is split into. Refills are whole tokens.
+constexpr int64_t kBatchesPerShare = 8;
+
+constexpr size_t kCacheLineSize = 64;
+
+int64_t GetNow() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+size_t GetNumShards(size_t num_shards) noexcept
+{
+  return num_shards > 0 ? num_shards : (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+/**
+ * @return a number assigned to the calling thread, distinct for consecutively
+ * started threads so that they spread evenly over the shards.
+ */
+size_t GetThreadIndex() noexcept
+{
+  static std::atomic<size_t> next_thread_index{0};
+  thread_local size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index;
+}
+}  // namespace
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The bucket of a shard, on a cache line of its own.
+ */
+struct alignas(kCacheLineSize) RateLimitingSampler::Shard
+{
+  std::atomic<int64_t> tokens{0};
+  // The bucket is not refilled before this time, after the shared bucket was
+  // found empty.
+  std::atomic<int64_t> retry_time{0};
+};
+
+RateLimitingSampler::RateLimitingSampler(double max_spans_per_second, size_t num_shards)
+    : tokens_per_nanosecond_((std::max)(max_spans_per_second, 0.0) * kTokenScale / 1e9),
+      capacity_(max_spans_per_second > 0.0
+                    ? (std::max)(static_cast<int64_t>(max_spans_per_second * kTokenScale),
+                                 kTokenScale)
+                    : 0),
+      batch_size_((std::max)(capacity_ / static_cast<int64_t>(kBatchesPerShare *
+                                                              GetNumShards(num_shards)) /
+                                 kTokenScale,
+                             int64_t{1}) *
+                  kTokenScale),
+      num_shards_(GetNumShards(num_shards)),
+      shard_storage_(new char[num_shards_ * sizeof(Shard) + kCacheLineSize]),
+      pool_(capacity_),
+      last_rebalance_time_(GetNow())
+{
+  // Before C++17, new does not align beyond alignof(std::max_align_t), so the
+  // shards are placed at the first cache line boundary of larger storage, and
+  // released with it without being destroyed.
+  static_assert(std::is_trivially_destructible<Shard>::value,
+                "Shard must be trivially destructible");
+  void *storage = shard_storage_.get();
+  size_t space  = num_shards_ * sizeof(Shard) + kCacheLineSize;
+  shards_       = static_cast<Shard *>(
+      std::align(kCacheLineSize, num_shards_ * sizeof(Shard), storage, space));
+  for (size_t i = 0; i < num_shards_; ++i)
+  {
+    new (&shards_[i]) Shard;
+  }
+
+  description_ =
+      "RateLimitingSampler{" + std::to_string((std::max)(max_spans_per_second, 0.0)) + "}";
+}
+
+RateLimitingSampler::~RateLimitingSampler() = default;
+
+SamplingResult RateLimitingSampler::ShouldSample(
+    const trace_api::SpanContext & /*parent_context*/,
+    trace_api::TraceId /*trace_id*/,
+    nostd::string_view /*name*/,
+    trace_api::SpanKind /*span_kind*/,
+    const opentelemetry::common::KeyValueIterable & /*attributes*/,
+    const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
+{
+  // In the common path, only the bucket of the shard of this thread is used.
+  auto &shard    = shards_[GetThreadIndex() % num_shards_];
+  int64_t tokens = shard.tokens.load(std::memory_order_relaxed);
+  while (tokens >= kTokenScale)
+  {
+    if (shard.tokens.compare_exchange_weak(tokens, tokens - kTokenScale,
+                                           std::memory_order_relaxed))
+    {
+      return {Decision::RECORD_AND_SAMPLE, nullptr};
+    }
+  }
+
+  if (RefillAndAcquire(shard))
+  {
+    return {Decision::RECORD_AND_SAMPLE, nullptr};
+  }
+  return {Decision::DROP, nullptr};
+}
+
+nostd::string_view RateLimitingSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+
+bool RateLimitingSampler::RefillAndAcquire(Shard &shard) noexcept
+{
+  const int64_t now = GetNow();
+  if (now < shard.retry_time.load(std::memory_order_relaxed))
+  {
+    return false;
+  }
+  Rebalance(now);
+
+  int64_t pool = pool_.load(std::memory_order_relaxed);
+  int64_t batch;
+  do
+  {
+    if (pool < kTokenScale)
+    {
+      // Spare the shared bucket until it is refilled.
+      shard.retry_time.store(last_rebalance_time_.load(std::memory_order_relaxed) +
+                                 kRebalanceInterval,
+                             std::memory_order_relaxed);
+      return false;
+    }
+    batch = (std::min)(pool, batch_size_);
+  } while (!pool_.compare_exchange_weak(pool, pool - batch, std::memory_order_relaxed));
+
+  // One of the tokens is taken right away.
+  shard.tokens.fetch_add(batch - kTokenScale, std::memory_order_relaxed);
+  return true;
+}
+
+void RateLimitingSampler::Rebalance(int64_t now) noexcept
+{
+  int64_t last = last_rebalance_time_.load(std::memory_order_relaxed);
+  if (now - last < kRebalanceInterval ||
+      !last_rebalance_time_.compare_exchange_strong(last, now, std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  int64_t tokens = static_cast<int64_t>(static_cast<double>(now - last) * tokens_per_nanosecond_);
+  for (size_t i = 0; i < num_shards_; ++i)
+  {
+    tokens += shards_[i].tokens.exchange(0, std::memory_order_relaxed);
+  }
+
+  // The bucket holds at most a second of the budget.
+  int64_t pool = pool_.load(std::memory_order_relaxed);
+  while (!pool_.compare_exchange_weak(pool, (std::min)(pool + tokens, capacity_),
+                                      std::memory_order_relaxed))
+  {
+  }
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,476 @@
+#include "opentelemetry/sdk/trace/samplers/rule_based.h"
+#include "opentelemetry/sdk/trace/samplers/trace_id_ratio.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+constexpr uint32_t kNoRule = UINT32_MAX;
+
+const char *const kSpanKindNames[] = {"internal", "server", "client", "producer", "consumer"};
+
+/**
+ * Hashes span names without copying them, unlike std::hash<nostd::string_view>
+ * without the standard library string_view.
+ */
+struct NameHash
+{
+  size_t operator()(opentelemetry::nostd::string_view name) const noexcept
+  {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name)
+    {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+
+/**
+ * An attribute a rule references, with its value parsed once when the rule is
+ * compiled rather than on every comparison.
+ */
+struct AttributeCondition
+{
+  explicit AttributeCondition(const std::pair<std::string, std::string> &attribute)
+      : key(attribute.first), text(attribute.second)
+  {
+    is_boolean = text == "true" || text == "false";
+    boolean    = text == "true";
+
+    char *end  = nullptr;
+    integer    = std::strtoll(text.c_str(), &end, 10);
+    is_integer = !text.empty() && *end == '\0';
+  }
+
+  /**
+   * @return true if an attribute value has the text of the condition.
+   */
+  bool Matches(const opentelemetry::common::AttributeValue &value) const noexcept
+  {
+    namespace nostd = opentelemetry::nostd;
+    if (nostd::holds_alternative<nostd::string_view>(value))
+    {
+      return nostd::get<nostd::string_view>(value) == text;
+    }
+    if (nostd::holds_alternative<bool>(value))
+    {
+      return is_boolean && nostd::get<bool>(value) == boolean;
+    }
+    if (!is_integer)
+    {
+      return false;
+    }
+    if (nostd::holds_alternative<int32_t>(value))
+    {
+      return nostd::get<int32_t>(value) == integer;
+    }
+    if (nostd::holds_alternative<int64_t>(value))
+    {
+      return nostd::get<int64_t>(value) == integer;
+    }
+    if (nostd::holds_alternative<uint32_t>(value))
+    {
+      return integer >= 0 && nostd::get<uint32_t>(value) == static_cast<uint64_t>(integer);
+    }
+    if (nostd::holds_alternative<uint64_t>(value))
+    {
+      return integer >= 0 && nostd::get<uint64_t>(value) == static_cast<uint64_t>(integer);
+    }
+    return false;
+  }
+
+  std::string key;
+  std::string text;
+  bool is_boolean;
+  bool boolean;
+  bool is_integer;
+  long long integer;
+};
+
+/**
+ * Splits a line of a rules file into whitespace separated tokens, removing
+ * the double quotes around values.
+ * @return false if a quote is not closed
+ */
+bool Tokenize(const std::string &line, std::vector<std::string> &tokens)
+{
+  size_t i = 0;
+  while (true)
+  {
+    while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i])))
+    {
+      ++i;
+    }
+    if (i == line.size())
+    {
+      return true;
+    }
+    std::string token;
+    bool is_quoted = false;
+    for (; i < line.size() && (is_quoted || !std::isspace(static_cast<unsigned char>(line[i])));
+         ++i)
+    {
+      if (line[i] == '"')
+      {
+        is_quoted = !is_quoted;
+      }
+      else
+      {
+        token += line[i];
+      }
+    }
+    if (is_quoted)
+    {
+      return false;
+    }
+    tokens.push_back(std::move(token));
+  }
+}
+}  // namespace
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The rules compiled for matching. Rules are referred to by their index, and
+ * the first matching rule is the one with the lowest index.
+ */
+class RuleBasedSampler::DecisionTable
+{
+public:
+  DecisionTable(const std::vector<SamplingRule> &rules, double default_ratio)
+      : default_sampler_(default_ratio)
+  {
+    // The exact names refer to the names of the compiled rules, which must not move.
+    rules_.reserve(rules.size());
+    trie_.emplace_back();
+    for (uint32_t index = 0; index < rules.size(); ++index)
+    {
+      const auto &rule = rules[index];
+      rules_.emplace_back(rule);
+      if (!rule.name.empty())
+      {
+        // The name prefix of a rule with an exact name is checked when matching.
+        exact_names_[rules_.back().name].push_back(index);
+      }
+      else if (!rule.name_prefix.empty())
+      {
+        size_t node = 0;
+        for (char c : rule.name_prefix)
+        {
+          auto child = trie_[node].children.find(c);
+          if (child == trie_[node].children.end())
+          {
+            child = trie_[node].children.emplace(c, static_cast<uint32_t>(trie_.size())).first;
+            trie_.emplace_back();
+          }
+          node = child->second;
+        }
+        trie_[node].rules.push_back(index);
+      }
+      else
+      {
+        any_name_.push_back(index);
+      }
+    }
+  }
+
+  Sampler &GetSampler(nostd::string_view name,
+                      trace_api::SpanKind span_kind,
+                      const opentelemetry::common::KeyValueIterable &attributes) const noexcept
+  {
+    // Each list of candidates is in the order of the rules, so that only the
+    // first match of each list may be the first match of all.
+    uint32_t first = kNoRule;
+    auto exact     = exact_names_.find(name);
+    if (exact != exact_names_.end())
+    {
+      first = FindFirstMatch(exact->second, first, name, span_kind, attributes);
+    }
+
+    size_t node = 0;
+    first       = FindFirstMatch(trie_[node].rules, first, name, span_kind, attributes);
+    for (char c : name)
+    {
+      auto child = trie_[node].children.find(c);
+      if (child == trie_[node].children.end())
+      {
+        break;
+      }
+      node  = child->second;
+      first = FindFirstMatch(trie_[node].rules, first, name, span_kind, attributes);
+    }
+
+    first = FindFirstMatch(any_name_, first, name, span_kind, attributes);
+    return first == kNoRule ? default_sampler_ : *rules_[first].sampler;
+  }
+
+private:
+  struct CompiledRule
+  {
+    explicit CompiledRule(const SamplingRule &rule)
+        : name(rule.name),
+          name_prefix(rule.name_prefix),
+          has_span_kind(rule.has_span_kind),
+          span_kind(rule.span_kind),
+          attributes(rule.attributes.begin(), rule.attributes.end()),
+          sampler(new TraceIdRatioBasedSampler(rule.ratio))
+    {}
+
+    std::string name;
+    std::string name_prefix;
+    bool has_span_kind;
+    trace_api::SpanKind span_kind;
+    std::vector<AttributeCondition> attributes;
+    std::unique_ptr<Sampler> sampler;
+  };
+
+  struct TrieNode
+  {
+    std::map<char, uint32_t> children;
+    // The rules whose name prefix ends at this node.
+    std::vector<uint32_t> rules;
+  };
+
+  std::vector<CompiledRule> rules_;
+  std::unordered_map<nostd::string_view, std::vector<uint32_t>, NameHash> exact_names_;
+  std::vector<TrieNode> trie_;
+  std::vector<uint32_t> any_name_;
+  mutable TraceIdRatioBasedSampler default_sampler_;
+
+  /**
+   * @return the first of the candidate rules before the given rule which
+   * matches the span, or the given rule if none does.
+   */
+  uint32_t FindFirstMatch(const std::vector<uint32_t> &candidates,
+                          uint32_t first,
+                          nostd::string_view name,
+                          trace_api::SpanKind span_kind,
+                          const opentelemetry::common::KeyValueIterable &attributes) const noexcept
+  {
+    for (uint32_t index : candidates)
+    {
+      if (index >= first)
+      {
+        break;
+      }
+      if (Matches(rules_[index], name, span_kind, attributes))
+      {
+        return index;
+      }
+    }
+    return first;
+  }
+
+  static bool Matches(const CompiledRule &rule,
+                      nostd::string_view name,
+                      trace_api::SpanKind span_kind,
+                      const opentelemetry::common::KeyValueIterable &attributes) noexcept
+  {
+    if (rule.has_span_kind && rule.span_kind != span_kind)
+    {
+      return false;
+    }
+    if (!rule.name_prefix.empty() &&
+        (name.size() < rule.name_prefix.size() ||
+         name.substr(0, rule.name_prefix.size()) != rule.name_prefix))
+    {
+      return false;
+    }
+    if (rule.attributes.empty())
+    {
+      return true;
+    }
+
+    // Only the values of the attributes the rule references are compared.
+    size_t num_matched = 0;
+    attributes.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          for (auto &attribute : rule.attributes)
+          {
+            if (key == attribute.key && attribute.Matches(value))
+            {
+              ++num_matched;
+            }
+          }
+          return num_matched < rule.attributes.size();
+        });
+    return num_matched == rule.attributes.size();
+  }
+};
+
+RuleBasedSampler::RuleBasedSampler(std::vector<SamplingRule> rules, double default_ratio)
+    : default_ratio_(default_ratio),
+      table_(std::shared_ptr<const DecisionTable>(new DecisionTable(rules, default_ratio)))
+{}
+
+RuleBasedSampler::RuleBasedSampler(std::string path,
+                                   double default_ratio,
+                                   std::chrono::milliseconds reload_interval,
+                                   std::shared_ptr<common::Executor> executor)
+    : default_ratio_(default_ratio),
+      table_(std::shared_ptr<const DecisionTable>(new DecisionTable({}, default_ratio))),
+      path_(std::move(path)),
+      executor_(executor ? std::move(executor) : std::make_shared<common::Executor>())
+{
+  Reload();
+  worker_.reset(new common::ScheduledTask(
+      executor_,
+      [this, reload_interval] {
+        Reload();
+        return common::Executor::Clock::duration(reload_interval);
+      },
+      reload_interval));
+}
+
+RuleBasedSampler::~RuleBasedSampler() = default;
+
+SamplingResult RuleBasedSampler::ShouldSample(
+    const trace_api::SpanContext &parent_context,
+    trace_api::TraceId trace_id,
+    nostd::string_view name,
+    trace_api::SpanKind span_kind,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const trace_api::SpanContextKeyValueIterable &links) noexcept
+{
+  // Keeps the table alive, without contending on its reference count.
+  common::EpochGuard guard;
+  return table_.get()->GetSampler(name, span_kind, attributes)
+      .ShouldSample(parent_context, trace_id, name, span_kind, attributes, links);
+}
+
+nostd::string_view RuleBasedSampler::GetDescription() const noexcept
+{
+  return "RuleBasedSampler";
+}
+
+void RuleBasedSampler::SetRules(std::vector<SamplingRule> rules)
+{
+  table_.store(std::shared_ptr<const DecisionTable>(new DecisionTable(rules, default_ratio_)));
+}
+
+bool RuleBasedSampler::Reload() noexcept
+{
+  std::lock_guard<std::mutex> guard(reload_mutex_);
+  std::ifstream file(path_, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::stringstream content;
+  content << file.rdbuf();
+  if (content.str() == content_)
+  {
+    return true;
+  }
+
+  std::vector<SamplingRule> rules;
+  std::string error;
+  if (!ParseRules(content.str(), rules, error))
+  {
+    return false;
+  }
+  content_ = content.str();
+  SetRules(std::move(rules));
+  return true;
+}
+
+bool RuleBasedSampler::ParseRules(nostd::string_view text,
+                                  std::vector<SamplingRule> &rules,
+                                  std::string &error)
+{
+  std::istringstream lines(std::string(text.data(), text.size()));
+  std::string line;
+  std::vector<SamplingRule> parsed;
+  for (size_t line_number = 1; std::getline(lines, line); ++line_number)
+  {
+    std::vector<std::string> tokens;
+    if (!Tokenize(line, tokens))
+    {
+      error = "line " + std::to_string(line_number) + ": unclosed quote";
+      return false;
+    }
+    if (tokens.empty() || tokens.front()[0] == '#')
+    {
+      continue;
+    }
+
+    SamplingRule rule;
+    bool has_ratio = false;
+    for (auto &token : tokens)
+    {
+      auto separator = token.find('=');
+      if (separator == std::string::npos)
+      {
+        error = "line " + std::to_string(line_number) + ": expected key=value: " + token;
+        return false;
+      }
+      std::string key   = token.substr(0, separator);
+      std::string value = token.substr(separator + 1);
+      if (key == "name")
+      {
+        rule.name = value;
+      }
+      else if (key == "name_prefix")
+      {
+        rule.name_prefix = value;
+      }
+      else if (key == "kind")
+      {
+        auto kind = std::find(std::begin(kSpanKindNames), std::end(kSpanKindNames), value);
+        if (kind == std::end(kSpanKindNames))
+        {
+          error = "line " + std::to_string(line_number) + ": unknown span kind: " + value;
+          return false;
+        }
+        rule.has_span_kind = true;
+        rule.span_kind     = static_cast<trace_api::SpanKind>(kind - std::begin(kSpanKindNames));
+      }
+      else if (key.compare(0, 10, "attribute.") == 0 && key.size() > 10)
+      {
+        rule.attributes.emplace_back(key.substr(10), value);
+      }
+      else if (key == "ratio")
+      {
+        char *end  = nullptr;
+        rule.ratio = std::strtod(value.c_str(), &end);
+        if (value.empty() || *end != '\0' || !(rule.ratio >= 0.0 && rule.ratio <= 1.0))
+        {
+          error = "line " + std::to_string(line_number) + ": invalid ratio: " + value;
+          return false;
+        }
+        has_ratio = true;
+      }
+      else
+      {
+        error = "line " + std::to_string(line_number) + ": unknown key: " + key;
+        return false;
+      }
+    }
+    if (!has_ratio)
+    {
+      error = "line " + std::to_string(line_number) + ": missing ratio";
+      return false;
+    }
+    parsed.push_back(std::move(rule));
+  }
+
+  rules.insert(rules.end(), parsed.begin(), parsed.end());
+  return true;
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
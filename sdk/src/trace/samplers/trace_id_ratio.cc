@@ -17,7 +17,9 @@
 
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
 
 namespace trace_api = opentelemetry::trace;
 
@@ -66,6 +68,27 @@ uint64_t CalculateThresholdFromBuffer(const trace_api::TraceId &trace_id) noexce
 
   return CalculateThreshold(ratio);
 }
+
+/**
+ * @return Returns the ratio clamped to bounds [0.0, 1.0]
+ */
+double ClampRatio(double ratio) noexcept
+{
+  if (ratio > 1.0)
+    ratio = 1.0;
+  if (ratio < 0.0)
+    ratio = 0.0;
+  return ratio;
+}
+
+/**
+ * @return the description of a sampler with the given ratio.
+ */
+std::shared_ptr<const std::string> MakeDescription(double ratio)
+{
+  return std::make_shared<const std::string>("TraceIdRatioBasedSampler{" +
+                                             std::to_string(ClampRatio(ratio)) + "}");
+}
 }  // namespace
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -74,14 +97,8 @@ namespace sdk
 namespace trace
 {
 TraceIdRatioBasedSampler::TraceIdRatioBasedSampler(double ratio)
-    : threshold_(CalculateThreshold(ratio))
-{
-  if (ratio > 1.0)
-    ratio = 1.0;
-  if (ratio < 0.0)
-    ratio = 0.0;
-  description_ = "TraceIdRatioBasedSampler{" + std::to_string(ratio) + "}";
-}
+    : threshold_(CalculateThreshold(ratio)), description_(MakeDescription(ratio))
+{}
 
 SamplingResult TraceIdRatioBasedSampler::ShouldSample(
     const trace_api::SpanContext & /*parent_context*/,
@@ -91,10 +108,11 @@ SamplingResult TraceIdRatioBasedSampler::ShouldSample(
     const opentelemetry::common::KeyValueIterable & /*attributes*/,
     const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
 {
-  if (threshold_ == 0)
+  const uint64_t threshold = threshold_.load(std::memory_order_relaxed);
+  if (threshold == 0)
     return {Decision::DROP, nullptr};
 
-  if (CalculateThresholdFromBuffer(trace_id) <= threshold_)
+  if (CalculateThresholdFromBuffer(trace_id) <= threshold)
   {
     return {Decision::RECORD_AND_SAMPLE, nullptr};
   }
@@ -104,7 +122,15 @@ SamplingResult TraceIdRatioBasedSampler::ShouldSample(
 
 nostd::string_view TraceIdRatioBasedSampler::GetDescription() const noexcept
 {
-  return description_;
+  return *description_.get();
+}
+
+void TraceIdRatioBasedSampler::SetRatio(double ratio) noexcept
+{
+  threshold_.store(CalculateThreshold(ratio), std::memory_order_relaxed);
+  // The previous description is retired after a grace period, since it may
+  // still be viewed.
+  description_.store(MakeDescription(ratio));
 }
 }  // namespace trace
 }  // namespace sdk
@@ -0,0 +1,50 @@
+#include "opentelemetry/sdk/trace/shared_span_data.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+void SharedSpanData::CopyTo(Recordable &recordable) const noexcept
+{
+  const auto &span = *span_data_;
+
+  recordable.SetIdentity(span.GetSpanContext(), span.GetParentSpanId());
+  recordable.SetName(span.GetName());
+  recordable.SetInstrumentationLibrary(span.GetSharedInstrumentationLibrary());
+  recordable.SetSpanKind(span.GetSpanKind());
+  recordable.SetStartTime(span.GetStartTime());
+
+  common::AttributeViewIterable(span.GetAttributes())
+      .ForEachKeyValue(
+          [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+            recordable.SetAttribute(key, value);
+            return true;
+          });
+
+  for (const auto &event : span.GetEvents())
+  {
+    recordable.AddEvent(event.GetName(), event.GetTimestamp(),
+                        common::AttributeViewIterable(event.GetAttributes()),
+                        event.GetDroppedAttributesCount());
+  }
+
+  for (const auto &link : span.GetLinks())
+  {
+    recordable.AddLink(link.GetSpanContext(), common::AttributeViewIterable(link.GetAttributes()),
+                       link.GetDroppedAttributesCount());
+  }
+
+  if (span.GetDroppedAttributesCount() != 0 || span.GetDroppedEventsCount() != 0 ||
+      span.GetDroppedLinksCount() != 0)
+  {
+    recordable.SetDroppedCounts(span.GetDroppedAttributesCount(), span.GetDroppedEventsCount(),
+                                span.GetDroppedLinksCount());
+  }
+
+  recordable.SetStatus(span.GetStatus(), span.GetDescription());
+  recordable.SetDuration(span.GetDuration());
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
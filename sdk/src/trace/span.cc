@@ -1,10 +1,12 @@
 #include "src/trace/span.h"
-#include "src/common/random.h"
 
 #include "opentelemetry/context/runtime_context.h"
 #include "opentelemetry/trace/trace_flags.h"
 #include "opentelemetry/version.h"
 
+#include <algorithm>
+#include <vector>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -16,61 +18,108 @@ using opentelemetry::core::SystemTimestamp;
 
 namespace
 {
-SystemTimestamp NowOr(const SystemTimestamp &system)
+// Truncate string values, and the strings of string array values, to the
+// length limit. Truncated array values are stored in storage.
+opentelemetry::common::AttributeValue LimitAttributeValue(
+    const opentelemetry::common::AttributeValue &value,
+    uint32_t length_limit,
+    std::vector<nostd::string_view> &storage) noexcept
 {
-  if (system == SystemTimestamp())
+  if (length_limit == SpanLimits::kUnlimited)
   {
-    return SystemTimestamp(std::chrono::system_clock::now());
+    return value;
   }
-  else
+  if (nostd::holds_alternative<nostd::string_view>(value))
+  {
+    auto string_value = nostd::get<nostd::string_view>(value);
+    if (string_value.size() > length_limit)
+    {
+      return string_value.substr(0, length_limit);
+    }
+  }
+  else if (nostd::holds_alternative<nostd::span<const nostd::string_view>>(value))
   {
-    return system;
+    auto string_values = nostd::get<nostd::span<const nostd::string_view>>(value);
+    for (size_t i = 0; i < string_values.size(); ++i)
+    {
+      if (string_values[i].size() > length_limit)
+      {
+        storage.assign(string_values.begin(), string_values.end());
+        for (auto &string_value : storage)
+        {
+          string_value = string_value.substr(0, length_limit);
+        }
+        return nostd::span<const nostd::string_view>(storage.data(), storage.size());
+      }
+    }
   }
+  return value;
 }
 
-SteadyTimestamp NowOr(const SteadyTimestamp &steady)
+// A view of the attributes of an event or link, limited to the first count_limit
+// attributes with their values limited to length_limit.
+class LimitedKeyValueIterable final : public opentelemetry::common::KeyValueIterable
 {
-  if (steady == SteadyTimestamp())
+public:
+  LimitedKeyValueIterable(const opentelemetry::common::KeyValueIterable &attributes,
+                          uint32_t count_limit,
+                          uint32_t length_limit) noexcept
+      : attributes_(attributes), count_limit_(count_limit), length_limit_(length_limit)
+  {}
+
+  bool ForEachKeyValue(
+      nostd::function_ref<bool(nostd::string_view, opentelemetry::common::AttributeValue)>
+          callback) const noexcept override
   {
-    return SteadyTimestamp(std::chrono::steady_clock::now());
+    uint32_t count = 0;
+    return attributes_.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          if (count++ == count_limit_)
+          {
+            return false;
+          }
+          std::vector<nostd::string_view> storage;
+          return callback(key, LimitAttributeValue(value, length_limit_, storage));
+        });
   }
-  else
+
+  size_t size() const noexcept override
   {
-    return steady;
+    return (std::min)(attributes_.size(), static_cast<size_t>(count_limit_));
   }
-}
-}  // namespace
 
-// Helper function to generate random trace id.
-trace_api::TraceId GenerateRandomTraceId()
-{
-  uint8_t trace_id_buf[trace_api::TraceId::kSize];
-  sdk::common::Random::GenerateRandomBuffer(trace_id_buf);
-  return trace_api::TraceId(trace_id_buf);
-}
+  uint32_t GetDroppedCount() const noexcept
+  {
+    return static_cast<uint32_t>(attributes_.size() - size());
+  }
 
-// Helper function to generate random span id.
-trace_api::SpanId GenerateRandomSpanId()
-{
-  uint8_t span_id_buf[trace_api::SpanId::kSize];
-  sdk::common::Random::GenerateRandomBuffer(span_id_buf);
-  return trace_api::SpanId(span_id_buf);
-}
+private:
+  const opentelemetry::common::KeyValueIterable &attributes_;
+  uint32_t count_limit_;
+  uint32_t length_limit_;
+};
+}  // namespace
 
-Span::Span(std::shared_ptr<Tracer> &&tracer,
-           std::shared_ptr<SpanProcessor> processor,
+Span::Span(const std::shared_ptr<TracerContext> &context,
+           const std::shared_ptr<
+               const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+               &instrumentation_library,
            nostd::string_view name,
            const opentelemetry::common::KeyValueIterable &attributes,
            const trace_api::SpanContextKeyValueIterable &links,
            const trace_api::StartSpanOptions &options,
            const trace_api::SpanContext &parent_span_context,
-           const opentelemetry::sdk::resource::Resource &resource,
+           const trace_api::TraceId &trace_id,
+           const trace_api::SpanId &span_id,
            const nostd::shared_ptr<opentelemetry::trace::TraceState> trace_state,
            const bool sampled) noexcept
-    : tracer_{std::move(tracer)},
-      processor_{processor},
+    : context_{context},
+      processor_{context->GetProcessor()},
+      clock_{*context->GetClock()},
+      limits_{context->GetSpanLimits()},
       recordable_{processor_->MakeRecordable()},
       start_steady_time{options.start_steady_time},
+      span_context_{false, false},
       has_ended_{false}
 {
   if (recordable_ == nullptr)
@@ -78,48 +127,82 @@ Span::Span(std::shared_ptr<Tracer> &&tracer,
     return;
   }
   recordable_->SetName(name);
+  recordable_->SetInstrumentationLibrary(instrumentation_library);
+
+  // Recordables which cannot look up their attributes need a copy of the keys
+  // to enforce the attribute count limit.
+  size_t num_attributes = 0;
+  bool has_key          = false;
+  can_look_up_attributes_ =
+      recordable_->LookUpAttribute(nostd::string_view{}, &num_attributes, &has_key);
 
-  trace_api::TraceId trace_id;
-  trace_api::SpanId span_id = GenerateRandomSpanId();
   trace_api::SpanId parent_span_id;
   bool is_parent_span_valid = false;
 
   if (parent_span_context.IsValid())
   {
-    trace_id             = parent_span_context.trace_id();
     parent_span_id       = parent_span_context.span_id();
     is_parent_span_valid = true;
   }
-  else
-  {
-    trace_id = GenerateRandomTraceId();
-  }
 
-  span_context_ = std::unique_ptr<trace_api::SpanContext>(new trace_api::SpanContext(
+  span_context_ = trace_api::SpanContext(
       trace_id, span_id,
       sampled ? trace_api::TraceFlags{trace_api::TraceFlags::kIsSampled} : trace_api::TraceFlags{},
       false,
       trace_state ? trace_state
                   : is_parent_span_valid ? parent_span_context.trace_state()
-                                         : trace_api::TraceState::GetDefault()));
+                                         : trace_api::TraceState::GetDefault());
 
-  recordable_->SetIdentity(*span_context_, parent_span_id);
+  recordable_->SetIdentity(span_context_, parent_span_id);
 
   attributes.ForEachKeyValue(
       [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
-        recordable_->SetAttribute(key, value);
+        SetAttributeWithinLimits(key, value);
         return true;
       });
 
   links.ForEachKeyValue([&](opentelemetry::trace::SpanContext span_context,
                             const opentelemetry::common::KeyValueIterable &attributes) {
-    recordable_->AddLink(span_context, attributes);
+    if (links_count_ == limits_.link_count_limit)
+    {
+      ++dropped_links_count_;
+      return true;
+    }
+    ++links_count_;
+    if (attributes.size() <= limits_.attribute_per_link_count_limit &&
+        limits_.attribute_value_length_limit == SpanLimits::kUnlimited)
+    {
+      recordable_->AddLink(span_context, attributes);
+    }
+    else
+    {
+      LimitedKeyValueIterable limited_attributes{attributes, limits_.attribute_per_link_count_limit,
+                                                 limits_.attribute_value_length_limit};
+      recordable_->AddLink(span_context, limited_attributes, limited_attributes.GetDroppedCount());
+    }
     return true;
   });
 
   recordable_->SetSpanKind(options.kind);
-  recordable_->SetStartTime(NowOr(options.start_system_time));
-  start_steady_time = NowOr(options.start_steady_time);
+
+  // Read the clock only for the timestamps not passed in by the caller.
+  SystemTimestamp start_system_time = options.start_system_time;
+  start_steady_time                 = options.start_steady_time;
+  if (start_system_time == SystemTimestamp() && start_steady_time == SteadyTimestamp())
+  {
+    auto now          = clock_.Now();
+    start_system_time = now.system_time;
+    start_steady_time = now.steady_time;
+  }
+  else if (start_system_time == SystemTimestamp())
+  {
+    start_system_time = clock_.SystemNow();
+  }
+  else if (start_steady_time == SteadyTimestamp())
+  {
+    start_steady_time = clock_.SteadyNow();
+  }
+  recordable_->SetStartTime(start_system_time);
   // recordable_->SetResource(resource_); TODO
   processor_->OnStart(*recordable_, parent_span_context);
 }
@@ -133,8 +216,51 @@ void Span::SetAttribute(nostd::string_view key,
                         const opentelemetry::common::AttributeValue &value) noexcept
 {
   std::lock_guard<std::mutex> lock_guard{mu_};
+  if (recordable_ == nullptr)
+  {
+    return;
+  }
+  SetAttributeWithinLimits(key, value);
+}
 
-  recordable_->SetAttribute(key, value);
+void Span::SetAttributeWithinLimits(nostd::string_view key,
+                                    const opentelemetry::common::AttributeValue &value) noexcept
+{
+  // Only distinct keys count against the limit, so that attributes which are
+  // already set can still be updated once the limit is reached.
+  if (limits_.attribute_count_limit != SpanLimits::kUnlimited)
+  {
+    if (!can_look_up_attributes_)
+    {
+      std::string key_string{key.data(), key.size()};
+      if (attribute_keys_.size() >= limits_.attribute_count_limit &&
+          attribute_keys_.count(key_string) == 0)
+      {
+        ++dropped_attributes_count_;
+        return;
+      }
+      attribute_keys_.insert(std::move(key_string));
+    }
+    else if (num_attributes_set_ < limits_.attribute_count_limit)
+    {
+      // There are at most as many distinct keys as attributes set.
+      ++num_attributes_set_;
+    }
+    else
+    {
+      size_t num_attributes = 0;
+      bool has_key          = false;
+      recordable_->LookUpAttribute(key, &num_attributes, &has_key);
+      if (num_attributes >= limits_.attribute_count_limit && !has_key)
+      {
+        ++dropped_attributes_count_;
+        return;
+      }
+    }
+  }
+  std::vector<nostd::string_view> storage;
+  recordable_->SetAttribute(key,
+                            LimitAttributeValue(value, limits_.attribute_value_length_limit, storage));
 }
 
 void Span::AddEvent(nostd::string_view name) noexcept
@@ -144,7 +270,13 @@ void Span::AddEvent(nostd::string_view name) noexcept
   {
     return;
   }
-  recordable_->AddEvent(name);
+  if (events_count_ == limits_.event_count_limit)
+  {
+    ++dropped_events_count_;
+    return;
+  }
+  ++events_count_;
+  recordable_->AddEvent(name, clock_.SystemNow());
 }
 
 void Span::AddEvent(nostd::string_view name, core::SystemTimestamp timestamp) noexcept
@@ -154,6 +286,12 @@ void Span::AddEvent(nostd::string_view name, core::SystemTimestamp timestamp) no
   {
     return;
   }
+  if (events_count_ == limits_.event_count_limit)
+  {
+    ++dropped_events_count_;
+    return;
+  }
+  ++events_count_;
   recordable_->AddEvent(name, timestamp);
 }
 
@@ -166,7 +304,24 @@ void Span::AddEvent(nostd::string_view name,
   {
     return;
   }
-  recordable_->AddEvent(name, timestamp, attributes);
+  if (events_count_ == limits_.event_count_limit)
+  {
+    ++dropped_events_count_;
+    return;
+  }
+  ++events_count_;
+  if (attributes.size() <= limits_.attribute_per_event_count_limit &&
+      limits_.attribute_value_length_limit == SpanLimits::kUnlimited)
+  {
+    recordable_->AddEvent(name, timestamp, attributes);
+  }
+  else
+  {
+    LimitedKeyValueIterable limited_attributes{attributes, limits_.attribute_per_event_count_limit,
+                                               limits_.attribute_value_length_limit};
+    recordable_->AddEvent(name, timestamp, limited_attributes,
+                          limited_attributes.GetDroppedCount());
+  }
 }
 
 void Span::SetStatus(opentelemetry::trace::StatusCode code, nostd::string_view description) noexcept
@@ -204,10 +359,20 @@ void Span::End(const trace_api::EndSpanOptions &options) noexcept
     return;
   }
 
-  auto end_steady_time = NowOr(options.end_steady_time);
+  SteadyTimestamp end_steady_time = options.end_steady_time;
+  if (end_steady_time == SteadyTimestamp())
+  {
+    end_steady_time = clock_.SteadyNow();
+  }
   recordable_->SetDuration(std::chrono::steady_clock::time_point(end_steady_time) -
                            std::chrono::steady_clock::time_point(start_steady_time));
 
+  if (dropped_attributes_count_ != 0 || dropped_events_count_ != 0 || dropped_links_count_ != 0)
+  {
+    recordable_->SetDroppedCounts(dropped_attributes_count_, dropped_events_count_,
+                                  dropped_links_count_);
+  }
+
   processor_->OnEnd(std::move(recordable_));
   recordable_.reset();
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <mutex>
+#include <string>
+#include <unordered_set>
 
+#include "opentelemetry/sdk/trace/span_limits.h"
 #include "opentelemetry/sdk/trace/tracer.h"
 #include "opentelemetry/version.h"
 
@@ -12,17 +15,27 @@ namespace trace
 {
 namespace trace_api = opentelemetry::trace;
 
+/**
+ * The SDK span, recording into a Recordable obtained from the span processor.
+ *
+ * A span holds references to its tracer's context and to the processor it
+ * started with, so that a processor replaced meanwhile, and the context of a
+ * tracer destroyed meanwhile, are only released after the span.
+ */
 class Span final : public trace_api::Span
 {
 public:
-  Span(std::shared_ptr<Tracer> &&tracer,
-       std::shared_ptr<SpanProcessor> processor,
+  Span(const std::shared_ptr<TracerContext> &context,
+       const std::shared_ptr<
+           const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+           &instrumentation_library,
        nostd::string_view name,
        const opentelemetry::common::KeyValueIterable &attributes,
        const trace_api::SpanContextKeyValueIterable &links,
        const trace_api::StartSpanOptions &options,
        const trace_api::SpanContext &parent_span_context,
-       const opentelemetry::sdk::resource::Resource &resource,
+       const trace_api::TraceId &trace_id,
+       const trace_api::SpanId &span_id,
        const nostd::shared_ptr<opentelemetry::trace::TraceState> trace_state =
            trace_api::TraceState::GetDefault(),
        const bool sampled = false) noexcept;
@@ -49,16 +62,34 @@ class Span final : public trace_api::Span
 
   bool IsRecording() const noexcept override;
 
-  trace_api::SpanContext GetContext() const noexcept override { return *span_context_.get(); }
+  trace_api::SpanContext GetContext() const noexcept override { return span_context_; }
 
 private:
-  std::shared_ptr<trace_api::Tracer> tracer_;
-  std::shared_ptr<SpanProcessor> processor_;
+  // Set an attribute if the attribute limits allow. The mutex must be held.
+  void SetAttributeWithinLimits(nostd::string_view key,
+                                const opentelemetry::common::AttributeValue &value) noexcept;
+
+  // Destroyed last, as it keeps the clock and limits valid.
+  const std::shared_ptr<TracerContext> context_;
+  const std::shared_ptr<SpanProcessor> processor_;
+  opentelemetry::sdk::common::Clock &clock_;
+  const SpanLimits &limits_;
   mutable std::mutex mu_;
   std::unique_ptr<Recordable> recordable_;
   opentelemetry::core::SteadyTimestamp start_steady_time;
-  std::unique_ptr<trace_api::SpanContext> span_context_;
+  trace_api::SpanContext span_context_;
   bool has_ended_;
+  // The number of attributes set until the attribute count limit was reached.
+  uint32_t num_attributes_set_{0};
+  bool can_look_up_attributes_{false};
+  // The keys of the attributes set, if the attribute count is limited and the
+  // recordable cannot look up its attributes.
+  std::unordered_set<std::string> attribute_keys_;
+  uint32_t events_count_{0};
+  uint32_t links_count_{0};
+  uint32_t dropped_attributes_count_{0};
+  uint32_t dropped_events_count_{0};
+  uint32_t dropped_links_count_{0};
 };
 }  // namespace trace
 }  // namespace sdk
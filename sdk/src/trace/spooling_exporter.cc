@@ -0,0 +1,40 @@
+#include "opentelemetry/sdk/trace/spooling_exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+SpoolingSpanExporter::SpoolingSpanExporter(std::unique_ptr<EncodingSpanExporter> &&exporter,
+                                           const common::DiskSpoolOptions &options)
+    : exporter_{std::move(exporter)},
+      spooler_{options,
+               [this](nostd::string_view encoded) { return exporter_->ExportEncoded(encoded); }}
+{}
+
+std::unique_ptr<Recordable> SpoolingSpanExporter::MakeRecordable() noexcept
+{
+  return exporter_->MakeRecordable();
+}
+
+sdk::common::ExportResult SpoolingSpanExporter::Export(
+    const nostd::span<std::unique_ptr<Recordable>> &spans) noexcept
+{
+  std::string data;
+  if (exporter_->Encode(spans, &data) == false)
+  {
+    return sdk::common::ExportResult::kFailure;
+  }
+  return spooler_.Export(std::move(data));
+}
+
+bool SpoolingSpanExporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  // Replay the backlog before shutting the exporter down.
+  common::Deadline deadline(timeout);
+  spooler_.Shutdown(deadline);
+  return exporter_->Shutdown(deadline.GetRemaining());
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,386 @@
+#include "opentelemetry/sdk/trace/tail_sampling_processor.h"
+#include "opentelemetry/sdk/common/deadline.h"
+#include "opentelemetry/sdk/trace/recordable_pool.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
+
+#include <cstring>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+/**
+ * @return 8 bytes of a trace id as an integer. Trace ids are random, so that
+ * their bytes need no further hashing.
+ */
+uint64_t GetTraceIdBits(const opentelemetry::trace::TraceId &trace_id, size_t offset) noexcept
+{
+  uint64_t value = 0;
+  std::memcpy(&value, trace_id.Id().data() + offset, sizeof(value));
+  return value;
+}
+
+/**
+ * @return the interval of the scans for complete traces, so that traces are
+ * decided at most a quarter of the shorter timeout late.
+ */
+common::Executor::Clock::duration GetScanInterval(
+    const TailSamplingSpanProcessorOptions &options) noexcept
+{
+  return (std::max)(std::chrono::milliseconds(1),
+                    (std::min)(options.decision_wait, options.max_trace_duration) / 4);
+}
+}  // namespace
+
+size_t TailSamplingSpanProcessor::TraceIdHash::operator()(
+    const opentelemetry::trace::TraceId &trace_id) const noexcept
+{
+  return static_cast<size_t>(GetTraceIdBits(trace_id, 0));
+}
+
+TailSamplingSpanProcessor::TailSamplingSpanProcessor(
+    std::shared_ptr<SpanProcessor> processor,
+    const TailSamplingSpanProcessorOptions &options)
+    : processor_(std::move(processor)),
+      policies_(options.policies),
+      decision_wait_(options.decision_wait),
+      max_trace_duration_(options.max_trace_duration),
+      max_buffer_size_bytes_(options.max_buffer_size_bytes),
+      max_decisions_per_shard_(options.max_decisions /
+                               (std::max)(options.num_shards, size_t{1})),
+      scan_interval_(GetScanInterval(options)),
+      executor_(options.executor ? options.executor : std::make_shared<common::Executor>())
+{
+  shards_.resize((std::max)(options.num_shards, size_t{1}));
+  for (auto &shard : shards_)
+  {
+    shard.reset(new Shard);
+  }
+  worker_.reset(new common::ScheduledTask(
+      executor_, [this] { return DoBackgroundWork(); }, scan_interval_));
+}
+
+std::unique_ptr<Recordable> TailSamplingSpanProcessor::MakeRecordable() noexcept
+{
+  return RecordablePool<SpanData>::Acquire();
+}
+
+void TailSamplingSpanProcessor::OnStart(
+    Recordable &span,
+    const opentelemetry::trace::SpanContext &parent_context) noexcept
+{
+  processor_->OnStart(span, parent_context);
+}
+
+void TailSamplingSpanProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
+{
+  if (span == nullptr || is_shutdown_.load() == true)
+  {
+    return;
+  }
+
+  std::unique_ptr<SpanData> span_data;
+  auto shared_span = dynamic_cast<SharedSpanData *>(span.get());
+  if (shared_span != nullptr)
+  {
+    // Spans shared with other processors are copied to be buffered.
+    span_data = RecordablePool<SpanData>::Acquire();
+    if (span_data != nullptr)
+    {
+      shared_span->CopyTo(*span_data);
+    }
+    span.reset();
+  }
+  else if (dynamic_cast<SpanData *>(span.get()) != nullptr)
+  {
+    span_data.reset(static_cast<SpanData *>(span.release()));
+  }
+  if (span_data == nullptr)
+  {
+    ++dropped_span_count_;
+    return;
+  }
+
+  const auto trace_id = span_data->GetTraceId();
+  const size_t size   = span_data->GetEstimatedSize();
+  auto &shard         = GetShard(trace_id);
+  std::vector<std::unique_ptr<SpanData>> kept_spans;
+  bool is_reserved = false;
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> guard(shard.mutex);
+      auto decision = shard.decisions.find(trace_id);
+      if (decision != shard.decisions.end())
+      {
+        // The span ended after its trace was decided.
+        if (decision->second)
+        {
+          kept_spans.push_back(std::move(span_data));
+        }
+        if (is_reserved)
+        {
+          buffer_size_bytes_ -= size;
+        }
+        break;
+      }
+
+      auto it = shard.traces.find(trace_id);
+      if (!is_reserved)
+      {
+        // Deciding other traces early cannot make room for a span which does
+        // not fit into the budget along with its own trace.
+        const size_t trace_size = it != shard.traces.end() ? it->second.size : 0;
+        if (size > max_buffer_size_bytes_ || trace_size > max_buffer_size_bytes_ - size)
+        {
+          ++dropped_span_count_;
+          break;
+        }
+        is_reserved = TryReserve(size);
+      }
+      if (is_reserved)
+      {
+        if (it == shard.traces.end())
+        {
+          it                    = shard.traces.emplace(trace_id, Trace()).first;
+          it->second.first_time = common::Executor::Clock::now();
+          shard.trace_order.push_back(trace_id);
+        }
+        it->second.spans.push_back(std::move(span_data));
+        it->second.size += size;
+        it->second.last_time = common::Executor::Clock::now();
+        break;
+      }
+    }
+
+    // Make room by deciding the oldest trace of any shard early, but not the
+    // trace of the span itself. The shard is unlocked meanwhile, since no two
+    // shards are locked at once.
+    if (!DecideOldestTrace(trace_id, kept_spans))
+    {
+      ++dropped_span_count_;
+      break;
+    }
+  }
+
+  if (span_data != nullptr)
+  {
+    RecordablePool<SpanData>::Release(std::move(span_data));
+  }
+  Forward(kept_spans);
+}
+
+bool TailSamplingSpanProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+  if (is_shutdown_.load() == true)
+  {
+    return false;
+  }
+
+  common::Deadline deadline(timeout);
+  DecideTraces((common::Executor::Clock::time_point::max)());
+  return processor_->ForceFlush(deadline.GetRemaining());
+}
+
+bool TailSamplingSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  if (is_shutdown_.exchange(true) == true)
+  {
+    return false;
+  }
+
+  common::Deadline deadline(timeout);
+  worker_->Stop();
+  DecideTraces((common::Executor::Clock::time_point::max)());
+  return processor_->Shutdown(deadline.GetRemaining());
+}
+
+TailSamplingSpanProcessor::~TailSamplingSpanProcessor()
+{
+  if (is_shutdown_.load() == false)
+  {
+    Shutdown();
+  }
+}
+
+common::Executor::Clock::duration TailSamplingSpanProcessor::DoBackgroundWork()
+{
+  DecideTraces(common::Executor::Clock::now());
+  return scan_interval_;
+}
+
+void TailSamplingSpanProcessor::DecideTraces(common::Executor::Clock::time_point time) noexcept
+{
+  const bool is_all = time == (common::Executor::Clock::time_point::max)();
+  std::vector<std::unique_ptr<SpanData>> kept_spans;
+  for (auto &shard : shards_)
+  {
+    {
+      std::lock_guard<std::mutex> guard(shard->mutex);
+      for (auto it = shard->traces.begin(); it != shard->traces.end();)
+      {
+        if (is_all || time - it->second.last_time >= decision_wait_ ||
+            time - it->second.first_time >= max_trace_duration_)
+        {
+          it = DecideTrace(*shard, it, kept_spans);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      // Drop the order of the traces decided.
+      while (!shard->trace_order.empty() &&
+             shard->traces.find(shard->trace_order.front()) == shard->traces.end())
+      {
+        shard->trace_order.pop_front();
+      }
+    }
+
+    // Forward the spans outside of the lock, since the downstream processor may block.
+    Forward(kept_spans);
+  }
+}
+
+TailSamplingSpanProcessor::TraceMap::iterator TailSamplingSpanProcessor::DecideTrace(
+    Shard &shard,
+    TraceMap::iterator it,
+    std::vector<std::unique_ptr<SpanData>> &kept_spans) noexcept
+{
+  auto &trace  = it->second;
+  bool is_kept = policies_.empty();
+  for (auto &policy : policies_)
+  {
+    if (policy->ShouldKeep(trace.spans))
+    {
+      is_kept = true;
+      break;
+    }
+  }
+
+  buffer_size_bytes_ -= trace.size;
+  if (is_kept)
+  {
+    ++kept_trace_count_;
+    for (auto &span : trace.spans)
+    {
+      kept_spans.push_back(std::move(span));
+    }
+  }
+  else
+  {
+    ++dropped_trace_count_;
+    for (auto &span : trace.spans)
+    {
+      RecordablePool<SpanData>::Release(std::move(span));
+    }
+  }
+
+  // Remember the decision for the spans ending later.
+  if (max_decisions_per_shard_ > 0 && shard.decisions.emplace(it->first, is_kept).second)
+  {
+    shard.decision_order.push_back(it->first);
+    if (shard.decision_order.size() > max_decisions_per_shard_)
+    {
+      shard.decisions.erase(shard.decision_order.front());
+      shard.decision_order.pop_front();
+    }
+  }
+  return shard.traces.erase(it);
+}
+
+bool TailSamplingSpanProcessor::DecideOldestTrace(
+    const opentelemetry::trace::TraceId &excluded_trace_id,
+    std::vector<std::unique_ptr<SpanData>> &kept_spans) noexcept
+{
+  Shard *oldest_shard = nullptr;
+  auto oldest_time    = (common::Executor::Clock::time_point::max)();
+  for (auto &shard : shards_)
+  {
+    std::lock_guard<std::mutex> guard(shard->mutex);
+    auto it = FindOldestTrace(*shard, excluded_trace_id);
+    if (it != shard->traces.end() && it->second.first_time <= oldest_time)
+    {
+      oldest_shard = shard.get();
+      oldest_time  = it->second.first_time;
+    }
+  }
+  if (oldest_shard == nullptr)
+  {
+    return false;
+  }
+
+  // The trace may have been decided meanwhile, which made room as well.
+  std::lock_guard<std::mutex> guard(oldest_shard->mutex);
+  auto it = FindOldestTrace(*oldest_shard, excluded_trace_id);
+  if (it != oldest_shard->traces.end())
+  {
+    DecideTrace(*oldest_shard, it, kept_spans);
+  }
+  return true;
+}
+
+TailSamplingSpanProcessor::TraceMap::iterator TailSamplingSpanProcessor::FindOldestTrace(
+    Shard &shard,
+    const opentelemetry::trace::TraceId &excluded_trace_id) noexcept
+{
+  // Drop the order of the traces decided.
+  while (!shard.trace_order.empty() &&
+         shard.traces.find(shard.trace_order.front()) == shard.traces.end())
+  {
+    shard.trace_order.pop_front();
+  }
+  for (const auto &trace_id : shard.trace_order)
+  {
+    if (trace_id != excluded_trace_id)
+    {
+      auto it = shard.traces.find(trace_id);
+      if (it != shard.traces.end())
+      {
+        return it;
+      }
+    }
+  }
+  return shard.traces.end();
+}
+
+bool TailSamplingSpanProcessor::TryReserve(size_t size) noexcept
+{
+  size_t current = buffer_size_bytes_.load();
+  do
+  {
+    if (current + size > max_buffer_size_bytes_)
+    {
+      return false;
+    }
+  } while (!buffer_size_bytes_.compare_exchange_weak(current, current + size));
+  return true;
+}
+
+void TailSamplingSpanProcessor::Forward(std::vector<std::unique_ptr<SpanData>> &spans) noexcept
+{
+  for (auto &span : spans)
+  {
+    std::shared_ptr<const SpanData> span_data(span.release(), [](const SpanData *span_data) {
+      RecordablePool<SpanData>::Release(
+          std::unique_ptr<SpanData>(const_cast<SpanData *>(span_data)));
+    });
+    processor_->OnEnd(std::unique_ptr<Recordable>(new SharedSpanData(std::move(span_data))));
+  }
+  spans.clear();
+}
+
+TailSamplingSpanProcessor::Shard &TailSamplingSpanProcessor::GetShard(
+    const opentelemetry::trace::TraceId &trace_id) noexcept
+{
+  // The other half of the trace id than the hash, so that the traces of a
+  // shard spread over all buckets of its map.
+  return *shards_[GetTraceIdBits(trace_id, 8) % shards_.size()];
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -1,7 +1,6 @@
 #include "opentelemetry/sdk/trace/tracer.h"
 #include "opentelemetry/context/runtime_context.h"
 #include "opentelemetry/nostd/shared_ptr.h"
-#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
 #include "opentelemetry/version.h"
 #include "src/trace/span.h"
 
@@ -10,25 +9,55 @@ namespace sdk
 {
 namespace trace
 {
+Tracer::Tracer(std::shared_ptr<TracerContext> context,
+               std::unique_ptr<opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary>
+                   instrumentation_library) noexcept
+    : context_{context}, instrumentation_library_{std::move(instrumentation_library)}
+{}
+
 Tracer::Tracer(std::shared_ptr<SpanProcessor> processor,
                const opentelemetry::sdk::resource::Resource &resource,
-               std::shared_ptr<Sampler> sampler) noexcept
-    : processor_{processor}, sampler_{sampler}, resource_{resource}
+               std::shared_ptr<Sampler> sampler,
+               std::shared_ptr<IdGenerator> id_generator,
+               std::shared_ptr<opentelemetry::sdk::common::Clock> clock,
+               const SpanLimits &span_limits) noexcept
+    : Tracer(std::make_shared<TracerContext>(processor, resource, sampler, id_generator, clock,
+                                             span_limits))
 {}
 
 void Tracer::SetProcessor(std::shared_ptr<SpanProcessor> processor) noexcept
 {
-  processor_.store(processor);
+  context_->SetProcessor(processor);
 }
 
 std::shared_ptr<SpanProcessor> Tracer::GetProcessor() const noexcept
 {
-  return processor_.load();
+  return context_->GetProcessor();
+}
+
+void Tracer::SetSampler(std::shared_ptr<Sampler> sampler) noexcept
+{
+  context_->SetSampler(sampler);
 }
 
 std::shared_ptr<Sampler> Tracer::GetSampler() const noexcept
 {
-  return sampler_;
+  return context_->GetSampler();
+}
+
+std::shared_ptr<IdGenerator> Tracer::GetIdGenerator() const noexcept
+{
+  return context_->GetIdGenerator();
+}
+
+std::shared_ptr<opentelemetry::sdk::common::Clock> Tracer::GetClock() const noexcept
+{
+  return context_->GetClock();
+}
+
+const SpanLimits &Tracer::GetSpanLimits() const noexcept
+{
+  return context_->GetSpanLimits();
 }
 
 trace_api::SpanContext GetCurrentSpanContext(const trace_api::SpanContext &explicit_parent)
@@ -60,22 +89,32 @@ nostd::shared_ptr<trace_api::Span> Tracer::StartSpan(
 {
   trace_api::SpanContext parent = GetCurrentSpanContext(options.parent);
 
-  auto sampling_result =
-      sampler_->ShouldSample(parent, parent.trace_id(), name, options.kind, attributes, links);
+  // Keeps the sampler read below valid.
+  opentelemetry::sdk::common::EpochGuard epoch_guard;
+
+  // The trace id of a root span is generated before sampling, so that samplers
+  // can base their decision on it.
+  auto &id_generator = *context_->GetIdGenerator();
+  trace_api::TraceId trace_id =
+      parent.IsValid() ? parent.trace_id() : id_generator.GenerateTraceId();
+
+  auto sampling_result = context_->GetActiveSampler().ShouldSample(parent, trace_id, name,
+                                                                   options.kind, attributes, links);
   if (sampling_result.decision == Decision::DROP)
   {
-    // Don't allocate a no-op span for every DROP decision, but use a static
-    // singleton for this case.
-    static nostd::shared_ptr<trace_api::Span> noop_span(
-        new trace_api::NoopSpan{this->shared_from_this()});
+    // Don't allocate a no-op span for every DROP decision, but use a
+    // per-thread singleton for this case. Sharing one instance between all
+    // threads would make its reference count a point of contention.
+    static thread_local nostd::shared_ptr<trace_api::Span> noop_span(
+        new trace_api::NoopSpan{nullptr});
 
     return noop_span;
   }
   else
   {
     auto span = nostd::shared_ptr<trace_api::Span>{new (std::nothrow) Span{
-        this->shared_from_this(), processor_.load(), name, attributes, links, options, parent,
-        resource_, sampling_result.trace_state, true}};
+        context_, instrumentation_library_, name, attributes, links, options, parent, trace_id,
+        id_generator.GenerateSpanId(), sampling_result.trace_state, true}};
 
     // if the attributes is not nullptr, add attributes to the span.
     if (sampling_result.attributes)
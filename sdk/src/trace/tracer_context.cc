@@ -0,0 +1,43 @@
+#include "opentelemetry/sdk/trace/tracer_context.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+TracerContext::TracerContext(std::shared_ptr<SpanProcessor> processor,
+                             opentelemetry::sdk::resource::Resource resource,
+                             std::shared_ptr<Sampler> sampler,
+                             std::shared_ptr<IdGenerator> id_generator,
+                             std::shared_ptr<opentelemetry::sdk::common::Clock> clock,
+                             const SpanLimits &span_limits) noexcept
+    : processor_{processor},
+      resource_{resource},
+      sampler_{sampler},
+      id_generator_{id_generator},
+      clock_{clock},
+      span_limits_(span_limits)
+{}
+
+void TracerContext::SetProcessor(std::shared_ptr<SpanProcessor> processor) noexcept
+{
+  processor_.store(processor);
+}
+
+std::shared_ptr<SpanProcessor> TracerContext::GetProcessor() const noexcept
+{
+  return processor_.load();
+}
+
+void TracerContext::SetSampler(std::shared_ptr<Sampler> sampler) noexcept
+{
+  sampler_.store(sampler);
+}
+
+std::shared_ptr<Sampler> TracerContext::GetSampler() const noexcept
+{
+  return sampler_.load();
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
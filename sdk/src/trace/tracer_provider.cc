@@ -5,43 +5,105 @@ namespace sdk
 {
 namespace trace
 {
+namespace
+{
+const std::shared_ptr<Tracer> *FindTracer(const std::vector<std::shared_ptr<Tracer>> &tracers,
+                                          nostd::string_view library_name,
+                                          nostd::string_view library_version) noexcept
+{
+  for (auto &tracer : tracers)
+  {
+    if (tracer->GetInstrumentationLibrary().equal(library_name, library_version))
+    {
+      return &tracer;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
 TracerProvider::TracerProvider(std::shared_ptr<SpanProcessor> processor,
                                opentelemetry::sdk::resource::Resource &&resource,
-                               std::shared_ptr<Sampler> sampler) noexcept
-    : processor_{processor},
-      tracer_(new Tracer(std::move(processor), resource, sampler)),
-      sampler_(sampler),
-      resource_(resource)
+                               std::shared_ptr<Sampler> sampler,
+                               std::shared_ptr<IdGenerator> id_generator,
+                               std::shared_ptr<opentelemetry::sdk::common::Clock> clock,
+                               const SpanLimits &span_limits) noexcept
+    : TracerProvider(std::make_shared<TracerContext>(
+          std::move(processor), std::move(resource), sampler, id_generator, clock, span_limits))
+{}
+
+TracerProvider::TracerProvider(std::shared_ptr<TracerContext> context) noexcept
+    : context_{context}, tracers_{std::make_shared<TracerList>()}
 {}
 
 opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer> TracerProvider::GetTracer(
     nostd::string_view library_name,
     nostd::string_view library_version) noexcept
 {
-  return opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>(tracer_);
+  opentelemetry::sdk::common::EpochGuard epoch_guard;
+  auto tracer = FindTracer(*tracers_.get(), library_name, library_version);
+  if (tracer != nullptr)
+  {
+    return opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>(*tracer);
+  }
+
+  std::lock_guard<std::mutex> guard{tracers_mutex_};
+
+  // Another thread may have created the tracer in the meantime.
+  auto &tracers = *tracers_.get();
+  tracer        = FindTracer(tracers, library_name, library_version);
+  if (tracer != nullptr)
+  {
+    return opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>(*tracer);
+  }
+
+  auto new_tracer = std::make_shared<Tracer>(
+      context_, opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create(
+                    library_name, library_version));
+  auto new_tracers = std::make_shared<TracerList>(tracers);
+  new_tracers->push_back(new_tracer);
+  tracers_.store(new_tracers);
+  return opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>(new_tracer);
 }
 
 void TracerProvider::SetProcessor(std::shared_ptr<SpanProcessor> processor) noexcept
 {
-  processor_.store(processor);
-
-  auto sdkTracer = static_cast<Tracer *>(tracer_.get());
-  sdkTracer->SetProcessor(processor);
+  context_->SetProcessor(processor);
 }
 
 std::shared_ptr<SpanProcessor> TracerProvider::GetProcessor() const noexcept
 {
-  return processor_.load();
+  return context_->GetProcessor();
+}
+
+void TracerProvider::SetSampler(std::shared_ptr<Sampler> sampler) noexcept
+{
+  context_->SetSampler(sampler);
 }
 
 std::shared_ptr<Sampler> TracerProvider::GetSampler() const noexcept
 {
-  return sampler_;
+  return context_->GetSampler();
+}
+
+std::shared_ptr<IdGenerator> TracerProvider::GetIdGenerator() const noexcept
+{
+  return context_->GetIdGenerator();
+}
+
+std::shared_ptr<opentelemetry::sdk::common::Clock> TracerProvider::GetClock() const noexcept
+{
+  return context_->GetClock();
+}
+
+const SpanLimits &TracerProvider::GetSpanLimits() const noexcept
+{
+  return context_->GetSpanLimits();
 }
 
 const opentelemetry::sdk::resource::Resource &TracerProvider::GetResource() const noexcept
 {
-  return resource_;
+  return context_->GetResource();
 }
 
 bool TracerProvider::Shutdown() noexcept
@@ -0,0 +1,107 @@
+#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using opentelemetry::sdk::common::AtomicSharedPtr;
+using opentelemetry::sdk::common::EpochGuard;
+using opentelemetry::sdk::common::RetireAfterGracePeriod;
+
+namespace
+{
+/**
+ * Releases a guard after the interval between the passes releasing retired
+ * values on the release of guards.
+ */
+void ReleaseGuardLater()
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EpochGuard guard;
+}
+}  // namespace
+
+TEST(AtomicSharedPtrTest, StoreAndLoad)
+{
+  AtomicSharedPtr<int> ptr{std::make_shared<int>(11)};
+  EXPECT_EQ(*ptr.load(), 11);
+
+  ptr.store(std::make_shared<int>(33));
+  EXPECT_EQ(*ptr.load(), 33);
+
+  EpochGuard guard;
+  EXPECT_EQ(*ptr.get(), 33);
+}
+
+TEST(AtomicSharedPtrTest, ReleasesReplacedValues)
+{
+  auto value = std::make_shared<int>(11);
+  std::weak_ptr<int> weak_value{value};
+  AtomicSharedPtr<int> ptr{std::move(value)};
+
+  {
+    // The value read under the guard stays valid until the guard is released.
+    EpochGuard guard;
+    int *current = ptr.get();
+    ptr.store(std::make_shared<int>(33));
+    EXPECT_FALSE(weak_value.expired());
+    EXPECT_EQ(*current, 11);
+  }
+  ReleaseGuardLater();
+  EXPECT_TRUE(weak_value.expired());
+
+  // Without readers, replaced values are released at once.
+  for (int i = 0; i < 1000; ++i)
+  {
+    weak_value = ptr.load();
+    ptr.store(std::make_shared<int>(i));
+    EXPECT_TRUE(weak_value.expired());
+  }
+}
+
+TEST(AtomicSharedPtrTest, GuardsMovedAcrossThreads)
+{
+  auto value = std::make_shared<int>(11);
+  std::weak_ptr<int> weak_value{value};
+
+  EpochGuard guard;
+  RetireAfterGracePeriod(std::move(value));
+  EXPECT_FALSE(weak_value.expired());
+
+  std::thread([&guard] { EpochGuard released{std::move(guard)}; }).join();
+  ReleaseGuardLater();
+  EXPECT_TRUE(weak_value.expired());
+}
+
+TEST(AtomicSharedPtrTest, ConcurrentReadersAndWriters)
+{
+  AtomicSharedPtr<std::vector<int>> ptr{std::make_shared<std::vector<int>>(16, 0)};
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+  {
+    readers.emplace_back([&] {
+      while (!done)
+      {
+        EpochGuard guard;
+        auto &values = *ptr.get();
+        int first    = values.front();
+        for (int value : values)
+        {
+          ASSERT_EQ(value, first);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 10000; ++i)
+  {
+    ptr.store(std::make_shared<std::vector<int>>(16, i));
+  }
+  done = true;
+  for (auto &reader : readers)
+  {
+    reader.join();
+  }
+}
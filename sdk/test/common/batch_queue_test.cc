@@ -0,0 +1,217 @@
+#include "opentelemetry/sdk/common/batch_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::AtomicUniquePtr;
+using opentelemetry::sdk::common::BatchQueue;
+using opentelemetry::sdk::common::CircularBufferRange;
+using opentelemetry::sdk::common::ForEachExportBatch;
+using opentelemetry::sdk::common::OverflowPolicy;
+namespace nostd = opentelemetry::nostd;
+
+static bool AddNumber(BatchQueue<int> &queue, int number, int *notifications = nullptr)
+{
+  std::unique_ptr<int> x{new int{number}};
+  return queue.Add(x, [&] {
+    if (notifications != nullptr)
+    {
+      ++*notifications;
+    }
+  });
+}
+
+static std::vector<int> ConsumeNumbers(BatchQueue<int> &queue)
+{
+  std::vector<int> numbers;
+  queue.Consume(queue.size(), [&](CircularBufferRange<AtomicUniquePtr<int>> range) noexcept {
+    range.ForEach([&](AtomicUniquePtr<int> &ptr) noexcept {
+      numbers.push_back(*ptr);
+      ptr.Reset();
+      return true;
+    });
+  });
+  return numbers;
+}
+
+TEST(BatchQueueTest, DropNewest)
+{
+  BatchQueue<int> queue{2, 1};
+  int notifications = 0;
+  EXPECT_TRUE(AddNumber(queue, 1, &notifications));
+  EXPECT_TRUE(AddNumber(queue, 2, &notifications));
+  EXPECT_FALSE(AddNumber(queue, 3, &notifications));
+  EXPECT_EQ(notifications, 1);
+  EXPECT_EQ(queue.accepted_count(), 2);
+  EXPECT_EQ(queue.dropped_count(), 1);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{1, 2}));
+}
+
+TEST(BatchQueueTest, NotifyOncePerConsume)
+{
+  BatchQueue<int> queue{4, 1};
+  int notifications = 0;
+  EXPECT_TRUE(AddNumber(queue, 1, &notifications));
+  EXPECT_EQ(notifications, 0);
+  EXPECT_TRUE(AddNumber(queue, 2, &notifications));
+  EXPECT_TRUE(AddNumber(queue, 3, &notifications));
+  EXPECT_EQ(notifications, 1);
+
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(AddNumber(queue, 4, &notifications));
+  EXPECT_TRUE(AddNumber(queue, 5, &notifications));
+  EXPECT_EQ(notifications, 2);
+}
+
+TEST(BatchQueueTest, DropOldest)
+{
+  BatchQueue<int> queue{2, 1, OverflowPolicy::kDropOldest};
+  EXPECT_TRUE(AddNumber(queue, 1));
+  EXPECT_TRUE(AddNumber(queue, 2));
+  EXPECT_TRUE(AddNumber(queue, 3));
+  EXPECT_EQ(queue.accepted_count(), 2);
+  EXPECT_EQ(queue.dropped_count(), 1);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{2, 3}));
+}
+
+TEST(BatchQueueTest, DropLowestPriority)
+{
+  BatchQueue<int> queue{3, 1, OverflowPolicy::kDropLowestPriority, std::chrono::milliseconds(0),
+                        [](const int &x) { return x; }};
+  EXPECT_TRUE(AddNumber(queue, 5));
+  EXPECT_TRUE(AddNumber(queue, 1));
+  EXPECT_TRUE(AddNumber(queue, 2));
+
+  // The element with the lowest priority is replaced.
+  EXPECT_TRUE(AddNumber(queue, 3));
+  // No element has a lower priority than the new element.
+  EXPECT_FALSE(AddNumber(queue, 2));
+  EXPECT_EQ(queue.accepted_count(), 3);
+  EXPECT_EQ(queue.dropped_count(), 2);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{5, 3, 2}));
+}
+
+TEST(BatchQueueTest, DropLowestPriorityWithoutPriority)
+{
+  BatchQueue<int> queue{1, 1, OverflowPolicy::kDropLowestPriority};
+  EXPECT_EQ(queue.policy(), OverflowPolicy::kDropNewest);
+}
+
+TEST(BatchQueueTest, Block)
+{
+  BatchQueue<int> queue{1, 1, OverflowPolicy::kBlock, std::chrono::milliseconds(10)};
+  EXPECT_TRUE(AddNumber(queue, 1));
+
+  // Times out.
+  int notifications = 0;
+  EXPECT_FALSE(AddNumber(queue, 2, &notifications));
+  EXPECT_GE(notifications, 1);
+  EXPECT_EQ(queue.dropped_count(), 1);
+}
+
+TEST(BatchQueueTest, BlockUntilConsumed)
+{
+  BatchQueue<int> queue{1, 1, OverflowPolicy::kBlock, std::chrono::milliseconds(60000)};
+  EXPECT_TRUE(AddNumber(queue, 1));
+
+  std::atomic<bool> waiting{false};
+  std::vector<int> numbers;
+  std::thread consumer{[&] {
+    while (!waiting)
+    {
+      std::this_thread::yield();
+    }
+    numbers = ConsumeNumbers(queue);
+  }};
+  std::unique_ptr<int> x{new int{2}};
+  EXPECT_TRUE(queue.Add(x, [&] { waiting = true; }));
+  consumer.join();
+  EXPECT_EQ(numbers, (std::vector<int>{1}));
+  EXPECT_EQ(queue.accepted_count(), 2);
+  EXPECT_EQ(queue.dropped_count(), 0);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{2}));
+}
+
+TEST(BatchQueueTest, MemoryBudget)
+{
+  // The size of an element is its value.
+  auto size = [](const int &x) { return static_cast<size_t>(x); };
+  BatchQueue<int> queue{10, 1, OverflowPolicy::kDropNewest, std::chrono::milliseconds(0), nullptr,
+                        10, size};
+  EXPECT_TRUE(AddNumber(queue, 4));
+  EXPECT_TRUE(AddNumber(queue, 5));
+  EXPECT_FALSE(AddNumber(queue, 2));
+  EXPECT_TRUE(AddNumber(queue, 1));
+  EXPECT_EQ(queue.queued_bytes(), 10);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{4, 5, 1}));
+  EXPECT_EQ(queue.queued_bytes(), 0);
+
+  // An element larger than the budget never fits.
+  EXPECT_FALSE(AddNumber(queue, 11));
+  EXPECT_EQ(queue.dropped_count(), 2);
+}
+
+TEST(BatchQueueTest, MemoryBudgetDropOldest)
+{
+  auto size = [](const int &x) { return static_cast<size_t>(x); };
+  BatchQueue<int> queue{10, 1, OverflowPolicy::kDropOldest, std::chrono::milliseconds(0), nullptr,
+                        10, size};
+  EXPECT_TRUE(AddNumber(queue, 4));
+  EXPECT_TRUE(AddNumber(queue, 3));
+  EXPECT_TRUE(AddNumber(queue, 3));
+  EXPECT_TRUE(AddNumber(queue, 7));
+  EXPECT_EQ(queue.accepted_count(), 2);
+  EXPECT_EQ(queue.dropped_count(), 2);
+  EXPECT_EQ(queue.queued_bytes(), 10);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{3, 7}));
+}
+
+TEST(BatchQueueTest, MemoryBudgetDropLowestPriority)
+{
+  auto identity = [](const int &x) { return x; };
+  auto size     = [](const int &x) { return static_cast<size_t>(x); };
+  BatchQueue<int> queue{10, 1, OverflowPolicy::kDropLowestPriority, std::chrono::milliseconds(0),
+                        identity, 10, size};
+  EXPECT_TRUE(AddNumber(queue, 2));
+  EXPECT_TRUE(AddNumber(queue, 5));
+
+  // Replacing 2 with 6 would exceed the budget, but not with 4.
+  EXPECT_FALSE(AddNumber(queue, 6));
+  EXPECT_TRUE(AddNumber(queue, 4));
+  EXPECT_EQ(queue.queued_bytes(), 9);
+  EXPECT_EQ(ConsumeNumbers(queue), (std::vector<int>{4, 5}));
+}
+
+TEST(BatchQueueTest, ForEachExportBatch)
+{
+  std::vector<std::unique_ptr<int>> elements;
+  for (int x : {3, 4, 12, 1, 1, 1, 1})
+  {
+    elements.emplace_back(new int{x});
+  }
+  auto size = [](const int &x) { return static_cast<size_t>(x); };
+  std::vector<std::vector<int>> batches;
+  auto callback = [&](nostd::span<std::unique_ptr<int>> batch) {
+    batches.emplace_back();
+    for (auto &element : batch)
+    {
+      batches.back().push_back(*element);
+    }
+  };
+
+  // Batches are cut by size, and by count.
+  ForEachExportBatch(nostd::span<std::unique_ptr<int>>(elements.data(), elements.size()), 3, 8,
+                     size, callback);
+  EXPECT_EQ(batches, (std::vector<std::vector<int>>{{3, 4}, {12}, {1, 1, 1}, {1}}));
+
+  batches.clear();
+  ForEachExportBatch(nostd::span<std::unique_ptr<int>>(elements.data(), elements.size()), 0, 0,
+                     size, callback);
+  EXPECT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches.front().size(), elements.size());
+
+  batches.clear();
+  ForEachExportBatch(nostd::span<std::unique_ptr<int>>(), 3, 8, size, callback);
+  EXPECT_EQ(batches, (std::vector<std::vector<int>>{{}}));
+}
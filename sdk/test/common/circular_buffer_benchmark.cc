@@ -9,10 +9,14 @@
 #include <vector>
 
 #include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/sdk/common/sequenced_circular_buffer.h"
+#include "opentelemetry/sdk/common/sharded_circular_buffer.h"
 #include "test/common/baseline_circular_buffer.h"
 using opentelemetry::sdk::common::AtomicUniquePtr;
 using opentelemetry::sdk::common::CircularBuffer;
 using opentelemetry::sdk::common::CircularBufferRange;
+using opentelemetry::sdk::common::SequencedCircularBuffer;
+using opentelemetry::sdk::common::ShardedCircularBuffer;
 using opentelemetry::testing::BaselineCircularBuffer;
 
 const int N = 10000;
@@ -27,7 +31,8 @@ static uint64_t ConsumeBufferNumbers(BaselineCircularBuffer<uint64_t> &buffer) n
   return result;
 }
 
-static uint64_t ConsumeBufferNumbers(CircularBuffer<uint64_t> &buffer) noexcept
+template <class Buffer>
+static uint64_t ConsumeBufferNumbers(Buffer &buffer) noexcept
 {
   uint64_t result = 0;
   buffer.Consume(buffer.size(),
@@ -125,6 +130,36 @@ static void BM_LockFreeBuffer(benchmark::State &state)
   }
 }
 
-BENCHMARK(BM_LockFreeBuffer)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK(BM_LockFreeBuffer)->RangeMultiplier(2)->Range(1, 64);
+
+static void BM_SequencedBuffer(benchmark::State &state)
+{
+  const size_t max_elements = 500;
+  const int num_threads     = static_cast<int>(state.range(0));
+  const int n               = static_cast<int>(N / num_threads);
+  SequencedCircularBuffer<uint64_t> buffer{max_elements};
+  for (auto _ : state)
+  {
+    RunSimulation(buffer, num_threads, n);
+  }
+}
+
+BENCHMARK(BM_SequencedBuffer)->RangeMultiplier(2)->Range(1, 64);
+
+// Scaling of the sequenced buffer split into one shard per producer thread,
+// which is to be compared with BM_SequencedBuffer.
+static void BM_ShardedBuffer(benchmark::State &state)
+{
+  const size_t max_elements = 500;
+  const int num_threads     = static_cast<int>(state.range(0));
+  const int n               = static_cast<int>(N / num_threads);
+  ShardedCircularBuffer<uint64_t> buffer{max_elements, static_cast<size_t>(num_threads)};
+  for (auto _ : state)
+  {
+    RunSimulation(buffer, num_threads, n);
+  }
+}
+
+BENCHMARK(BM_ShardedBuffer)->RangeMultiplier(2)->Range(1, 64);
 
 BENCHMARK_MAIN();
@@ -56,8 +56,11 @@ void RunNumberConsumer(CircularBuffer<uint32_t> &buffer,
 {
   while (true)
   {
-    auto allotment = buffer.Peek();
-    if (exit && allotment.empty())
+    // Read exit before peeking, so that no element added before the exit is
+    // left in the buffer.
+    bool should_exit = exit;
+    auto allotment   = buffer.Peek();
+    if (should_exit && allotment.empty())
     {
       return;
     }
@@ -0,0 +1,107 @@
+#include "opentelemetry/sdk/common/clock.h"
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::common::AnchoredClock;
+using opentelemetry::sdk::common::Clock;
+using opentelemetry::sdk::common::CoarseClock;
+using opentelemetry::sdk::common::SystemClock;
+using opentelemetry::sdk::common::TscClock;
+
+namespace
+{
+std::chrono::nanoseconds Distance(std::chrono::nanoseconds a, std::chrono::nanoseconds b)
+{
+  return a > b ? a - b : b - a;
+}
+
+// Checks that the clock is close to the standard clocks and moves forward.
+void ExpectCloseToStandardClocks(Clock &clock, std::chrono::nanoseconds tolerance)
+{
+  auto system_time = std::chrono::system_clock::now().time_since_epoch();
+  auto steady_time = std::chrono::steady_clock::now().time_since_epoch();
+
+  auto now = clock.Now();
+  EXPECT_LE(Distance(now.system_time.time_since_epoch(), system_time), tolerance);
+  EXPECT_LE(Distance(now.steady_time.time_since_epoch(), steady_time), tolerance);
+  EXPECT_LE(Distance(clock.SystemNow().time_since_epoch(), system_time), tolerance);
+  EXPECT_LE(Distance(clock.SteadyNow().time_since_epoch(), steady_time), tolerance);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  auto later = clock.Now();
+  EXPECT_GT(later.system_time.time_since_epoch(), now.system_time.time_since_epoch());
+  EXPECT_GT(later.steady_time.time_since_epoch(), now.steady_time.time_since_epoch());
+}
+}  // namespace
+
+TEST(ClockTest, SystemClock)
+{
+  ExpectCloseToStandardClocks(*SystemClock::GetInstance(), std::chrono::milliseconds{50});
+  EXPECT_EQ(SystemClock::GetInstance(), SystemClock::GetInstance());
+}
+
+TEST(ClockTest, CoarseClock)
+{
+  CoarseClock clock;
+  ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+}
+
+TEST(ClockTest, TscClock)
+{
+  TscClock clock;
+  ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+
+  clock.Calibrate(std::chrono::milliseconds{1});
+  ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+}
+
+TEST(ClockTest, TscClockCalibratedWhileRead)
+{
+  TscClock clock{std::chrono::milliseconds{1}};
+  std::thread calibrator([&clock]() {
+    for (int i = 0; i < 20; ++i)
+    {
+      clock.Calibrate(std::chrono::microseconds{100});
+    }
+  });
+  for (int i = 0; i < 10000; ++i)
+  {
+    auto system_time = std::chrono::system_clock::now().time_since_epoch();
+    EXPECT_LE(Distance(clock.SystemNow().time_since_epoch(), system_time),
+              std::chrono::milliseconds{50});
+  }
+  calibrator.join();
+}
+
+TEST(ClockTest, AnchoredClock)
+{
+  AnchoredClock clock;
+  ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+
+  // Other threads take their own anchor.
+  std::thread thread(
+      [&clock]() { ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50}); });
+  thread.join();
+}
+
+TEST(ClockTest, AnchoredClockResync)
+{
+  AnchoredClock clock{std::chrono::milliseconds{1}};
+  ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+  ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+}
+
+TEST(ClockTest, AnchoredClocksOnOneThread)
+{
+  // Each clock keeps its own anchor, with its own resync interval.
+  AnchoredClock clock{std::chrono::hours{1}};
+  AnchoredClock other_clock{std::chrono::milliseconds{1}};
+  for (int i = 0; i < 3; ++i)
+  {
+    ExpectCloseToStandardClocks(clock, std::chrono::milliseconds{50});
+    ExpectCloseToStandardClocks(other_clock, std::chrono::milliseconds{50});
+  }
+}
@@ -0,0 +1,31 @@
+#include "opentelemetry/sdk/common/deadline.h"
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::common::Deadline;
+
+TEST(DeadlineTest, Expires)
+{
+  Deadline deadline{std::chrono::milliseconds(50)};
+  EXPECT_FALSE(deadline.IsExpired());
+  EXPECT_GT(deadline.GetRemaining(), std::chrono::microseconds::zero());
+
+  Deadline expired{std::chrono::microseconds(-1)};
+  EXPECT_TRUE(expired.IsExpired());
+  EXPECT_EQ(expired.GetRemaining(), std::chrono::microseconds::zero());
+}
+
+TEST(DeadlineTest, HugeTimeoutsNeverExpire)
+{
+  // Timeouts beyond the range of the steady clock saturate instead of overflowing.
+  for (auto timeout : {(std::chrono::microseconds::max)(),
+                       (std::chrono::microseconds::max)() - std::chrono::microseconds(1),
+                       Deadline{(std::chrono::microseconds::max)()}.GetRemaining(),
+                       std::chrono::duration_cast<std::chrono::microseconds>(
+                           (std::chrono::nanoseconds::max)())})
+  {
+    Deadline deadline{timeout};
+    EXPECT_FALSE(deadline.IsExpired());
+    EXPECT_EQ(deadline.GetRemaining(), (std::chrono::microseconds::max)());
+  }
+}
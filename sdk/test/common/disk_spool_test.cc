@@ -0,0 +1,276 @@
+#include "opentelemetry/sdk/common/disk_spool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::nostd::string_view;
+using opentelemetry::sdk::common::Deadline;
+using opentelemetry::sdk::common::DiskSpool;
+using opentelemetry::sdk::common::DiskSpoolOptions;
+using opentelemetry::sdk::common::ExportResult;
+using opentelemetry::sdk::common::Spooler;
+
+namespace
+{
+std::vector<std::string> ReadAll(DiskSpool &spool)
+{
+  std::vector<std::string> records;
+  std::string record;
+  while (spool.Peek(&record))
+  {
+    records.push_back(record);
+    spool.Pop();
+  }
+  return records;
+}
+
+/**
+ * Keeps the spool of every test in the temporary directory, under the name of
+ * the test, and deletes its files before and after the test.
+ */
+class DiskSpoolTest : public ::testing::Test
+{
+protected:
+  void SetUp() override { RemoveSpool(); }
+
+  void TearDown() override { RemoveSpool(); }
+
+  DiskSpoolOptions MakeOptions() const
+  {
+    const auto *test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    DiskSpoolOptions options;
+    options.directory        = ::testing::TempDir();
+    options.name             = std::string("disk_spool_test_") + test_info->name();
+    options.max_segment_size = 64;
+    options.max_total_size   = 1024;
+    options.replay_interval  = std::chrono::milliseconds(0);
+    return options;
+  }
+
+  /**
+   * Deletes the files of the spool by reading it entirely.
+   */
+  void RemoveSpool() const
+  {
+    DiskSpool spool{MakeOptions()};
+    ReadAll(spool);
+  }
+};
+
+class SpoolerTest : public DiskSpoolTest
+{};
+
+/**
+ * A backend receiving the batches replayed on the executor.
+ */
+class TestBackend
+{
+public:
+  ExportResult Export(string_view data)
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (result_ == ExportResult::kSuccess)
+    {
+      exported_.push_back(std::string(data.data(), data.size()));
+      cv_.notify_all();
+    }
+    return result_;
+  }
+
+  void SetResult(ExportResult result)
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    result_ = result;
+  }
+
+  /**
+   * Waits until the given number of batches were exported.
+   * @return the batches exported
+   */
+  std::vector<std::string> WaitForExported(size_t count)
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    cv_.wait_for(lock, std::chrono::seconds(10), [&] { return exported_.size() >= count; });
+    return exported_;
+  }
+
+  Spooler::ExportEncoded GetExportEncoded()
+  {
+    return [this](string_view data) { return Export(data); };
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  ExportResult result_ = ExportResult::kFailureRetryable;
+  std::vector<std::string> exported_;
+};
+}  // namespace
+
+TEST_F(DiskSpoolTest, ReadsRecordsInOrder)
+{
+  DiskSpool spool{MakeOptions()};
+  EXPECT_TRUE(spool.empty());
+
+  // Every segment holds one record of 12 + 40 bytes.
+  std::vector<std::string> records;
+  for (char c : {'a', 'b', 'c'})
+  {
+    records.push_back(std::string(40, c));
+    EXPECT_TRUE(spool.Append(records.back()));
+  }
+  EXPECT_EQ(spool.size(), 3 * 52);
+
+  std::string record;
+  EXPECT_TRUE(spool.Peek(&record));
+  EXPECT_TRUE(spool.Peek(&record));
+  EXPECT_EQ(record, records[0]);
+
+  EXPECT_EQ(ReadAll(spool), records);
+  EXPECT_TRUE(spool.empty());
+  EXPECT_EQ(spool.size(), 0);
+}
+
+TEST_F(DiskSpoolTest, RecoversAfterRestart)
+{
+  auto options = MakeOptions();
+  {
+    DiskSpool spool{options};
+    EXPECT_TRUE(spool.Append("first"));
+    EXPECT_TRUE(spool.Append(std::string(60, 'x')));
+    EXPECT_TRUE(spool.Append("last"));
+
+    std::string record;
+    EXPECT_TRUE(spool.Peek(&record));
+    spool.Pop();
+  }
+
+  // The first segment was read entirely before the restart.
+  DiskSpool spool{options};
+  EXPECT_FALSE(spool.empty());
+  EXPECT_TRUE(spool.Append("after restart"));
+  EXPECT_EQ(ReadAll(spool),
+            (std::vector<std::string>{std::string(60, 'x'), "last", "after restart"}));
+  EXPECT_EQ(spool.evicted_count(), 0);
+}
+
+TEST_F(DiskSpoolTest, SkipsCorruptedSegments)
+{
+  auto options = MakeOptions();
+  {
+    DiskSpool spool{options};
+    EXPECT_TRUE(spool.Append(std::string(50, 'x')));
+    EXPECT_TRUE(spool.Append("intact"));
+  }
+
+  // Flip a byte of the payload of the first record.
+  std::string path =
+      options.directory + "/" + options.name + "-00000000000000000000.spool";
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  std::fseek(file, 14, SEEK_SET);
+  std::fputc('X', file);
+  std::fclose(file);
+
+  DiskSpool spool{options};
+  EXPECT_EQ(ReadAll(spool), (std::vector<std::string>{"intact"}));
+  EXPECT_EQ(spool.evicted_count(), 1);
+}
+
+TEST_F(DiskSpoolTest, EvictsOldestSegments)
+{
+  auto options           = MakeOptions();
+  options.max_total_size = 3 * 52;
+  DiskSpool spool{options};
+
+  for (char c : {'a', 'b', 'c', 'd'})
+  {
+    EXPECT_TRUE(spool.Append(std::string(40, c)));
+  }
+  EXPECT_EQ(spool.evicted_count(), 1);
+  EXPECT_EQ(spool.size(), 3 * 52);
+
+  // Records larger than the spool are rejected.
+  EXPECT_FALSE(spool.Append(std::string(3 * 52, 'e')));
+
+  EXPECT_EQ(ReadAll(spool), (std::vector<std::string>{std::string(40, 'b'), std::string(40, 'c'),
+                                                       std::string(40, 'd')}));
+}
+
+TEST_F(SpoolerTest, ReplaysInOrderAfterRecovery)
+{
+  auto options               = MakeOptions();
+  options.replay_interval    = std::chrono::milliseconds(10);
+  options.max_replay_batches = 1;
+  TestBackend backend;
+  Spooler spooler{options, backend.GetExportEncoded()};
+
+  EXPECT_EQ(spooler.Export("1"), ExportResult::kSuccess);
+  EXPECT_EQ(spooler.Export("2"), ExportResult::kSuccess);
+
+  // The new batch is exported behind the backlog.
+  backend.SetResult(ExportResult::kSuccess);
+  EXPECT_EQ(spooler.Export("3"), ExportResult::kSuccess);
+  EXPECT_EQ(backend.WaitForExported(3), (std::vector<std::string>{"1", "2", "3"}));
+}
+
+TEST_F(SpoolerTest, ReplaysWithoutNewExports)
+{
+  auto options            = MakeOptions();
+  options.replay_interval = std::chrono::milliseconds(10);
+  TestBackend backend;
+  Spooler spooler{options, backend.GetExportEncoded()};
+
+  EXPECT_EQ(spooler.Export("1"), ExportResult::kSuccess);
+  backend.SetResult(ExportResult::kSuccess);
+  EXPECT_EQ(backend.WaitForExported(1), (std::vector<std::string>{"1"}));
+}
+
+TEST_F(SpoolerTest, ReplaysOnShutdown)
+{
+  auto options            = MakeOptions();
+  options.replay_interval = std::chrono::hours(1);
+  TestBackend backend;
+  Spooler spooler{options, backend.GetExportEncoded()};
+
+  EXPECT_EQ(spooler.Export("1"), ExportResult::kSuccess);
+  EXPECT_EQ(spooler.Export("2"), ExportResult::kSuccess);
+
+  // Shutdown does not wait for the replay interval.
+  backend.SetResult(ExportResult::kSuccess);
+  spooler.Shutdown(Deadline(std::chrono::seconds(10)));
+  EXPECT_EQ(backend.WaitForExported(0), (std::vector<std::string>{"1", "2"}));
+}
+
+TEST_F(SpoolerTest, ReplaysAfterRestart)
+{
+  auto options            = MakeOptions();
+  options.replay_interval = std::chrono::hours(1);
+  TestBackend backend;
+  {
+    Spooler spooler{options, backend.GetExportEncoded()};
+    EXPECT_EQ(spooler.Export("1"), ExportResult::kSuccess);
+  }
+
+  backend.SetResult(ExportResult::kSuccess);
+  Spooler spooler{options, backend.GetExportEncoded()};
+  EXPECT_EQ(backend.WaitForExported(1), (std::vector<std::string>{"1"}));
+}
+
+TEST_F(SpoolerTest, ReturnsPermanentFailures)
+{
+  TestBackend backend;
+  Spooler spooler{MakeOptions(), backend.GetExportEncoded()};
+
+  // A batch rejected by the backend is not spooled.
+  backend.SetResult(ExportResult::kFailure);
+  EXPECT_EQ(spooler.Export("1"), ExportResult::kFailure);
+  backend.SetResult(ExportResult::kSuccess);
+  EXPECT_EQ(spooler.Export("2"), ExportResult::kSuccess);
+  EXPECT_EQ(backend.WaitForExported(0), (std::vector<std::string>{"2"}));
+}
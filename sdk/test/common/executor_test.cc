@@ -0,0 +1,148 @@
+#include "opentelemetry/sdk/common/executor.h"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::Executor;
+using opentelemetry::sdk::common::ScheduledTask;
+
+TEST(ExecutorTest, RunsTasksInTimeOrder)
+{
+  Executor executor{1};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<int> order;
+  auto now = Executor::Clock::now();
+  for (int i : {3, 1, 2})
+  {
+    executor.Schedule(now + std::chrono::milliseconds(10 * i), [&, i] {
+      std::lock_guard<std::mutex> guard{mutex};
+      order.push_back(i);
+      cv.notify_one();
+    });
+  }
+
+  std::unique_lock<std::mutex> lock{mutex};
+  cv.wait(lock, [&] { return order.size() == 3; });
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(ExecutorTest, DiscardsTasksOnDestruction)
+{
+  std::atomic<bool> is_run{false};
+  {
+    Executor executor{2};
+    executor.Schedule(Executor::Clock::now() + std::chrono::hours(1), [&] { is_run = true; });
+  }
+  EXPECT_FALSE(is_run);
+}
+
+TEST(ScheduledTaskTest, RunsPeriodically)
+{
+  auto executor = std::make_shared<Executor>();
+  std::atomic<int> runs{0};
+  ScheduledTask task{executor,
+                     [&] {
+                       ++runs;
+                       return std::chrono::milliseconds(1);
+                     },
+                     std::chrono::milliseconds(0)};
+  while (runs < 3)
+  {
+    std::this_thread::yield();
+  }
+  task.Stop();
+  int stopped_runs = runs;
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(runs, stopped_runs);
+}
+
+TEST(ScheduledTaskTest, Wake)
+{
+  auto executor = std::make_shared<Executor>();
+  std::atomic<int> runs{0};
+  ScheduledTask task{executor,
+                     [&] {
+                       ++runs;
+                       return (Executor::Clock::duration::max)();
+                     },
+                     std::chrono::hours(1)};
+  EXPECT_EQ(runs, 0);
+  task.Wake();
+  while (runs < 1)
+  {
+    std::this_thread::yield();
+  }
+  task.Wake();
+  while (runs < 2)
+  {
+    std::this_thread::yield();
+  }
+}
+
+TEST(ScheduledTaskTest, WakeWhileRunning)
+{
+  auto executor = std::make_shared<Executor>(4);
+  std::atomic<bool> is_running{false};
+  std::atomic<bool> is_woken{false};
+  std::atomic<int> runs{0};
+  std::atomic<int> concurrent_runs{0};
+  std::atomic<bool> was_concurrent{false};
+  ScheduledTask task{executor,
+                     [&] {
+                       if (++concurrent_runs > 1)
+                       {
+                         was_concurrent = true;
+                       }
+                       is_running = true;
+                       while (runs == 0 && !is_woken)
+                       {
+                         std::this_thread::yield();
+                       }
+                       ++runs;
+                       --concurrent_runs;
+                       return (Executor::Clock::duration::max)();
+                     },
+                     std::chrono::milliseconds(0)};
+  while (!is_running)
+  {
+    std::this_thread::yield();
+  }
+
+  // The task runs again after the run in progress, not concurrently with it.
+  task.Wake();
+  task.Wake();
+  is_woken = true;
+  while (runs < 2)
+  {
+    std::this_thread::yield();
+  }
+  task.Stop();
+  EXPECT_EQ(runs, 2);
+  EXPECT_FALSE(was_concurrent);
+}
+
+TEST(ScheduledTaskTest, SharedExecutor)
+{
+  auto executor = std::make_shared<Executor>(1);
+  std::atomic<int> runs_a{0};
+  std::atomic<int> runs_b{0};
+  ScheduledTask a{executor,
+                  [&] {
+                    ++runs_a;
+                    return std::chrono::milliseconds(1);
+                  },
+                  std::chrono::milliseconds(0)};
+  ScheduledTask b{executor,
+                  [&] {
+                    ++runs_b;
+                    return std::chrono::milliseconds(1);
+                  },
+                  std::chrono::milliseconds(0)};
+  while (runs_a < 3 || runs_b < 3)
+  {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(executor->num_threads(), 1);
+}
@@ -0,0 +1,113 @@
+#include "opentelemetry/sdk/common/flat_attribute_map.h"
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::common::FlatAttributeMap;
+
+TEST(FlatAttributeMapTest, DefaultConstruction)
+{
+  FlatAttributeMap<4> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.GetAttributes().size(), 0);
+}
+
+TEST(FlatAttributeMapTest, AttributesConstruction)
+{
+  const int kNumAttributes              = 3;
+  std::string keys[kNumAttributes]      = {"attr1", "attr2", "attr3"};
+  int values[kNumAttributes]            = {15, 24, 37};
+  std::map<std::string, int> attributes = {
+      {keys[0], values[0]}, {keys[1], values[1]}, {keys[2], values[2]}};
+
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, int>> iterable(attributes);
+  FlatAttributeMap<4> map(iterable);
+
+  ASSERT_EQ(map.size(), kNumAttributes);
+  for (int i = 0; i < kNumAttributes; i++)
+  {
+    EXPECT_EQ(opentelemetry::nostd::get<int>(map.GetAttributes().at(keys[i])), values[i]);
+  }
+  EXPECT_EQ(map.count("attr4"), 0);
+  EXPECT_EQ(map.find("attr4"), map.end());
+  EXPECT_THROW(map.at("attr4"), std::out_of_range);
+}
+
+TEST(FlatAttributeMapTest, LastWriteWins)
+{
+  FlatAttributeMap<4> map;
+  map.SetAttribute("attr1", 1);
+  map.SetAttribute("attr2", "value");
+  map.SetAttribute("attr1", 2);
+
+  ASSERT_EQ(map.size(), 2);
+  EXPECT_EQ(opentelemetry::nostd::get<int>(map.at("attr1")), 2);
+  EXPECT_EQ(opentelemetry::nostd::get<std::string>(map.at("attr2")), "value");
+}
+
+TEST(FlatAttributeMapTest, InsertionOrderBeyondInlineCapacity)
+{
+  const int kNumAttributes = 20;
+  FlatAttributeMap<2> map;
+  std::vector<std::string> keys;
+  for (int i = 0; i < kNumAttributes; i++)
+  {
+    keys.push_back("attr" + std::to_string(i));
+    map.SetAttribute(keys.back(), i);
+  }
+
+  ASSERT_EQ(map.size(), kNumAttributes);
+  int i = 0;
+  for (const auto &attribute : map)
+  {
+    EXPECT_EQ(attribute.first, keys[i]);
+    EXPECT_EQ(opentelemetry::nostd::get<int>(attribute.second), i);
+    i++;
+  }
+}
+
+TEST(FlatAttributeMapTest, CopyAndMove)
+{
+  for (int num_attributes : {1, 5})
+  {
+    FlatAttributeMap<2> map;
+    for (int i = 0; i < num_attributes; i++)
+    {
+      map.SetAttribute("attr" + std::to_string(i), i);
+    }
+
+    FlatAttributeMap<2> copy(map);
+    ASSERT_EQ(copy.size(), map.size());
+    EXPECT_EQ(opentelemetry::nostd::get<int>(copy.at("attr0")), 0);
+
+    FlatAttributeMap<2> moved(std::move(copy));
+    ASSERT_EQ(moved.size(), map.size());
+    EXPECT_EQ(copy.size(), 0);
+    EXPECT_EQ(opentelemetry::nostd::get<int>(moved.at("attr0")), 0);
+
+    FlatAttributeMap<2> assigned;
+    assigned.SetAttribute("other", true);
+    assigned = moved;
+    ASSERT_EQ(assigned.size(), map.size());
+    EXPECT_EQ(assigned.count("other"), 0);
+
+    assigned = std::move(moved);
+    ASSERT_EQ(assigned.size(), map.size());
+    EXPECT_EQ(moved.size(), 0);
+  }
+}
+
+TEST(FlatAttributeMapTest, Clear)
+{
+  FlatAttributeMap<2> map;
+  for (int i = 0; i < 5; i++)
+  {
+    map.SetAttribute("attr" + std::to_string(i), i);
+  }
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+
+  map.SetAttribute("attr", 1);
+  ASSERT_EQ(map.size(), 1);
+  EXPECT_EQ(opentelemetry::nostd::get<int>(map.at("attr")), 1);
+}
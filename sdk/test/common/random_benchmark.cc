@@ -1,3 +1,4 @@
+#include "opentelemetry/sdk/trace/random_id_generator.h"
 #include "src/common/random.h"
 
 #include <cstdint>
@@ -8,6 +9,7 @@
 namespace
 {
 using opentelemetry::sdk::common::Random;
+using opentelemetry::sdk::trace::RandomIdGenerator;
 
 void BM_RandomIdGeneration(benchmark::State &state)
 {
@@ -28,5 +30,59 @@ void BM_RandomIdStdGeneration(benchmark::State &state)
 }
 BENCHMARK(BM_RandomIdStdGeneration);
 
+// Report the number of ids generated per second by each thread.
+void SetIdsPerSecond(benchmark::State &state)
+{
+  state.counters["ids_per_second_per_thread"] = benchmark::Counter(
+      static_cast<double>(state.iterations()), benchmark::Counter::kAvgThreadsRate);
+}
+
+// Span ids generated the way spans used to generate them, one random buffer at a time.
+void BM_SpanIdFromRandomBuffer(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    uint8_t span_id_buf[opentelemetry::trace::SpanId::kSize];
+    Random::GenerateRandomBuffer(span_id_buf);
+    benchmark::DoNotOptimize(opentelemetry::trace::SpanId(span_id_buf));
+  }
+  SetIdsPerSecond(state);
+}
+BENCHMARK(BM_SpanIdFromRandomBuffer)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_SpanIdFromRandomIdGenerator(benchmark::State &state)
+{
+  RandomIdGenerator id_generator;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(id_generator.GenerateSpanId());
+  }
+  SetIdsPerSecond(state);
+}
+BENCHMARK(BM_SpanIdFromRandomIdGenerator)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_TraceIdFromRandomBuffer(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    uint8_t trace_id_buf[opentelemetry::trace::TraceId::kSize];
+    Random::GenerateRandomBuffer(trace_id_buf);
+    benchmark::DoNotOptimize(opentelemetry::trace::TraceId(trace_id_buf));
+  }
+  SetIdsPerSecond(state);
+}
+BENCHMARK(BM_TraceIdFromRandomBuffer)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_TraceIdFromRandomIdGenerator(benchmark::State &state)
+{
+  RandomIdGenerator id_generator;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(id_generator.GenerateTraceId());
+  }
+  SetIdsPerSecond(state);
+}
+BENCHMARK(BM_TraceIdFromRandomIdGenerator)->ThreadRange(1, 64)->UseRealTime();
+
 }  // namespace
 BENCHMARK_MAIN();
@@ -14,6 +14,7 @@
 using opentelemetry::sdk::common::Random;
 
 static uint64_t *child_id;
+static uint64_t *child_batch_id;
 
 int main()
 {
@@ -23,9 +24,20 @@ int main()
   child_id = static_cast<uint64_t *>(
       mmap(nullptr, sizeof(*child_id), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
   *child_id = 0;
+  child_batch_id =
+      static_cast<uint64_t *>(mmap(nullptr, sizeof(*child_batch_id), PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+  *child_batch_id = 0;
+
+  // Pre-generate a block of numbers in the parent, which the child must not reuse.
+  uint64_t batch_id[1];
+  Random::GenerateRandomBatch(batch_id);
+
   if (fork() == 0)
   {
     *child_id = Random::GenerateRandom64();
+    Random::GenerateRandomBatch(batch_id);
+    *child_batch_id = batch_id[0];
     exit(EXIT_SUCCESS);
   }
   else
@@ -39,6 +51,15 @@ int main()
       std::cerr << "Child and parent ids are the same value " << parent_id << "\n";
       return -1;
     }
+
+    Random::GenerateRandomBatch(batch_id);
+    auto child_batch_id_copy = *child_batch_id;
+    munmap(static_cast<void *>(child_batch_id), sizeof(*child_batch_id));
+    if (batch_id[0] == child_batch_id_copy)
+    {
+      std::cerr << "Child and parent batch ids are the same value " << batch_id[0] << "\n";
+      return -1;
+    }
   }
   return 0;
 }
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <set>
+#include <vector>
 
 #include <gtest/gtest.h>
 using opentelemetry::sdk::common::Random;
@@ -30,3 +32,18 @@ TEST(RandomTest, GenerateRandomBuffer)
     EXPECT_FALSE(std::equal(std::begin(buf1), std::end(buf1), std::begin(buf2)));
   }
 }
+
+TEST(RandomTest, GenerateRandomBatch)
+{
+  // Request more numbers than fit into a block, so that it is refilled.
+  std::vector<uint64_t> values(1000);
+  Random::GenerateRandomBatch(values);
+  std::set<uint64_t> unique_values(values.begin(), values.end());
+  EXPECT_EQ(unique_values.size(), values.size());
+
+  uint64_t value1[1] = {0};
+  uint64_t value2[1] = {0};
+  Random::GenerateRandomBatch(value1);
+  Random::GenerateRandomBatch(value2);
+  EXPECT_NE(value1[0], value2[0]);
+}
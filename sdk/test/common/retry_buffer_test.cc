@@ -0,0 +1,126 @@
+#include "opentelemetry/sdk/common/retry_buffer.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::nostd::span;
+using opentelemetry::sdk::common::ExportResult;
+using opentelemetry::sdk::common::RetryBuffer;
+using opentelemetry::sdk::common::RetryOptions;
+
+namespace
+{
+RetryOptions MakeOptions()
+{
+  RetryOptions options;
+  options.max_attempts          = 3;
+  options.initial_backoff       = std::chrono::milliseconds(100);
+  options.max_backoff           = std::chrono::milliseconds(200);
+  options.max_buffer_size       = 4;
+  options.max_buffer_size_bytes = 0;
+  return options;
+}
+
+size_t GetSize(const int &value)
+{
+  return static_cast<size_t>(value);
+}
+
+std::vector<std::unique_ptr<int>> MakeBatch(std::initializer_list<int> values)
+{
+  std::vector<std::unique_ptr<int>> batch;
+  for (int value : values)
+  {
+    batch.emplace_back(new int{value});
+  }
+  return batch;
+}
+}  // namespace
+
+TEST(RetryBufferTest, RetriesAfterBackoff)
+{
+  RetryBuffer<int> buffer{MakeOptions(), GetSize};
+  auto batch = MakeBatch({1, 2});
+  auto start = RetryBuffer<int>::Clock::now();
+  EXPECT_TRUE(buffer.Add(span<std::unique_ptr<int>>{batch.data(), batch.size()}, 1));
+  EXPECT_FALSE(buffer.empty());
+
+  // The jitter draws the backoff between half and all of the initial backoff.
+  auto retry_time = buffer.next_retry_time();
+  EXPECT_GE(retry_time, start + std::chrono::milliseconds(50));
+  EXPECT_LE(retry_time, RetryBuffer<int>::Clock::now() + std::chrono::milliseconds(100));
+
+  std::vector<int> exported;
+  auto export_batch = [&](span<std::unique_ptr<int>> retried) {
+    for (auto &value : retried)
+    {
+      exported.push_back(*value);
+    }
+    return ExportResult::kSuccess;
+  };
+  buffer.Retry(start, export_batch);
+  EXPECT_TRUE(exported.empty());
+
+  buffer.Retry(retry_time, export_batch);
+  EXPECT_EQ(exported, (std::vector<int>{1, 2}));
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.next_retry_time(), (RetryBuffer<int>::Clock::time_point::max)());
+}
+
+TEST(RetryBufferTest, DropsAfterMaxAttempts)
+{
+  RetryBuffer<int> buffer{MakeOptions(), GetSize};
+  auto batch = MakeBatch({1, 2});
+  EXPECT_TRUE(buffer.Add(span<std::unique_ptr<int>>{batch.data(), batch.size()}, 1));
+
+  size_t num_attempts = 1;
+  while (!buffer.empty())
+  {
+    buffer.Retry((RetryBuffer<int>::Clock::time_point::max)(), [&](span<std::unique_ptr<int>>) {
+      ++num_attempts;
+      return ExportResult::kFailureRetryable;
+    });
+  }
+  EXPECT_EQ(num_attempts, 3);
+  EXPECT_EQ(buffer.dropped_count(), 2);
+}
+
+TEST(RetryBufferTest, SkipsTakenElements)
+{
+  RetryBuffer<int> buffer{MakeOptions(), GetSize};
+  auto batch = MakeBatch({1, 2});
+  batch[0].reset();
+  EXPECT_TRUE(buffer.Add(span<std::unique_ptr<int>>{batch.data(), batch.size()}, 1));
+
+  size_t num_exported = 0;
+  buffer.Retry((RetryBuffer<int>::Clock::time_point::max)(),
+               [&](span<std::unique_ptr<int>> retried) {
+                 num_exported += retried.size();
+                 return ExportResult::kSuccess;
+               });
+  EXPECT_EQ(num_exported, 1);
+}
+
+TEST(RetryBufferTest, DropsBatchesNotFitting)
+{
+  auto options                  = MakeOptions();
+  options.max_buffer_size_bytes = 10;
+  RetryBuffer<int> buffer{options, GetSize};
+
+  auto batch1 = MakeBatch({1, 2, 3});
+  EXPECT_TRUE(buffer.Add(span<std::unique_ptr<int>>{batch1.data(), batch1.size()}, 1));
+
+  // The buffer holds 6 bytes of 10.
+  auto batch2 = MakeBatch({5});
+  EXPECT_FALSE(buffer.Add(span<std::unique_ptr<int>>{batch2.data(), batch2.size()}, 1));
+  EXPECT_NE(batch2[0], nullptr);
+
+  // The buffer holds 3 elements of 4.
+  auto batch3 = MakeBatch({1, 1});
+  EXPECT_FALSE(buffer.Add(span<std::unique_ptr<int>>{batch3.data(), batch3.size()}, 1));
+
+  auto batch4 = MakeBatch({4});
+  EXPECT_TRUE(buffer.Add(span<std::unique_ptr<int>>{batch4.data(), batch4.size()}, 1));
+  EXPECT_EQ(buffer.dropped_count(), 3);
+}
@@ -0,0 +1,220 @@
+#include "opentelemetry/sdk/common/sequenced_circular_buffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::AtomicUniquePtr;
+using opentelemetry::sdk::common::CircularBufferRange;
+using opentelemetry::sdk::common::SequencedCircularBuffer;
+namespace nostd = opentelemetry::nostd;
+
+static thread_local std::mt19937 RandomNumberGenerator{std::random_device{}()};
+
+static void GenerateRandomNumbers(SequencedCircularBuffer<uint32_t> &buffer,
+                                  std::vector<uint32_t> &numbers,
+                                  int n)
+{
+  const size_t max_batch_size = 3;
+  for (int i = 0; i < n;)
+  {
+    // Add the numbers one by one or in small batches.
+    auto batch_size =
+        std::uniform_int_distribution<size_t>{1, max_batch_size}(RandomNumberGenerator);
+    uint32_t values[max_batch_size];
+    std::unique_ptr<uint32_t> batch[max_batch_size];
+    for (size_t j = 0; j < batch_size; ++j)
+    {
+      values[j] = static_cast<uint32_t>(RandomNumberGenerator());
+      batch[j].reset(new uint32_t{values[j]});
+    }
+    auto added = buffer.AddN(nostd::span<std::unique_ptr<uint32_t>>{batch, batch_size});
+    for (size_t j = 0; j < added; ++j)
+    {
+      assert(batch[j] == nullptr);
+      numbers.push_back(values[j]);
+    }
+    i += static_cast<int>(batch_size);
+  }
+}
+
+static void RunNumberProducers(SequencedCircularBuffer<uint32_t> &buffer,
+                               std::vector<uint32_t> &numbers,
+                               int num_threads,
+                               int n)
+{
+  std::vector<std::vector<uint32_t>> thread_numbers(num_threads);
+  std::vector<std::thread> threads(num_threads);
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    threads[thread_index] = std::thread{GenerateRandomNumbers, std::ref(buffer),
+                                        std::ref(thread_numbers[thread_index]), n};
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    numbers.insert(numbers.end(), thread_numbers[thread_index].begin(),
+                   thread_numbers[thread_index].end());
+  }
+}
+
+static void RunNumberConsumer(SequencedCircularBuffer<uint32_t> &buffer,
+                              std::atomic<bool> &exit,
+                              std::vector<uint32_t> &numbers)
+{
+  while (true)
+  {
+    // Read exit before peeking, so that no element added before the exit is
+    // left in the buffer.
+    bool should_exit = exit;
+    auto allotment   = buffer.Peek();
+    if (should_exit && allotment.empty())
+    {
+      return;
+    }
+    auto n = std::uniform_int_distribution<size_t>{0, allotment.size()}(RandomNumberGenerator);
+    buffer.Consume(n, [&](CircularBufferRange<AtomicUniquePtr<uint32_t>> range) noexcept {
+      assert(range.size() == n);
+      range.ForEach([&](AtomicUniquePtr<uint32_t> &ptr) noexcept {
+        assert(!ptr.IsNull());
+        numbers.push_back(*ptr);
+        ptr.Reset();
+        return true;
+      });
+    });
+  }
+}
+
+TEST(SequencedCircularBufferTest, Add)
+{
+  SequencedCircularBuffer<int> buffer{10};
+
+  std::unique_ptr<int> x{new int{11}};
+  EXPECT_TRUE(buffer.Add(x));
+  EXPECT_EQ(x, nullptr);
+  auto range = buffer.Peek();
+  EXPECT_EQ(range.size(), 1);
+  range.ForEach([](const AtomicUniquePtr<int> &y) {
+    EXPECT_EQ(*y, 11);
+    return true;
+  });
+}
+
+TEST(SequencedCircularBufferTest, AddN)
+{
+  SequencedCircularBuffer<int> buffer{3};
+
+  std::unique_ptr<int> xs[] = {std::unique_ptr<int>{new int{1}}, std::unique_ptr<int>{new int{2}}};
+  EXPECT_EQ(buffer.AddN(nostd::span<std::unique_ptr<int>>{xs}), 2);
+  EXPECT_EQ(xs[0], nullptr);
+  EXPECT_EQ(xs[1], nullptr);
+
+  // Only the elements which fit are added.
+  std::unique_ptr<int> ys[] = {std::unique_ptr<int>{new int{3}}, std::unique_ptr<int>{new int{4}}};
+  EXPECT_EQ(buffer.AddN(nostd::span<std::unique_ptr<int>>{ys}), 1);
+  EXPECT_EQ(ys[0], nullptr);
+  ASSERT_NE(ys[1], nullptr);
+  EXPECT_EQ(*ys[1], 4);
+
+  int count = 0;
+  buffer.Consume(3, [&](CircularBufferRange<AtomicUniquePtr<int>> range) noexcept {
+    range.ForEach([&](AtomicUniquePtr<int> &ptr) {
+      EXPECT_EQ(*ptr, ++count);
+      ptr.Reset();
+      return true;
+    });
+  });
+  EXPECT_EQ(count, 3);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SequencedCircularBufferTest, Clear)
+{
+  SequencedCircularBuffer<int> buffer{10};
+
+  std::unique_ptr<int> x{new int{11}};
+  EXPECT_TRUE(buffer.Add(x));
+  EXPECT_EQ(x, nullptr);
+  buffer.Clear();
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SequencedCircularBufferTest, AddOnFull)
+{
+  SequencedCircularBuffer<int> buffer{10};
+  for (int i = 0; i < static_cast<int>(buffer.max_size()); ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+  std::unique_ptr<int> x{new int{33}};
+  EXPECT_FALSE(buffer.Add(x));
+  EXPECT_NE(x, nullptr);
+  EXPECT_EQ(*x, 33);
+}
+
+TEST(SequencedCircularBufferTest, Consume)
+{
+  SequencedCircularBuffer<int> buffer{10};
+  for (int i = 0; i < static_cast<int>(buffer.max_size()); ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+  int count = 0;
+  EXPECT_EQ(5, buffer.Consume(5, [&](CircularBufferRange<AtomicUniquePtr<int>> range) noexcept {
+    range.ForEach([&](AtomicUniquePtr<int> &ptr) {
+      EXPECT_EQ(*ptr, count++);
+      ptr.Reset();
+      return true;
+    });
+  }));
+  EXPECT_EQ(count, 5);
+
+  // The freed slots are reused after wrapping around.
+  for (int i = 10; i < 15; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+  EXPECT_EQ(buffer.size(), 10);
+  buffer.Consume(10, [&](CircularBufferRange<AtomicUniquePtr<int>> range) noexcept {
+    range.ForEach([&](AtomicUniquePtr<int> &ptr) {
+      EXPECT_EQ(*ptr, count++);
+      ptr.Reset();
+      return true;
+    });
+  });
+  EXPECT_EQ(count, 15);
+  EXPECT_EQ(buffer.consumption_count(), 15);
+  EXPECT_EQ(buffer.production_count(), 15);
+}
+
+TEST(SequencedCircularBufferTest, Simulation)
+{
+  const int num_producer_threads = 4;
+  const int n                    = 25000;
+  for (size_t max_size : {1, 2, 10, 50, 100, 1000})
+  {
+    SequencedCircularBuffer<uint32_t> buffer{max_size};
+    std::vector<uint32_t> producer_numbers;
+    std::vector<uint32_t> consumer_numbers;
+    auto producers = std::thread{RunNumberProducers, std::ref(buffer), std::ref(producer_numbers),
+                                 num_producer_threads, n};
+    std::atomic<bool> exit{false};
+    auto consumer = std::thread{RunNumberConsumer, std::ref(buffer), std::ref(exit),
+                                std::ref(consumer_numbers)};
+    producers.join();
+    exit = true;
+    consumer.join();
+    std::sort(producer_numbers.begin(), producer_numbers.end());
+    std::sort(consumer_numbers.begin(), consumer_numbers.end());
+    EXPECT_EQ(producer_numbers, consumer_numbers);
+  }
+}
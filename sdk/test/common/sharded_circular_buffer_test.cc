@@ -0,0 +1,92 @@
+#include "opentelemetry/sdk/common/sharded_circular_buffer.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::AtomicUniquePtr;
+using opentelemetry::sdk::common::CircularBufferRange;
+using opentelemetry::sdk::common::ShardedCircularBuffer;
+
+static std::vector<int> ConsumeNumbers(ShardedCircularBuffer<int> &buffer, size_t n)
+{
+  std::vector<int> numbers;
+  buffer.Consume(n, [&](CircularBufferRange<AtomicUniquePtr<int>> range) noexcept {
+    range.ForEach([&](AtomicUniquePtr<int> &ptr) noexcept {
+      numbers.push_back(*ptr);
+      ptr.Reset();
+      return true;
+    });
+  });
+  return numbers;
+}
+
+static void AddNumbers(ShardedCircularBuffer<int> &buffer, int first, int n)
+{
+  for (int i = first; i < first + n; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+}
+
+TEST(ShardedCircularBufferTest, SingleShard)
+{
+  ShardedCircularBuffer<int> buffer{4, 1};
+  EXPECT_EQ(buffer.num_shards(), 1);
+  EXPECT_EQ(buffer.max_size(), 4);
+  AddNumbers(buffer, 0, 4);
+  std::unique_ptr<int> x{new int{4}};
+  EXPECT_FALSE(buffer.Add(x));
+  EXPECT_EQ(buffer.size(), 4);
+  EXPECT_EQ(ConsumeNumbers(buffer, 3), (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(ConsumeNumbers(buffer, 1), (std::vector<int>{3}));
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(ShardedCircularBufferTest, ThreadsUseSeparateShards)
+{
+  ShardedCircularBuffer<int> buffer{10, 2};
+  EXPECT_EQ(buffer.max_size(), 10);
+
+  // Consecutively started threads are assigned different shards.
+  std::thread{AddNumbers, std::ref(buffer), 0, 5}.join();
+  std::thread{AddNumbers, std::ref(buffer), 100, 1}.join();
+  EXPECT_EQ(buffer.size(), 6);
+
+  // Every shard is offered an equal share of a batch, and the remainder is
+  // taken from the shards that have more elements.
+  auto numbers = ConsumeNumbers(buffer, 4);
+  std::sort(numbers.begin(), numbers.end());
+  EXPECT_EQ(numbers, (std::vector<int>{0, 1, 2, 100}));
+
+  EXPECT_EQ(ConsumeNumbers(buffer, 4), (std::vector<int>{3, 4}));
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(ShardedCircularBufferTest, Simulation)
+{
+  const int num_threads = 8;
+  const int n           = 1000;
+  ShardedCircularBuffer<int> buffer{num_threads * n, 4};
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    threads.emplace_back(AddNumbers, std::ref(buffer), thread_index * n, n);
+  }
+  std::vector<int> numbers;
+  for (auto &thread : threads)
+  {
+    thread.join();
+    auto consumed = ConsumeNumbers(buffer, buffer.size());
+    numbers.insert(numbers.end(), consumed.begin(), consumed.end());
+  }
+  EXPECT_TRUE(buffer.empty());
+  std::sort(numbers.begin(), numbers.end());
+  ASSERT_EQ(numbers.size(), num_threads * n);
+  for (int i = 0; i < num_threads * n; ++i)
+  {
+    EXPECT_EQ(numbers[i], i);
+  }
+}
@@ -0,0 +1,115 @@
+#include "opentelemetry/sdk/common/string_intern_table.h"
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::common::InternedString;
+using opentelemetry::sdk::common::StringInternTable;
+
+TEST(StringInternTable, Intern)
+{
+  StringInternTable table;
+  auto span   = table.Intern("span");
+  auto other  = table.Intern("other");
+  auto again  = table.Intern(std::string("span"));
+  auto unseen = table.Find("unseen");
+
+  ASSERT_TRUE(span.IsValid());
+  ASSERT_TRUE(other.IsValid());
+  EXPECT_EQ(span.GetValue(), "span");
+  EXPECT_EQ(other.GetValue(), "other");
+  EXPECT_NE(span.GetId(), other.GetId());
+  EXPECT_TRUE(span == again);
+  EXPECT_EQ(span.GetId(), again.GetId());
+  EXPECT_TRUE(span == table.Find("span"));
+  EXPECT_FALSE(unseen.IsValid());
+  EXPECT_EQ(table.size(), 2);
+}
+
+TEST(StringInternTable, InvalidHandle)
+{
+  InternedString handle;
+  EXPECT_FALSE(handle.IsValid());
+  EXPECT_EQ(handle.GetId(), 0);
+  EXPECT_EQ(handle.GetValue(), "");
+}
+
+TEST(StringInternTable, EmptyString)
+{
+  StringInternTable table;
+  auto empty = table.Intern("");
+  ASSERT_TRUE(empty.IsValid());
+  EXPECT_EQ(empty.GetValue(), "");
+  EXPECT_NE(empty.GetId(), 0);
+}
+
+TEST(StringInternTable, TooLong)
+{
+  StringInternTable table;
+  std::string max_length(StringInternTable::kMaxLength, 'a');
+  std::string too_long(StringInternTable::kMaxLength + 1, 'a');
+  EXPECT_TRUE(table.Intern(max_length).IsValid());
+  EXPECT_FALSE(table.Intern(too_long).IsValid());
+}
+
+TEST(StringInternTable, Full)
+{
+  // At most half of the 16 slots are used.
+  StringInternTable table(16);
+  for (int i = 0; i < 8; ++i)
+  {
+    EXPECT_TRUE(table.Intern(std::to_string(i)).IsValid());
+  }
+  EXPECT_FALSE(table.Intern("8").IsValid());
+  EXPECT_EQ(table.size(), 8);
+
+  // Strings interned before are still found.
+  EXPECT_EQ(table.Intern("3").GetValue(), "3");
+}
+
+TEST(StringInternTable, ConcurrentIntern)
+{
+  StringInternTable table;
+  const int num_threads = 8;
+  const int num_strings = 500;
+  std::vector<std::vector<InternedString>> handles(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&table, &handles, t]() {
+      for (int i = 0; i < num_strings; ++i)
+      {
+        handles[t].push_back(table.Intern("name" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  // All threads agree on a single entry per string.
+  EXPECT_EQ(table.size(), num_strings);
+  std::set<uint32_t> ids;
+  for (int i = 0; i < num_strings; ++i)
+  {
+    ASSERT_TRUE(handles[0][i].IsValid());
+    EXPECT_EQ(handles[0][i].GetValue(), "name" + std::to_string(i));
+    ids.insert(handles[0][i].GetId());
+    for (int t = 1; t < num_threads; ++t)
+    {
+      EXPECT_TRUE(handles[t][i] == handles[0][i]);
+    }
+  }
+  EXPECT_EQ(ids.size(), num_strings);
+}
+
+TEST(StringInternTable, GetInstance)
+{
+  auto handle = StringInternTable::GetInstance().Intern("global");
+  EXPECT_TRUE(handle == StringInternTable::GetInstance().Find("global"));
+}
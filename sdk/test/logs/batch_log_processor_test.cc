@@ -53,6 +53,8 @@ class MockLogExporter final : public LogExporter
   {
     *is_export_completed_ = false;  // Meant exclusively to test scheduled_delay_millis
 
+    std::this_thread::sleep_for(export_delay_);
+
     for (auto &record : records)
     {
       auto log = std::unique_ptr<LogRecord>(static_cast<LogRecord *>(record.release()));
@@ -142,6 +144,32 @@ TEST_F(BatchLogProcessorTest, TestShutdown)
   EXPECT_TRUE(is_shutdown->load());
 }
 
+TEST_F(BatchLogProcessorTest, TestShutdownTimeout)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<LogRecord>>> logs_received(
+      new std::vector<std::unique_ptr<LogRecord>>);
+  const std::chrono::milliseconds export_delay(200);
+
+  auto batch_processor = GetMockProcessor(
+      logs_received, is_shutdown, std::shared_ptr<std::atomic<bool>>(new std::atomic<bool>(false)),
+      export_delay);
+
+  auto log = batch_processor->MakeRecordable();
+  batch_processor->OnReceive(std::move(log));
+
+  // The export in progress at the deadline is abandoned.
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(batch_processor->Shutdown(std::chrono::milliseconds(50)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, export_delay);
+  EXPECT_FALSE(is_shutdown->load());
+
+  // The destructor waits for the abandoned export, and shuts the exporter down.
+  batch_processor.reset();
+  EXPECT_EQ(1, logs_received->size());
+  EXPECT_TRUE(is_shutdown->load());
+}
+
 TEST_F(BatchLogProcessorTest, TestForceFlush)
 {
   std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
@@ -183,6 +211,28 @@ TEST_F(BatchLogProcessorTest, TestForceFlush)
   }
 }
 
+TEST_F(BatchLogProcessorTest, TestForceFlushTimeout)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<LogRecord>>> logs_received(
+      new std::vector<std::unique_ptr<LogRecord>>);
+
+  auto batch_processor = GetMockProcessor(logs_received, is_shutdown, is_export_completed,
+                                          std::chrono::milliseconds(200));
+
+  auto log = batch_processor->MakeRecordable();
+  log->SetName("Log");
+  batch_processor->OnReceive(std::move(log));
+
+  // The export takes longer than the timeout
+  EXPECT_FALSE(batch_processor->ForceFlush(std::chrono::milliseconds(10)));
+
+  // A later flush waits for the export in progress
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(1, logs_received->size());
+}
+
 TEST_F(BatchLogProcessorTest, TestManyLogsLoss)
 {
   /* Test that when exporting more than max_queue_size logs, some are most likely lost*/
@@ -275,3 +325,98 @@ TEST_F(BatchLogProcessorTest, TestScheduledDelayMillis)
     EXPECT_EQ("Log" + std::to_string(i), logs_received->at(i)->GetName());
   }
 }
+
+TEST_F(BatchLogProcessorTest, TestDropLowestPriority)
+{
+  /* Test that the log records with the highest severity are kept when the queue is full */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<LogRecord>>> logs_received(
+      new std::vector<std::unique_ptr<LogRecord>>);
+  BatchLogProcessorOptions options;
+  options.max_queue_size  = 16;
+  options.overflow_policy = OverflowPolicy::kDropLowestPriority;
+  BatchLogProcessor batch_processor(
+      std::unique_ptr<LogExporter>(
+          new MockLogExporter(logs_received, is_shutdown, is_export_completed)),
+      options);
+
+  const int num_logs = 256;
+  for (int i = 0; i < num_logs; ++i)
+  {
+    auto log = batch_processor.MakeRecordable();
+    log->SetName("Log" + std::to_string(i));
+    log->SetSeverity(i % 16 == 0 ? opentelemetry::logs::Severity::kError
+                                 : opentelemetry::logs::Severity::kInfo);
+    batch_processor.OnReceive(std::move(log));
+  }
+
+  EXPECT_TRUE(batch_processor.ForceFlush());
+
+  // No error is dropped, as there are fewer than max_queue_size of them.
+  size_t num_errors = 0;
+  for (auto &log : *logs_received)
+  {
+    if (log->GetSeverity() == opentelemetry::logs::Severity::kError)
+    {
+      ++num_errors;
+    }
+  }
+  EXPECT_EQ(num_logs / 16, num_errors);
+  EXPECT_EQ(num_logs, batch_processor.GetAcceptedCount() + batch_processor.GetDroppedCount());
+  EXPECT_EQ(batch_processor.GetAcceptedCount(), logs_received->size());
+}
+
+/**
+ * A log exporter which fails with a retryable error the first exports, and
+ * counts the log records exported afterwards.
+ */
+class FlakyLogExporter final : public LogExporter
+{
+public:
+  FlakyLogExporter(std::shared_ptr<std::atomic<size_t>> num_logs_received, size_t num_failures)
+      : num_logs_received_(num_logs_received), num_failures_(num_failures)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new LogRecord());
+  }
+
+  ExportResult Export(
+      const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &records) noexcept override
+  {
+    if (num_failures_ > 0)
+    {
+      --num_failures_;
+      return ExportResult::kFailureRetryable;
+    }
+    *num_logs_received_ += records.size();
+    return ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<std::atomic<size_t>> num_logs_received_;
+  size_t num_failures_;
+};
+
+TEST_F(BatchLogProcessorTest, TestForceFlushWithRetryableFailure)
+{
+  std::shared_ptr<std::atomic<size_t>> num_logs_received(new std::atomic<size_t>(0));
+  BatchLogProcessorOptions options;
+  options.retry_options.initial_backoff = std::chrono::milliseconds(10);
+  BatchLogProcessor batch_processor(
+      std::unique_ptr<LogExporter>(new FlakyLogExporter(num_logs_received, 1)), options);
+
+  batch_processor.OnReceive(batch_processor.MakeRecordable());
+
+  // The flush fails while the log record waits for a retry, which the next
+  // flush exports.
+  EXPECT_FALSE(batch_processor.ForceFlush());
+  EXPECT_EQ(0, num_logs_received->load());
+  EXPECT_TRUE(batch_processor.ForceFlush());
+  EXPECT_EQ(1, num_logs_received->load());
+}
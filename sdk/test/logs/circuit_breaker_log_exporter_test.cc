@@ -0,0 +1,139 @@
+/*
+ * Copyright The OpenTelemetry Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "opentelemetry/sdk/logs/circuit_breaker_log_exporter.h"
+#include "opentelemetry/sdk/logs/log_record.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace opentelemetry::sdk::logs;
+using opentelemetry::sdk::common::CircuitBreakerOptions;
+using opentelemetry::sdk::common::CircuitState;
+using opentelemetry::sdk::common::ExportResult;
+
+namespace
+{
+/**
+ * A log exporter which returns a given result, and counts its exports.
+ */
+class ResultLogExporter final : public LogExporter
+{
+public:
+  ResultLogExporter(std::shared_ptr<ExportResult> result,
+                    std::shared_ptr<std::atomic<size_t>> num_exports) noexcept
+      : result_(result), num_exports_(num_exports)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new LogRecord);
+  }
+
+  ExportResult Export(const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &) noexcept
+      override
+  {
+    ++*num_exports_;
+    return *result_;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<ExportResult> result_;
+  std::shared_ptr<std::atomic<size_t>> num_exports_;
+};
+
+ExportResult ExportOneLog(LogExporter &exporter, bool *is_taken = nullptr)
+{
+  std::unique_ptr<Recordable> records[] = {exporter.MakeRecordable()};
+  auto result = exporter.Export(opentelemetry::nostd::span<std::unique_ptr<Recordable>>(records));
+  if (is_taken != nullptr)
+  {
+    *is_taken = records[0] == nullptr;
+  }
+  return result;
+}
+}  // namespace
+
+TEST(CircuitBreakerLogExporter, OpensAfterConsecutiveFailures)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailureRetryable));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 2;
+  options.open_duration     = std::chrono::milliseconds(20);
+  CircuitBreakerLogExporter exporter(
+      std::unique_ptr<LogExporter>(new ResultLogExporter(result, num_exports)), options);
+
+  ExportOneLog(exporter);
+  EXPECT_EQ(CircuitState::kClosed, exporter.GetState());
+  ExportOneLog(exporter);
+  EXPECT_EQ(CircuitState::kOpen, exporter.GetState());
+
+  // Rejected batches are left to the retry buffer of the processor.
+  bool is_taken = true;
+  EXPECT_EQ(ExportResult::kFailureRetryable, ExportOneLog(exporter, &is_taken));
+  EXPECT_FALSE(is_taken);
+  EXPECT_EQ(2, num_exports->load());
+  EXPECT_EQ(1, exporter.GetRejectedCount());
+
+  // A successful probe closes the circuit.
+  *result = ExportResult::kSuccess;
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(ExportResult::kSuccess, ExportOneLog(exporter));
+  EXPECT_EQ(CircuitState::kClosed, exporter.GetState());
+  EXPECT_EQ(3, num_exports->load());
+}
+
+TEST(CircuitBreakerLogExporter, IgnoresPermanentFailures)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailure));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 1;
+  CircuitBreakerLogExporter exporter(
+      std::unique_ptr<LogExporter>(new ResultLogExporter(result, num_exports)), options);
+
+  // A batch rejected by the backend shows that the backend is reachable.
+  ExportOneLog(exporter);
+  ExportOneLog(exporter);
+  EXPECT_EQ(CircuitState::kClosed, exporter.GetState());
+  EXPECT_EQ(2, num_exports->load());
+
+  // A retryable failure after a permanent one opens the circuit.
+  *result = ExportResult::kFailureRetryable;
+  ExportOneLog(exporter);
+  EXPECT_EQ(CircuitState::kOpen, exporter.GetState());
+}
+
+TEST(CircuitBreakerLogExporter, DropsRejectedBatches)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailureRetryable));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 1;
+  options.retry_rejected    = false;
+  CircuitBreakerLogExporter exporter(
+      std::unique_ptr<LogExporter>(new ResultLogExporter(result, num_exports)), options);
+
+  ExportOneLog(exporter);
+  bool is_taken = false;
+  EXPECT_EQ(ExportResult::kFailure, ExportOneLog(exporter, &is_taken));
+  EXPECT_TRUE(is_taken);
+  EXPECT_EQ(1, num_exports->load());
+}
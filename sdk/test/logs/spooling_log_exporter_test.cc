@@ -0,0 +1,149 @@
+/*
+ * Copyright The OpenTelemetry Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "opentelemetry/sdk/logs/spooling_log_exporter.h"
+#include "opentelemetry/sdk/logs/log_record.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace opentelemetry::sdk::logs;
+using opentelemetry::nostd::string_view;
+using opentelemetry::sdk::common::DiskSpool;
+using opentelemetry::sdk::common::DiskSpoolOptions;
+using opentelemetry::sdk::common::ExportResult;
+
+namespace
+{
+/**
+ * The backend of an EncodingTestExporter.
+ */
+struct TestBackend
+{
+  ExportResult result = ExportResult::kSuccess;
+  std::vector<std::string> exported;
+};
+
+/**
+ * A log exporter which encodes a batch as the names of its log records, and sends
+ * it to a test backend.
+ */
+class EncodingTestExporter final : public EncodingLogExporter
+{
+public:
+  explicit EncodingTestExporter(std::shared_ptr<TestBackend> backend) noexcept
+      : backend_(backend)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new LogRecord);
+  }
+
+  ExportResult Export(
+      const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &records) noexcept override
+  {
+    std::string data;
+    Encode(records, &data);
+    return ExportEncoded(data);
+  }
+
+  bool Encode(const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &records,
+              std::string *data) noexcept override
+  {
+    for (auto &recordable : records)
+    {
+      std::unique_ptr<LogRecord> record(static_cast<LogRecord *>(recordable.release()));
+      data->append(record->GetName());
+    }
+    return true;
+  }
+
+  ExportResult ExportEncoded(string_view data) noexcept override
+  {
+    if (backend_->result == ExportResult::kSuccess)
+    {
+      backend_->exported.push_back(std::string(data.data(), data.size()));
+    }
+    return backend_->result;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<TestBackend> backend_;
+};
+
+/**
+ * Keeps the spool of every test in the temporary directory, under the name of
+ * the test, and deletes its files before and after the test.
+ */
+class SpoolingLogExporterTest : public ::testing::Test
+{
+protected:
+  void SetUp() override { RemoveSpool(); }
+
+  void TearDown() override { RemoveSpool(); }
+
+  DiskSpoolOptions MakeOptions() const
+  {
+    const auto *test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    DiskSpoolOptions options;
+    options.directory       = ::testing::TempDir();
+    options.name            = std::string("spooling_log_exporter_test_") + test_info->name();
+    options.replay_interval = std::chrono::hours(1);
+    return options;
+  }
+
+  /**
+   * Deletes the files of the spool by reading it entirely.
+   */
+  void RemoveSpool() const
+  {
+    DiskSpool spool{MakeOptions()};
+    std::string record;
+    while (spool.Peek(&record))
+    {
+      spool.Pop();
+    }
+  }
+};
+
+ExportResult ExportOneLog(LogExporter &exporter, string_view name)
+{
+  std::unique_ptr<Recordable> records[] = {exporter.MakeRecordable()};
+  records[0]->SetName(name);
+  return exporter.Export(opentelemetry::nostd::span<std::unique_ptr<Recordable>>(records));
+}
+}  // namespace
+
+TEST_F(SpoolingLogExporterTest, SpoolsEncodedBatches)
+{
+  std::shared_ptr<TestBackend> backend(new TestBackend);
+  SpoolingLogExporter exporter(
+      std::unique_ptr<EncodingLogExporter>(new EncodingTestExporter(backend)), MakeOptions());
+
+  // Batches are spooled while the backend is down, and replayed on shutdown.
+  backend->result = ExportResult::kFailureRetryable;
+  EXPECT_EQ(ExportResult::kSuccess, ExportOneLog(exporter, "a"));
+  EXPECT_EQ(ExportResult::kSuccess, ExportOneLog(exporter, "b"));
+  EXPECT_TRUE(backend->exported.empty());
+
+  backend->result = ExportResult::kSuccess;
+  EXPECT_TRUE(exporter.Shutdown());
+  EXPECT_EQ(backend->exported, (std::vector<std::string>{"a", "b"}));
+}
@@ -0,0 +1,153 @@
+#include "opentelemetry/sdk/trace/samplers/adaptive.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+using opentelemetry::sdk::trace::AdaptiveSampler;
+using opentelemetry::sdk::trace::AdaptiveSamplerFeedback;
+using opentelemetry::sdk::trace::AdaptiveSamplerOptions;
+using opentelemetry::sdk::trace::Decision;
+using opentelemetry::sdk::trace::SamplingResult;
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+/*
+ * Calls ShouldSample for a root span of a trace whose randomness is the given
+ * value repeated in its last 7 bytes.
+ */
+SamplingResult SampleTrace(AdaptiveSampler &sampler, uint8_t randomness)
+{
+  uint8_t trace_id_buffer[trace_api::TraceId::kSize] = {0};
+  std::fill(trace_id_buffer + 9, trace_id_buffer + trace_api::TraceId::kSize, randomness);
+  trace_api::TraceId trace_id{trace_id_buffer};
+
+  using M = std::map<std::string, int>;
+  M m1    = {{}};
+  using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+  L l1    = {};
+  opentelemetry::common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  return sampler.ShouldSample(trace_api::SpanContext::GetInvalid(), trace_id, "",
+                              trace_api::SpanKind::kInternal, view, links);
+}
+
+AdaptiveSamplerOptions MakeOptions()
+{
+  AdaptiveSamplerOptions options;
+  // Adjustments are made by the tests.
+  options.adjustment_interval = std::chrono::milliseconds(3600 * 1000);
+  return options;
+}
+}  // namespace
+
+TEST(AdaptiveSampler, RecordsThresholdInTraceState)
+{
+  AdaptiveSamplerFeedback feedback;
+  auto options          = MakeOptions();
+  options.initial_ratio = 0.5;
+  AdaptiveSampler sampler([&] { return feedback; }, options);
+  EXPECT_DOUBLE_EQ(sampler.GetRatio(), 0.5);
+
+  auto sampled = SampleTrace(sampler, 0xff);
+  ASSERT_EQ(sampled.decision, Decision::RECORD_AND_SAMPLE);
+  std::string value;
+  EXPECT_TRUE(sampled.trace_state->Get("ot", value));
+  EXPECT_EQ(value, "th:8");
+
+  EXPECT_EQ(SampleTrace(sampler, 0x7f).decision, Decision::DROP);
+}
+
+TEST(AdaptiveSampler, MovesTowardsTarget)
+{
+  AdaptiveSamplerFeedback feedback;
+  auto options                    = MakeOptions();
+  options.target_spans_per_second = 1;
+  options.min_ratio               = 0.01;
+  AdaptiveSampler sampler([&] { return feedback; }, options);
+
+  // Far more spans than the target cut the ratio down to its minimum.
+  feedback.accepted_count = 1000000000;
+  sampler.Adjust();
+  EXPECT_NEAR(sampler.GetRatio(), 0.01, 1e-9);
+
+  // Without spans, the ratio grows twofold per adjustment.
+  sampler.Adjust();
+  EXPECT_NEAR(sampler.GetRatio(), 0.02, 1e-9);
+  sampler.Adjust();
+  EXPECT_NEAR(sampler.GetRatio(), 0.04, 1e-9);
+}
+
+TEST(AdaptiveSampler, RecoversFromZeroRatio)
+{
+  AdaptiveSamplerFeedback feedback;
+  auto options          = MakeOptions();
+  options.initial_ratio = 0;
+  options.min_ratio     = 0;
+  AdaptiveSampler sampler([&] { return feedback; }, options);
+  EXPECT_EQ(SampleTrace(sampler, 0xff).decision, Decision::DROP);
+
+  // The ratio is kept above 0, so that it can grow back.
+  sampler.Adjust();
+  EXPECT_GT(sampler.GetRatio(), 0);
+  for (int i = 0; i < 64; ++i)
+  {
+    sampler.Adjust();
+  }
+  EXPECT_DOUBLE_EQ(sampler.GetRatio(), 1);
+
+  auto sampled = SampleTrace(sampler, 0);
+  ASSERT_EQ(sampled.decision, Decision::RECORD_AND_SAMPLE);
+  std::string value;
+  EXPECT_TRUE(sampled.trace_state->Get("ot", value));
+  EXPECT_EQ(value, "th:0");
+}
+
+TEST(AdaptiveSampler, ShedsLoadBeforeQueueOverflows)
+{
+  AdaptiveSamplerFeedback feedback;
+  feedback.max_queue_size         = 100;
+  auto options                    = MakeOptions();
+  options.target_spans_per_second = 1e12;
+  options.initial_ratio           = 0.5;
+  AdaptiveSampler sampler([&] { return feedback; }, options);
+
+  // Above the high watermark, the ratio is cut in proportion to the room left.
+  feedback.queue_size = 75;
+  sampler.Adjust();
+  EXPECT_NEAR(sampler.GetRatio(), 0.25, 1e-9);
+
+  // Dropped spans cut the ratio to the share accepted.
+  feedback.queue_size = 0;
+  feedback.accepted_count += 30;
+  feedback.dropped_count += 10;
+  sampler.Adjust();
+  EXPECT_NEAR(sampler.GetRatio(), 0.1875, 1e-9);
+}
+
+TEST(AdaptiveSampler, ShedsLoadOnSlowExports)
+{
+  AdaptiveSamplerFeedback feedback;
+  auto options                    = MakeOptions();
+  options.target_spans_per_second = 1e12;
+  options.initial_ratio           = 0.5;
+  options.max_export_latency      = std::chrono::milliseconds(100);
+  AdaptiveSampler sampler([&] { return feedback; }, options);
+
+  feedback.export_latency = std::chrono::milliseconds(400);
+  sampler.Adjust();
+  EXPECT_NEAR(sampler.GetRatio(), 0.125, 1e-9);
+}
+
+TEST(AdaptiveSampler, GetDescription)
+{
+  AdaptiveSamplerFeedback feedback;
+  AdaptiveSampler sampler([&] { return feedback; }, MakeOptions());
+  ASSERT_EQ("AdaptiveSampler{1000.000000}", sampler.GetDescription());
+}
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 #include <chrono>
+#include <map>
+#include <string>
 #include <thread>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -176,6 +178,138 @@ TEST_F(BatchSpanProcessorTestPeer, TestForceFlush)
   }
 }
 
+TEST_F(BatchSpanProcessorTestPeer, TestForceFlushTimeout)
+{
+  /* Test that force flush returns false when the exporter is slower than the timeout */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const std::chrono::milliseconds export_delay(200);
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(
+              spans_received, is_shutdown, is_export_completed, export_delay)),
+          sdk::trace::BatchSpanProcessorOptions()));
+
+  auto test_spans = GetTestSpans(batch_processor, 1);
+  batch_processor->OnEnd(std::move(test_spans->at(0)));
+
+  EXPECT_FALSE(batch_processor->ForceFlush(std::chrono::milliseconds(10)));
+
+  // A later flush waits for the export in progress.
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(1, spans_received->size());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestShutdownTimeout)
+{
+  /* Test that shutdown stops draining the queue when the timeout expires */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const std::chrono::milliseconds export_delay(100);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_export_batch_size = 1;
+  const int num_spans           = 4;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(
+              spans_received, is_shutdown, is_export_completed, export_delay)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  // The export in progress at the deadline is abandoned.
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(batch_processor->Shutdown(std::chrono::milliseconds(50)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, export_delay);
+
+  // The destructor waits for the abandoned export, and shuts the exporter down.
+  batch_processor.reset();
+  EXPECT_LT(spans_received->size(), num_spans);
+  EXPECT_TRUE(is_shutdown->load());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestShutdownTimeoutWithConcurrentExports)
+{
+  /* Test that shutdown does not wait for the exports in flight after the timeout */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const std::chrono::milliseconds export_delay(200);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_export_batch_size  = 1;
+  options.max_concurrent_exports = 2;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(
+              spans_received, is_shutdown,
+              std::shared_ptr<std::atomic<bool>>(new std::atomic<bool>(false)), export_delay)),
+          options));
+
+  // A single span, as the mock exporter must not be called concurrently.
+  auto test_spans = GetTestSpans(batch_processor, 1);
+  batch_processor->OnEnd(std::move(test_spans->at(0)));
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(batch_processor->Shutdown(std::chrono::milliseconds(50)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, export_delay);
+  EXPECT_FALSE(is_shutdown->load());
+
+  batch_processor.reset();
+  EXPECT_LE(spans_received->size(), 1);
+  EXPECT_TRUE(is_shutdown->load());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestSharedExecutor)
+{
+  /* Test that processors sharing an executor keep their own flush semantics */
+
+  auto executor = std::make_shared<sdk::common::Executor>(1);
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::vector<std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>>> spans_received;
+  std::vector<std::shared_ptr<sdk::trace::BatchSpanProcessor>> batch_processors;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.executor    = executor;
+  const int num_spans = 16;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    spans_received.emplace_back(new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+    batch_processors.emplace_back(new sdk::trace::BatchSpanProcessor(
+        std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received[i], is_shutdown)),
+        options));
+  }
+
+  for (auto &batch_processor : batch_processors)
+  {
+    auto test_spans = GetTestSpans(batch_processor, num_spans);
+    for (int i = 0; i < num_spans; ++i)
+    {
+      batch_processor->OnEnd(std::move(test_spans->at(i)));
+    }
+  }
+
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(batch_processors[i]->ForceFlush());
+    EXPECT_EQ(num_spans, spans_received[i]->size());
+    EXPECT_TRUE(batch_processors[i]->Shutdown());
+  }
+}
+
 TEST_F(BatchSpanProcessorTestPeer, TestManySpansLoss)
 {
   /* Test that when exporting more than max_queue_size spans, some are most likely lost*/
@@ -283,4 +417,487 @@ TEST_F(BatchSpanProcessorTestPeer, TestScheduleDelayMillis)
   }
 }
 
+TEST_F(BatchSpanProcessorTestPeer, TestShardedQueue)
+{
+  /* Test that no spans are lost when ending max_queue_size spans from several threads */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.num_queue_shards = 4;
+  const int num_threads    = 8;
+  const int num_spans      = static_cast<int>(options.max_queue_size) / num_threads;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    threads.emplace_back([&] {
+      auto test_spans = GetTestSpans(batch_processor, num_spans);
+      for (int i = 0; i < num_spans; ++i)
+      {
+        batch_processor->OnEnd(std::move(test_spans->at(i)));
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  ASSERT_EQ(num_spans * num_threads, spans_received->size());
+  std::map<std::string, int> span_counts;
+  for (auto &span : *spans_received)
+  {
+    ++span_counts[std::string(span->GetName())];
+  }
+  EXPECT_EQ(num_spans, span_counts.size());
+  for (auto &span_count : span_counts)
+  {
+    EXPECT_EQ(num_threads, span_count.second);
+  }
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestOverflowCounters)
+{
+  /* Test that every span ended while the queue is full is counted */
+
+  for (auto policy : {sdk::common::OverflowPolicy::kDropNewest,
+                      sdk::common::OverflowPolicy::kDropOldest})
+  {
+    std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+    std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+        new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+    sdk::trace::BatchSpanProcessorOptions options{};
+    options.max_queue_size  = 16;
+    options.overflow_policy = policy;
+    const int num_spans     = 1024;
+
+    auto batch_processor =
+        std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+            std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+            options));
+
+    auto test_spans = GetTestSpans(batch_processor, num_spans);
+    for (int i = 0; i < num_spans; ++i)
+    {
+      batch_processor->OnEnd(std::move(test_spans->at(i)));
+    }
+
+    EXPECT_TRUE(batch_processor->ForceFlush());
+
+    EXPECT_EQ(num_spans,
+              batch_processor->GetAcceptedCount() + batch_processor->GetDroppedCount());
+    EXPECT_EQ(batch_processor->GetAcceptedCount(), spans_received->size());
+    if (policy == sdk::common::OverflowPolicy::kDropOldest)
+    {
+      EXPECT_EQ("Span " + std::to_string(num_spans - 1), spans_received->back()->GetName());
+    }
+  }
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestDropLowestPriority)
+{
+  /* Test that error spans are kept over other spans when the queue is full */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size  = 16;
+  options.overflow_policy = sdk::common::OverflowPolicy::kDropLowestPriority;
+  const int num_spans     = 256;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    if (i % 16 == 0)
+    {
+      test_spans->at(i)->SetStatus(trace::StatusCode::kError, "");
+    }
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  // No error span is dropped, as there are fewer than max_queue_size of them.
+  size_t num_errors = 0;
+  for (auto &span : *spans_received)
+  {
+    if (span->GetStatus() == trace::StatusCode::kError)
+    {
+      ++num_errors;
+    }
+  }
+  EXPECT_EQ(num_spans / 16, num_errors);
+  EXPECT_EQ(num_spans, batch_processor->GetAcceptedCount() + batch_processor->GetDroppedCount());
+  EXPECT_EQ(batch_processor->GetAcceptedCount(), spans_received->size());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestMemoryBudget)
+{
+  /* Test that spans which do not fit into the memory budget are dropped */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const int num_spans = 64;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size = num_spans;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+
+  // Every span has a name of at least 6 characters.
+  auto span_size = test_spans->front()->GetEstimatedSize();
+  EXPECT_GT(span_size, 6);
+  options.max_queue_size_bytes = 16 * span_size;
+  batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  EXPECT_LE(batch_processor->GetAcceptedCount(), 16);
+  EXPECT_EQ(num_spans, batch_processor->GetAcceptedCount() + batch_processor->GetDroppedCount());
+  EXPECT_EQ(batch_processor->GetAcceptedCount(), spans_received->size());
+}
+
+/**
+ * A span exporter which records the number of spans of every export.
+ */
+class BatchSizeSpanExporter final : public sdk::trace::SpanExporter
+{
+public:
+  explicit BatchSizeSpanExporter(std::shared_ptr<std::vector<size_t>> batch_sizes) noexcept
+      : batch_sizes_(batch_sizes)
+  {}
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData);
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    if (!recordables.empty())
+    {
+      batch_sizes_->push_back(recordables.size());
+    }
+    return sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<std::vector<size_t>> batch_sizes_;
+};
+
+TEST_F(BatchSpanProcessorTestPeer, TestExportBatchSizeBytes)
+{
+  /* Test that export batches are cut by their estimated size */
+
+  std::shared_ptr<std::vector<size_t>> batch_sizes(new std::vector<size_t>);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  const int num_spans = 10;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<BatchSizeSpanExporter>(new BatchSizeSpanExporter(batch_sizes)),
+          options));
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+
+  // All the spans have names of the same length.
+  options.max_export_batch_size_bytes = 3 * test_spans->front()->GetEstimatedSize();
+  batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<BatchSizeSpanExporter>(new BatchSizeSpanExporter(batch_sizes)),
+          options));
+
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  EXPECT_EQ(*batch_sizes, (std::vector<size_t>{3, 3, 3, 1}));
+}
+
+/**
+ * A span exporter which counts the exported spans and the exports running
+ * concurrently.
+ */
+class ConcurrentSpanExporter final : public sdk::trace::SpanExporter
+{
+public:
+  ConcurrentSpanExporter(std::shared_ptr<std::atomic<size_t>> num_spans_received,
+                         std::shared_ptr<std::atomic<size_t>> max_in_flight) noexcept
+      : num_spans_received_(num_spans_received), max_in_flight_(max_in_flight)
+  {}
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData);
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    size_t in_flight = ++in_flight_;
+    size_t max       = max_in_flight_->load();
+    while (in_flight > max && !max_in_flight_->compare_exchange_weak(max, in_flight))
+    {
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    *num_spans_received_ += recordables.size();
+
+    --in_flight_;
+    return sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<std::atomic<size_t>> num_spans_received_;
+  std::shared_ptr<std::atomic<size_t>> max_in_flight_;
+  std::atomic<size_t> in_flight_{0};
+};
+
+TEST_F(BatchSpanProcessorTestPeer, TestConcurrentExports)
+{
+  /* Test that batches are exported concurrently, and that force flush waits for all of them */
+
+  std::shared_ptr<std::atomic<size_t>> num_spans_received(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> max_in_flight(new std::atomic<size_t>(0));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_export_batch_size  = 4;
+  options.max_concurrent_exports = 4;
+  const int num_spans            = 64;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<ConcurrentSpanExporter>(
+              new ConcurrentSpanExporter(num_spans_received, max_in_flight)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  EXPECT_EQ(num_spans, num_spans_received->load());
+  EXPECT_GT(max_in_flight->load(), 1);
+  EXPECT_LE(max_in_flight->load(), 4);
+}
+
+/**
+ * A span exporter which fails with a retryable error the first exports, leaving
+ * the recordables in the batch, and counts the spans exported afterwards.
+ */
+class FlakySpanExporter final : public sdk::trace::SpanExporter
+{
+public:
+  FlakySpanExporter(std::shared_ptr<std::atomic<size_t>> num_spans_received,
+                    size_t num_failures) noexcept
+      : num_spans_received_(num_spans_received), num_failures_(num_failures)
+  {}
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData);
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    if (num_failures_ > 0)
+    {
+      --num_failures_;
+      return sdk::common::ExportResult::kFailureRetryable;
+    }
+    for (auto &recordable : recordables)
+    {
+      recordable.reset();
+    }
+    *num_spans_received_ += recordables.size();
+    return sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<std::atomic<size_t>> num_spans_received_;
+  size_t num_failures_;
+};
+
+TEST_F(BatchSpanProcessorTestPeer, TestRetryableExportFailure)
+{
+  /* Test that a force flush retries the failed batches, and that shutdown retries them after
+   * their backoff */
+
+  std::shared_ptr<std::atomic<size_t>> num_spans_received(new std::atomic<size_t>(0));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.retry_options.initial_backoff = std::chrono::milliseconds(10);
+  const int num_spans                   = 4;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<FlakySpanExporter>(new FlakySpanExporter(num_spans_received, 1)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  batch_processor->OnEnd(std::move(test_spans->at(0)));
+  batch_processor->OnEnd(std::move(test_spans->at(1)));
+
+  // The first export fails, so the flush fails, and the next force flush retries it.
+  EXPECT_FALSE(batch_processor->ForceFlush());
+  EXPECT_EQ(0, num_spans_received->load());
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(2, num_spans_received->load());
+
+  batch_processor->OnEnd(std::move(test_spans->at(2)));
+  batch_processor->OnEnd(std::move(test_spans->at(3)));
+  EXPECT_TRUE(batch_processor->Shutdown());
+  EXPECT_EQ(num_spans, num_spans_received->load());
+  EXPECT_EQ(0, batch_processor->GetRetryDroppedCount());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestRetryMaxAttempts)
+{
+  /* Test that spans are dropped when they fail more often than the maximum attempts */
+
+  std::shared_ptr<std::atomic<size_t>> num_spans_received(new std::atomic<size_t>(0));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.retry_options.max_attempts    = 3;
+  options.retry_options.initial_backoff = std::chrono::milliseconds(10);
+  const int num_spans                   = 4;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<FlakySpanExporter>(new FlakySpanExporter(num_spans_received, 3)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  EXPECT_TRUE(batch_processor->Shutdown());
+  EXPECT_EQ(0, num_spans_received->load());
+  EXPECT_EQ(num_spans, batch_processor->GetRetryDroppedCount());
+}
+
+/**
+ * A span exporter which fails with a retryable error the first exports, and
+ * records the maximum number of concurrent calls to Export.
+ */
+class ConcurrentFlakySpanExporter final : public sdk::trace::SpanExporter
+{
+public:
+  ConcurrentFlakySpanExporter(std::shared_ptr<std::atomic<size_t>> num_spans_received,
+                              std::shared_ptr<std::atomic<size_t>> max_concurrent_calls,
+                              int num_failures) noexcept
+      : num_spans_received_(num_spans_received),
+        max_concurrent_calls_(max_concurrent_calls),
+        num_failures_(num_failures)
+  {}
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData);
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    size_t concurrent_calls = ++concurrent_calls_;
+    size_t max_calls        = max_concurrent_calls_->load();
+    while (concurrent_calls > max_calls &&
+           !max_concurrent_calls_->compare_exchange_weak(max_calls, concurrent_calls))
+    {
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    --concurrent_calls_;
+    if (num_failures_.fetch_sub(1) > 0)
+    {
+      return sdk::common::ExportResult::kFailureRetryable;
+    }
+    for (auto &recordable : recordables)
+    {
+      recordable.reset();
+    }
+    *num_spans_received_ += recordables.size();
+    return sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<std::atomic<size_t>> num_spans_received_;
+  std::shared_ptr<std::atomic<size_t>> max_concurrent_calls_;
+  std::atomic<int> num_failures_;
+  std::atomic<size_t> concurrent_calls_{0};
+};
+
+TEST_F(BatchSpanProcessorTestPeer, TestRetryWithConcurrentExports)
+{
+  /* Test that retried batches count against the maximum of concurrent exports */
+
+  std::shared_ptr<std::atomic<size_t>> num_spans_received(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> max_concurrent_calls(new std::atomic<size_t>(0));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.schedule_delay_millis         = std::chrono::milliseconds(1);
+  options.max_export_batch_size         = 1;
+  options.max_concurrent_exports        = 2;
+  options.retry_options.initial_backoff = std::chrono::milliseconds(1);
+  const int num_spans                   = 6;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<ConcurrentFlakySpanExporter>(
+              new ConcurrentFlakySpanExporter(num_spans_received, max_concurrent_calls, 2)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  // Let the worker task export and retry the spans before shutting down.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_TRUE(batch_processor->Shutdown());
+  EXPECT_EQ(num_spans, num_spans_received->load());
+  EXPECT_LE(max_concurrent_calls->load(), options.max_concurrent_exports);
+}
+
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,150 @@
+#include "opentelemetry/sdk/trace/circuit_breaker_exporter.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::sdk::common::CircuitBreakerOptions;
+using opentelemetry::sdk::common::CircuitState;
+using opentelemetry::sdk::common::ExportResult;
+
+namespace
+{
+/**
+ * A span exporter which returns a given result, and counts its exports.
+ */
+class ResultSpanExporter final : public SpanExporter
+{
+public:
+  ResultSpanExporter(std::shared_ptr<ExportResult> result,
+                     std::shared_ptr<std::atomic<size_t>> num_exports) noexcept
+      : result_(result), num_exports_(num_exports)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  ExportResult Export(const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &) noexcept
+      override
+  {
+    ++*num_exports_;
+    return *result_;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<ExportResult> result_;
+  std::shared_ptr<std::atomic<size_t>> num_exports_;
+};
+
+ExportResult ExportOneSpan(SpanExporter &exporter, bool *is_taken = nullptr)
+{
+  std::unique_ptr<Recordable> spans[] = {exporter.MakeRecordable()};
+  auto result = exporter.Export(opentelemetry::nostd::span<std::unique_ptr<Recordable>>(spans));
+  if (is_taken != nullptr)
+  {
+    *is_taken = spans[0] == nullptr;
+  }
+  return result;
+}
+}  // namespace
+
+TEST(CircuitBreakerSpanExporter, OpensAfterConsecutiveFailures)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailureRetryable));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 3;
+  options.open_duration     = std::chrono::milliseconds(50);
+  CircuitBreakerSpanExporter exporter(
+      std::unique_ptr<SpanExporter>(new ResultSpanExporter(result, num_exports)), options);
+
+  // A success resets the count of consecutive failures.
+  ExportOneSpan(exporter);
+  ExportOneSpan(exporter);
+  *result = ExportResult::kSuccess;
+  ExportOneSpan(exporter);
+  *result = ExportResult::kFailureRetryable;
+  ExportOneSpan(exporter);
+  ExportOneSpan(exporter);
+  EXPECT_EQ(CircuitState::kClosed, exporter.GetState());
+  ExportOneSpan(exporter);
+  EXPECT_EQ(CircuitState::kOpen, exporter.GetState());
+  EXPECT_EQ(6, num_exports->load());
+
+  // Rejected batches are left to the retry buffer of the processor.
+  bool is_taken = true;
+  EXPECT_EQ(ExportResult::kFailureRetryable, ExportOneSpan(exporter, &is_taken));
+  EXPECT_FALSE(is_taken);
+  EXPECT_EQ(6, num_exports->load());
+  EXPECT_EQ(1, exporter.GetRejectedCount());
+}
+
+TEST(CircuitBreakerSpanExporter, ProbesAfterOpenDuration)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailureRetryable));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 1;
+  options.open_duration     = std::chrono::milliseconds(20);
+  CircuitBreakerSpanExporter exporter(
+      std::unique_ptr<SpanExporter>(new ResultSpanExporter(result, num_exports)), options);
+
+  ExportOneSpan(exporter);
+  EXPECT_EQ(CircuitState::kOpen, exporter.GetState());
+
+  // A failed probe opens the circuit again.
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  ExportOneSpan(exporter);
+  EXPECT_EQ(2, num_exports->load());
+  EXPECT_EQ(CircuitState::kOpen, exporter.GetState());
+  ExportOneSpan(exporter);
+  EXPECT_EQ(2, num_exports->load());
+
+  // A successful probe closes it.
+  *result = ExportResult::kSuccess;
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(ExportResult::kSuccess, ExportOneSpan(exporter));
+  EXPECT_EQ(CircuitState::kClosed, exporter.GetState());
+  EXPECT_EQ(3, num_exports->load());
+}
+
+TEST(CircuitBreakerSpanExporter, IgnoresPermanentFailures)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailure));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 1;
+  CircuitBreakerSpanExporter exporter(
+      std::unique_ptr<SpanExporter>(new ResultSpanExporter(result, num_exports)), options);
+
+  // A batch rejected by the backend shows that the backend is reachable.
+  ExportOneSpan(exporter);
+  ExportOneSpan(exporter);
+  EXPECT_EQ(CircuitState::kClosed, exporter.GetState());
+  EXPECT_EQ(2, num_exports->load());
+  EXPECT_EQ(0, exporter.GetRejectedCount());
+}
+
+TEST(CircuitBreakerSpanExporter, DropsRejectedBatches)
+{
+  std::shared_ptr<ExportResult> result(new ExportResult(ExportResult::kFailureRetryable));
+  std::shared_ptr<std::atomic<size_t>> num_exports(new std::atomic<size_t>(0));
+  CircuitBreakerOptions options;
+  options.failure_threshold = 1;
+  options.retry_rejected    = false;
+  CircuitBreakerSpanExporter exporter(
+      std::unique_ptr<SpanExporter>(new ResultSpanExporter(result, num_exports)), options);
+
+  ExportOneSpan(exporter);
+  bool is_taken = false;
+  EXPECT_EQ(ExportResult::kFailure, ExportOneSpan(exporter, &is_taken));
+  EXPECT_TRUE(is_taken);
+  EXPECT_EQ(1, num_exports->load());
+}
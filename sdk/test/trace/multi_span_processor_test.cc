@@ -0,0 +1,147 @@
+#include "opentelemetry/sdk/trace/multi_span_processor.h"
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
+#include "opentelemetry/sdk/trace/simple_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace opentelemetry::sdk::trace;
+using namespace opentelemetry::sdk::common;
+using opentelemetry::common::KeyValueIterableView;
+using opentelemetry::exporter::memory::InMemorySpanData;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+using opentelemetry::trace::SpanContext;
+namespace nostd = opentelemetry::nostd;
+
+// An exporter that keeps the span data it received, and counts calls to Shutdown.
+class SharedSpanDataExporter final : public SpanExporter
+{
+public:
+  SharedSpanDataExporter(std::vector<std::shared_ptr<const SpanData>> *spans, int *shutdown_counter)
+      : spans_(spans), shutdown_counter_(shutdown_counter)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData());
+  }
+
+  ExportResult Export(const nostd::span<std::unique_ptr<Recordable>> &recordables) noexcept override
+  {
+    for (auto &recordable : recordables)
+    {
+      auto shared_span = dynamic_cast<SharedSpanData *>(recordable.get());
+      if (shared_span != nullptr)
+      {
+        spans_->push_back(shared_span->GetSharedSpanData());
+      }
+    }
+    return ExportResult::kSuccess;
+  }
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override
+  {
+    *shutdown_counter_ += 1;
+    return true;
+  }
+
+private:
+  std::vector<std::shared_ptr<const SpanData>> *spans_;
+  int *shutdown_counter_;
+};
+
+TEST(MultiSpanProcessor, SharesSpanData)
+{
+  std::vector<std::shared_ptr<const SpanData>> spans;
+  int shutdown_counter = 0;
+  std::vector<std::shared_ptr<SpanProcessor>> processors;
+  for (int i = 0; i < 2; ++i)
+  {
+    processors.push_back(std::make_shared<SimpleSpanProcessor>(
+        std::unique_ptr<SpanExporter>(new SharedSpanDataExporter(&spans, &shutdown_counter))));
+  }
+  MultiSpanProcessor processor(processors);
+
+  auto recordable = processor.MakeRecordable();
+  processor.OnStart(*recordable, SpanContext::GetInvalid());
+  recordable->SetName("span");
+  recordable->SetAttribute("attr", 1);
+  processor.OnEnd(std::move(recordable));
+
+  // Both processors received a view of the same span data.
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ(spans[0], spans[1]);
+  EXPECT_EQ("span", spans[0]->GetName());
+  EXPECT_EQ(1, nostd::get<int32_t>(spans[0]->GetAttributes().at("attr")));
+
+  EXPECT_TRUE(processor.ForceFlush());
+  EXPECT_TRUE(processor.Shutdown());
+  EXPECT_EQ(2, shutdown_counter);
+}
+
+TEST(MultiSpanProcessor, ToInMemorySpanExporters)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter1(new InMemorySpanExporter());
+  std::unique_ptr<InMemorySpanExporter> exporter2(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data1 = exporter1->GetData();
+  std::shared_ptr<InMemorySpanData> span_data2 = exporter2->GetData();
+  MultiSpanProcessor processor({std::make_shared<SimpleSpanProcessor>(std::move(exporter1)),
+                                std::make_shared<SimpleSpanProcessor>(std::move(exporter2))});
+
+  auto recordable = processor.MakeRecordable();
+  processor.OnStart(*recordable, SpanContext::GetInvalid());
+  recordable->SetName("span");
+  processor.OnEnd(std::move(recordable));
+
+  auto spans1 = span_data1->GetSpans();
+  auto spans2 = span_data2->GetSpans();
+  ASSERT_EQ(1, spans1.size());
+  ASSERT_EQ(1, spans2.size());
+  EXPECT_EQ("span", spans1[0]->GetName());
+  EXPECT_EQ("span", spans2[0]->GetName());
+}
+
+TEST(SharedSpanData, CopyTo)
+{
+  std::shared_ptr<SpanData> span(new SpanData);
+  nostd::string_view string_values[]           = {"a", "b"};
+  bool bool_values[]                           = {true, false};
+  std::map<std::string, int> event_attributes = {{"event_attr", 2}};
+  span->SetName("span");
+  span->SetAttribute("attr", 1);
+  span->SetAttribute("strings", nostd::span<const nostd::string_view>(string_values));
+  span->SetAttribute("bools", nostd::span<const bool>(bool_values));
+  span->AddEvent("event", std::chrono::system_clock::now(),
+                 KeyValueIterableView<std::map<std::string, int>>(event_attributes), 1);
+  span->SetDroppedCounts(1, 2, 3);
+  span->SetStatus(opentelemetry::trace::StatusCode::kError, "error");
+
+  SharedSpanData shared_span(span);
+  EXPECT_EQ(span.get(), SharedSpanData::FromRecordable(shared_span));
+  EXPECT_EQ(span.get(), SharedSpanData::FromRecordable(*span));
+
+  SpanData copy;
+  shared_span.CopyTo(copy);
+  EXPECT_EQ("span", copy.GetName());
+  EXPECT_EQ(1, nostd::get<int32_t>(copy.GetAttributes().at("attr")));
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}),
+            nostd::get<std::vector<std::string>>(copy.GetAttributes().at("strings")));
+  EXPECT_EQ((std::vector<bool>{true, false}),
+            nostd::get<std::vector<bool>>(copy.GetAttributes().at("bools")));
+  ASSERT_EQ(1, copy.GetEvents().size());
+  EXPECT_EQ(2, nostd::get<int32_t>(copy.GetEvents()[0].GetAttributes().at("event_attr")));
+  EXPECT_EQ(1, copy.GetEvents()[0].GetDroppedAttributesCount());
+  EXPECT_EQ(1, copy.GetDroppedAttributesCount());
+  EXPECT_EQ(2, copy.GetDroppedEventsCount());
+  EXPECT_EQ(3, copy.GetDroppedLinksCount());
+  EXPECT_EQ(opentelemetry::trace::StatusCode::kError, copy.GetStatus());
+  EXPECT_EQ("error", copy.GetDescription());
+}
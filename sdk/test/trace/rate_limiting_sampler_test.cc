@@ -0,0 +1,126 @@
+#include "opentelemetry/sdk/trace/samplers/rate_limiting.h"
+#include "opentelemetry/sdk/trace/samplers/parent.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using opentelemetry::sdk::trace::Decision;
+using opentelemetry::sdk::trace::ParentBasedSampler;
+using opentelemetry::sdk::trace::RateLimitingSampler;
+using opentelemetry::sdk::trace::Sampler;
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+/*
+ * Calls ShouldSample the given number of times with the given parent context.
+ * Returns the number of spans sampled.
+ */
+int SampleSpans(Sampler &sampler,
+                int count,
+                const trace_api::SpanContext &parent_context = trace_api::SpanContext::GetInvalid())
+{
+  trace_api::TraceId trace_id;
+  opentelemetry::trace::SpanKind span_kind = opentelemetry::trace::SpanKind::kInternal;
+
+  using M = std::map<std::string, int>;
+  M m1    = {{}};
+
+  using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+  L l1 = {{trace_api::SpanContext(false, false), {}}, {trace_api::SpanContext(false, false), {}}};
+
+  opentelemetry::common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  int sampled = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    auto sampling_result =
+        sampler.ShouldSample(parent_context, trace_id, "", span_kind, view, links);
+    if (sampling_result.decision == Decision::RECORD_AND_SAMPLE)
+    {
+      ++sampled;
+    }
+  }
+  return sampled;
+}
+}  // namespace
+
+TEST(RateLimitingSampler, SamplesUpToBudget)
+{
+  RateLimitingSampler sampler(10, 4);
+
+  auto start   = std::chrono::steady_clock::now();
+  int sampled  = SampleSpans(sampler, 1000);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  // The budget accrues 1 span per 100 milliseconds.
+  EXPECT_GE(sampled, 10);
+  EXPECT_LE(sampled, 10 + elapsed.count() / 100 + 1);
+}
+
+TEST(RateLimitingSampler, RefillsOverTime)
+{
+  RateLimitingSampler sampler(20, 1);
+  EXPECT_EQ(SampleSpans(sampler, 100), 20);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  int sampled = SampleSpans(sampler, 100);
+  EXPECT_GE(sampled, 5);
+  EXPECT_LE(sampled, 20);
+}
+
+TEST(RateLimitingSampler, SharesBudgetBetweenThreads)
+{
+  RateLimitingSampler sampler(100, 2);
+  std::atomic<int> sampled{0};
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&] { sampled += SampleSpans(sampler, 1000); });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  EXPECT_GE(sampled.load(), 100);
+  EXPECT_LE(sampled.load(), 100 + elapsed.count() / 10 + 1);
+}
+
+TEST(RateLimitingSampler, ComposesWithParentBasedSampler)
+{
+  ParentBasedSampler sampler(std::make_shared<RateLimitingSampler>(5, 1));
+
+  uint8_t trace_id_buffer[trace_api::TraceId::kSize] = {1};
+  uint8_t span_id_buffer[trace_api::SpanId::kSize]   = {1};
+  trace_api::SpanContext parent_context_sampled(trace_api::TraceId{trace_id_buffer},
+                                                trace_api::SpanId{span_id_buffer},
+                                                trace_api::TraceFlags{1}, false);
+
+  // Only root spans are limited.
+  EXPECT_EQ(SampleSpans(sampler, 100), 5);
+  EXPECT_EQ(SampleSpans(sampler, 100, parent_context_sampled), 100);
+}
+
+TEST(RateLimitingSampler, GetDescription)
+{
+  RateLimitingSampler sampler(100);
+  ASSERT_EQ("RateLimitingSampler{100.000000}", sampler.GetDescription());
+
+  RateLimitingSampler sampler_zero(0);
+  ASSERT_EQ("RateLimitingSampler{0.000000}", sampler_zero.GetDescription());
+  EXPECT_EQ(SampleSpans(sampler_zero, 100), 0);
+}
@@ -0,0 +1,129 @@
+#include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/recordable_pool.h"
+#include "opentelemetry/sdk/trace/simple_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "opentelemetry/sdk/trace/tracer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+using namespace opentelemetry::sdk::trace;
+
+namespace
+{
+std::atomic<uint64_t> allocation_count{0};
+}  // namespace
+
+// Count every heap allocation made by the process.
+void *operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  ++allocation_count;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+/**
+ * An exporter that discards all spans, optionally recycling the recordables.
+ */
+template <bool kRecycle>
+class DiscardingExporter final : public SpanExporter
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    if (kRecycle)
+    {
+      return std::unique_ptr<Recordable>(RecordablePool<SpanData>::Acquire().release());
+    }
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  opentelemetry::sdk::common::ExportResult Export(
+      const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &spans) noexcept override
+  {
+    for (auto &recordable : spans)
+    {
+      std::unique_ptr<SpanData> span(static_cast<SpanData *>(recordable.release()));
+      if (kRecycle)
+      {
+        RecordablePool<SpanData>::Release(std::move(span));
+      }
+    }
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+template <bool kRecycle>
+void BenchmarkSpanAllocations(benchmark::State &state)
+{
+  std::unique_ptr<SpanExporter> exporter(new DiscardingExporter<kRecycle>);
+  auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  auto resource  = opentelemetry::sdk::resource::Resource::Create({});
+  auto tracer =
+      std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(processor, resource));
+
+  uint64_t allocations = 0;
+  for (auto _ : state)
+  {
+    auto start = allocation_count.load();
+
+    auto span = tracer->StartSpan("span");
+    span->SetAttribute("attr1", 3.1);
+    span->AddEvent("event");
+    span->End();
+    span = nullptr;
+
+    allocations += allocation_count.load() - start;
+  }
+  state.counters["allocations_per_span"] =
+      benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// Baseline: every span allocates a fresh SpanData which is destroyed after export.
+void BM_SpanAllocationsWithoutPool(benchmark::State &state)
+{
+  BenchmarkSpanAllocations<false>(state);
+}
+BENCHMARK(BM_SpanAllocationsWithoutPool);
+
+// Exported SpanData is recycled through the RecordablePool.
+void BM_SpanAllocationsWithPool(benchmark::State &state)
+{
+  BenchmarkSpanAllocations<true>(state);
+}
+BENCHMARK(BM_SpanAllocationsWithPool);
+}  // namespace
+BENCHMARK_MAIN();
@@ -0,0 +1,99 @@
+#include "opentelemetry/sdk/trace/recordable_pool.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::trace::RecordablePool;
+using opentelemetry::sdk::trace::SpanData;
+
+namespace
+{
+/**
+ * A recordable stand-in counting how often it was reset.
+ */
+class MockRecordable
+{
+public:
+  void Reset() noexcept { ++reset_count; }
+
+  int reset_count = 0;
+};
+}  // namespace
+
+TEST(RecordablePool, AcquireNew)
+{
+  auto recordable = RecordablePool<MockRecordable>::Acquire();
+  ASSERT_NE(recordable, nullptr);
+  EXPECT_EQ(recordable->reset_count, 0);
+}
+
+TEST(RecordablePool, ReleaseAndReuseOnSameThread)
+{
+  auto recordable = RecordablePool<MockRecordable>::Acquire();
+  auto ptr        = recordable.get();
+  RecordablePool<MockRecordable>::Release(std::move(recordable));
+
+  auto reused = RecordablePool<MockRecordable>::Acquire();
+  EXPECT_EQ(reused.get(), ptr);
+  EXPECT_EQ(reused->reset_count, 1);
+}
+
+TEST(RecordablePool, ReleaseNull)
+{
+  RecordablePool<MockRecordable>::Release(nullptr);
+  EXPECT_NE(RecordablePool<MockRecordable>::Acquire(), nullptr);
+}
+
+TEST(RecordablePool, ReuseAcrossThreads)
+{
+  // Recordables released on one thread become available to other threads once a
+  // full batch was handed to the shared free list.
+  std::vector<MockRecordable *> released;
+  std::thread exporter_thread([&released]() {
+    for (size_t i = 0; i < 2 * RecordablePool<MockRecordable>::kBatchSize; ++i)
+    {
+      auto recordable = std::unique_ptr<MockRecordable>(new MockRecordable);
+      released.push_back(recordable.get());
+      RecordablePool<MockRecordable>::Release(std::move(recordable));
+    }
+  });
+  exporter_thread.join();
+
+  // Keep acquiring until this thread's own free list is drained and a recordable released
+  // by the other thread shows up.
+  std::vector<std::unique_ptr<MockRecordable>> acquired;
+  bool found = false;
+  for (size_t i = 0; i < 4 * RecordablePool<MockRecordable>::kBatchSize && !found; ++i)
+  {
+    acquired.push_back(RecordablePool<MockRecordable>::Acquire());
+    for (auto ptr : released)
+    {
+      found |= acquired.back().get() == ptr;
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(RecordablePool, SpanDataIsReset)
+{
+  auto span_data = RecordablePool<SpanData>::Acquire();
+  span_data->SetName("span");
+  span_data->SetAttribute("attr1", 314159);
+  span_data->AddEvent("event");
+  span_data->SetStatus(opentelemetry::trace::StatusCode::kError, "error");
+  span_data->SetDuration(std::chrono::nanoseconds{123});
+  auto ptr = span_data.get();
+  RecordablePool<SpanData>::Release(std::move(span_data));
+
+  auto reused = RecordablePool<SpanData>::Acquire();
+  ASSERT_EQ(reused.get(), ptr);
+  EXPECT_EQ(reused->GetName(), "");
+  EXPECT_EQ(reused->GetAttributes().size(), 0);
+  EXPECT_EQ(reused->GetEvents().size(), 0);
+  EXPECT_EQ(reused->GetStatus(), opentelemetry::trace::StatusCode::kUnset);
+  EXPECT_EQ(reused->GetDescription(), "");
+  EXPECT_EQ(reused->GetDuration(), std::chrono::nanoseconds(0));
+}
@@ -0,0 +1,194 @@
+#include "opentelemetry/sdk/trace/samplers/rule_based.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <vector>
+
+using opentelemetry::sdk::trace::Decision;
+using opentelemetry::sdk::trace::RuleBasedSampler;
+using opentelemetry::sdk::trace::SamplingRule;
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+/*
+ * Calls ShouldSample for a root span. The rules of the tests sample all or no
+ * spans, whatever their trace id.
+ */
+template <class Attributes = std::map<std::string, std::string>>
+Decision Sample(RuleBasedSampler &sampler,
+                opentelemetry::nostd::string_view name,
+                trace_api::SpanKind span_kind = trace_api::SpanKind::kInternal,
+                const Attributes &attributes  = {})
+{
+  uint8_t trace_id_buffer[trace_api::TraceId::kSize] = {1};
+  trace_api::TraceId trace_id{trace_id_buffer};
+
+  using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+  L l1    = {};
+  opentelemetry::common::KeyValueIterableView<Attributes> view{attributes};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  return sampler
+      .ShouldSample(trace_api::SpanContext::GetInvalid(), trace_id, name, span_kind, view, links)
+      .decision;
+}
+
+SamplingRule MakeRule(double ratio)
+{
+  SamplingRule rule;
+  rule.ratio = ratio;
+  return rule;
+}
+
+void WriteFile(const std::string &path, const std::string &content)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << content;
+}
+}  // namespace
+
+TEST(RuleBasedSampler, MatchesByName)
+{
+  std::vector<SamplingRule> rules;
+  rules.push_back(MakeRule(1.0));
+  rules.back().name = "/checkout";
+  rules.push_back(MakeRule(0.0));
+  rules.back().name_prefix = "/health";
+  RuleBasedSampler sampler(rules, 0.0);
+
+  EXPECT_EQ(Sample(sampler, "/checkout"), Decision::RECORD_AND_SAMPLE);
+  EXPECT_EQ(Sample(sampler, "/checkout/confirm"), Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "/health"), Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "/healthz"), Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "/other"), Decision::DROP);
+}
+
+TEST(RuleBasedSampler, MatchesByKindAndAttributes)
+{
+  std::vector<SamplingRule> rules;
+  rules.push_back(MakeRule(1.0));
+  rules.back().has_span_kind = true;
+  rules.back().span_kind     = trace_api::SpanKind::kServer;
+  rules.back().attributes    = {{"http.method", "POST"}, {"http.route", "/cart"}};
+  RuleBasedSampler sampler(rules, 0.0);
+
+  std::map<std::string, std::string> attributes = {{"http.method", "POST"},
+                                                   {"http.route", "/cart"}};
+  EXPECT_EQ(Sample(sampler, "span", trace_api::SpanKind::kServer, attributes),
+            Decision::RECORD_AND_SAMPLE);
+  EXPECT_EQ(Sample(sampler, "span", trace_api::SpanKind::kClient, attributes), Decision::DROP);
+
+  attributes["http.method"] = "GET";
+  EXPECT_EQ(Sample(sampler, "span", trace_api::SpanKind::kServer, attributes), Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "span", trace_api::SpanKind::kServer), Decision::DROP);
+}
+
+TEST(RuleBasedSampler, MatchesIntegerAndBooleanAttributes)
+{
+  std::vector<SamplingRule> rules;
+  rules.push_back(MakeRule(1.0));
+  rules.back().attributes = {{"http.status_code", "200"}};
+  rules.push_back(MakeRule(1.0));
+  rules.back().attributes = {{"error", "true"}};
+  RuleBasedSampler sampler(rules, 0.0);
+
+  auto kind = trace_api::SpanKind::kInternal;
+  EXPECT_EQ(Sample(sampler, "span", kind, std::map<std::string, int>{{"http.status_code", 200}}),
+            Decision::RECORD_AND_SAMPLE);
+  EXPECT_EQ(Sample(sampler, "span", kind, std::map<std::string, int>{{"http.status_code", 500}}),
+            Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "span", kind, std::map<std::string, bool>{{"error", true}}),
+            Decision::RECORD_AND_SAMPLE);
+  EXPECT_EQ(Sample(sampler, "span", kind, std::map<std::string, bool>{{"error", false}}),
+            Decision::DROP);
+}
+
+TEST(RuleBasedSampler, FirstMatchingRuleApplies)
+{
+  std::vector<SamplingRule> rules;
+  rules.push_back(MakeRule(0.0));
+  rules.back().name_prefix = "/api/internal";
+  rules.push_back(MakeRule(1.0));
+  rules.back().name_prefix = "/api";
+  rules.push_back(MakeRule(0.0));
+  rules.back().name = "/api/users";
+  RuleBasedSampler sampler(rules, 0.0);
+
+  EXPECT_EQ(Sample(sampler, "/api/internal/status"), Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "/api/users"), Decision::RECORD_AND_SAMPLE);
+
+  // Spans matching no rule are sampled by the default ratio.
+  RuleBasedSampler default_sampler(std::vector<SamplingRule>{}, 1.0);
+  EXPECT_EQ(Sample(default_sampler, "/api"), Decision::RECORD_AND_SAMPLE);
+}
+
+TEST(RuleBasedSampler, ParseRules)
+{
+  std::vector<SamplingRule> rules;
+  std::string error;
+  ASSERT_TRUE(RuleBasedSampler::ParseRules(
+      "# comment\n"
+      "\n"
+      "name=/checkout ratio=1\n"
+      "  name_prefix=/health ratio=0.001\n"
+      "kind=server attribute.http.method=POST ratio=0.5\n"
+      "name=\"GET /search\" ratio=0\n",
+      rules, error))
+      << error;
+  ASSERT_EQ(rules.size(), 4);
+  EXPECT_EQ(rules[0].name, "/checkout");
+  EXPECT_EQ(rules[0].ratio, 1.0);
+  EXPECT_EQ(rules[1].name_prefix, "/health");
+  EXPECT_EQ(rules[1].ratio, 0.001);
+  EXPECT_TRUE(rules[2].has_span_kind);
+  EXPECT_EQ(rules[2].span_kind, trace_api::SpanKind::kServer);
+  ASSERT_EQ(rules[2].attributes.size(), 1);
+  EXPECT_EQ(rules[2].attributes[0].first, "http.method");
+  EXPECT_EQ(rules[2].attributes[0].second, "POST");
+  EXPECT_EQ(rules[3].name, "GET /search");
+
+  rules.clear();
+  EXPECT_FALSE(RuleBasedSampler::ParseRules("name=a\n", rules, error));
+  EXPECT_EQ(error, "line 1: missing ratio");
+  EXPECT_FALSE(RuleBasedSampler::ParseRules("\nname=a ratio=2\n", rules, error));
+  EXPECT_EQ(error, "line 2: invalid ratio: 2");
+  EXPECT_FALSE(RuleBasedSampler::ParseRules("kind=remote ratio=1", rules, error));
+  EXPECT_EQ(error, "line 1: unknown span kind: remote");
+  EXPECT_FALSE(RuleBasedSampler::ParseRules("name=\"a ratio=1", rules, error));
+  EXPECT_EQ(error, "line 1: unclosed quote");
+  EXPECT_TRUE(rules.empty());
+}
+
+TEST(RuleBasedSampler, ReloadsRulesFile)
+{
+  const std::string path = "./rule_based_sampler_test_rules.txt";
+  WriteFile(path, "name=a ratio=1\n");
+  // Reloads are made by the test.
+  RuleBasedSampler sampler(path, 0.0, std::chrono::milliseconds(3600 * 1000));
+  EXPECT_EQ(Sample(sampler, "a"), Decision::RECORD_AND_SAMPLE);
+  EXPECT_EQ(Sample(sampler, "b"), Decision::DROP);
+
+  WriteFile(path, "name=b ratio=1\n");
+  EXPECT_TRUE(sampler.Reload());
+  EXPECT_EQ(Sample(sampler, "a"), Decision::DROP);
+  EXPECT_EQ(Sample(sampler, "b"), Decision::RECORD_AND_SAMPLE);
+
+  // Rules which cannot be parsed are ignored.
+  WriteFile(path, "name=a\n");
+  EXPECT_FALSE(sampler.Reload());
+  EXPECT_EQ(Sample(sampler, "b"), Decision::RECORD_AND_SAMPLE);
+
+  std::remove(path.c_str());
+}
+
+TEST(RuleBasedSampler, GetDescription)
+{
+  RuleBasedSampler sampler(std::vector<SamplingRule>{});
+  ASSERT_EQ("RuleBasedSampler", sampler.GetDescription());
+}
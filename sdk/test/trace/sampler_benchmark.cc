@@ -4,18 +4,22 @@
 #include "opentelemetry/sdk/trace/samplers/always_off.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
 #include "opentelemetry/sdk/trace/samplers/parent.h"
+#include "opentelemetry/sdk/trace/samplers/rate_limiting.h"
+#include "opentelemetry/sdk/trace/samplers/rule_based.h"
 #include "opentelemetry/sdk/trace/samplers/trace_id_ratio.h"
 #include "opentelemetry/sdk/trace/simple_processor.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 #include "opentelemetry/sdk/trace/tracer.h"
 
 #include <cstdint>
+#include <string>
 
 #include <benchmark/benchmark.h>
 
 using namespace opentelemetry::sdk::trace;
 using opentelemetry::exporter::memory::InMemorySpanExporter;
 using opentelemetry::trace::SpanContext;
+namespace nostd = opentelemetry::nostd;
 
 namespace
 {
@@ -57,6 +61,15 @@ void BM_TraceIdRatioBasedSamplerConstruction(benchmark::State &state)
 }
 BENCHMARK(BM_TraceIdRatioBasedSamplerConstruction);
 
+void BM_RateLimitingSamplerConstruction(benchmark::State &state)
+{
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(RateLimitingSampler(100));
+  }
+}
+BENCHMARK(BM_RateLimitingSamplerConstruction);
+
 // Sampler Helper Function
 void BenchmarkShouldSampler(Sampler &sampler, benchmark::State &state)
 {
@@ -114,6 +127,50 @@ void BM_TraceIdRatioBasedSamplerShouldSample(benchmark::State &state)
 }
 BENCHMARK(BM_TraceIdRatioBasedSamplerShouldSample);
 
+// The budget is large enough not to run out, so that only sampled spans are measured.
+void BM_RateLimitingSamplerShouldSample(benchmark::State &state)
+{
+  static RateLimitingSampler sampler(1e12);
+
+  BenchmarkShouldSampler(sampler, state);
+}
+BENCHMARK(BM_RateLimitingSamplerShouldSample)->ThreadRange(1, 8);
+
+// The budget runs out at once, so that only dropped spans are measured.
+void BM_RateLimitingSamplerShouldSampleExhausted(benchmark::State &state)
+{
+  static RateLimitingSampler sampler(1);
+
+  BenchmarkShouldSampler(sampler, state);
+}
+BENCHMARK(BM_RateLimitingSamplerShouldSampleExhausted)->ThreadRange(1, 8);
+
+void BM_ParentBasedRateLimitingSamplerShouldSample(benchmark::State &state)
+{
+  static ParentBasedSampler sampler(std::make_shared<RateLimitingSampler>(1e12));
+
+  BenchmarkShouldSampler(sampler, state);
+}
+BENCHMARK(BM_ParentBasedRateLimitingSamplerShouldSample)->ThreadRange(1, 8);
+
+// Only the last of the rules may match the span, which the decision table finds
+// without evaluating the rules by name.
+void BM_RuleBasedSamplerShouldSample(benchmark::State &state)
+{
+  std::vector<SamplingRule> rules(200);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    rules[2 * i].name            = "/service" + std::to_string(i);
+    rules[2 * i + 1].name_prefix = "/prefix" + std::to_string(i);
+  }
+  rules.emplace_back();
+  rules.back().ratio = 0.01;
+  RuleBasedSampler sampler(rules);
+
+  BenchmarkShouldSampler(sampler, state);
+}
+BENCHMARK(BM_RuleBasedSamplerShouldSample);
+
 // Sampler Helper Function
 void BenchmarkSpanCreation(std::shared_ptr<Sampler> sampler, benchmark::State &state)
 {
@@ -147,5 +204,105 @@ void BM_NoopSpanCreation(benchmark::State &state)
 }
 BENCHMARK(BM_NoopSpanCreation);
 
+// Span creation with attributes which are costly to compute, passed either
+// eagerly or through an attribute builder. The builder is not invoked for spans
+// which are not sampled.
+void BenchmarkSpanCreationWithAttributes(std::shared_ptr<Sampler> sampler,
+                                         bool deferred,
+                                         benchmark::State &state)
+{
+  std::unique_ptr<SpanExporter> exporter(new InMemorySpanExporter());
+  auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  auto resource  = opentelemetry::sdk::resource::Resource::Create({});
+  auto tracer =
+      std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(processor, resource, sampler));
+  uint64_t request_id = 0;
+
+  while (state.KeepRunning())
+  {
+    ++request_id;
+    nostd::shared_ptr<opentelemetry::trace::Span> span;
+    if (deferred)
+    {
+      span = tracer->StartSpan(
+          "span", {{"http.method", "GET"}}, [&](opentelemetry::common::AttributeAdder add) {
+            add("http.url", "https://example.com/requests/" + std::to_string(request_id));
+            add("request.id", std::to_string(request_id));
+          });
+    }
+    else
+    {
+      std::string url = "https://example.com/requests/" + std::to_string(request_id);
+      std::string id  = std::to_string(request_id);
+      span            = tracer->StartSpan("span", {{"http.method", "GET"},
+                                        {"http.url", nostd::string_view{url}},
+                                        {"request.id", nostd::string_view{id}}});
+    }
+    span->End();
+  }
+}
+
+void BM_SpanCreationEagerAttributes(benchmark::State &state)
+{
+  BenchmarkSpanCreationWithAttributes(std::make_shared<AlwaysOnSampler>(), false, state);
+}
+BENCHMARK(BM_SpanCreationEagerAttributes);
+
+void BM_SpanCreationDeferredAttributes(benchmark::State &state)
+{
+  BenchmarkSpanCreationWithAttributes(std::make_shared<AlwaysOnSampler>(), true, state);
+}
+BENCHMARK(BM_SpanCreationDeferredAttributes);
+
+void BM_NoopSpanCreationEagerAttributes(benchmark::State &state)
+{
+  BenchmarkSpanCreationWithAttributes(std::make_shared<AlwaysOffSampler>(), false, state);
+}
+BENCHMARK(BM_NoopSpanCreationEagerAttributes);
+
+void BM_NoopSpanCreationDeferredAttributes(benchmark::State &state)
+{
+  BenchmarkSpanCreationWithAttributes(std::make_shared<AlwaysOffSampler>(), true, state);
+}
+BENCHMARK(BM_NoopSpanCreationDeferredAttributes);
+
+/**
+ * A processor that discards all spans, so that span creation can be measured
+ * without contention in the processor or exporter.
+ */
+class DiscardingProcessor final : public SpanProcessor
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  void OnStart(Recordable &, const SpanContext &) noexcept override {}
+
+  void OnEnd(std::unique_ptr<Recordable> &&) noexcept override {}
+
+  bool ForceFlush(std::chrono::microseconds) noexcept override { return true; }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+// Multi-threaded span creation, with all threads sharing a single tracer
+template <class S>
+void BM_SpanCreationThreaded(benchmark::State &state)
+{
+  static auto resource = opentelemetry::sdk::resource::Resource::Create({});
+  static auto tracer   = std::shared_ptr<opentelemetry::trace::Tracer>(
+      new Tracer(std::make_shared<DiscardingProcessor>(), resource, std::make_shared<S>()));
+
+  for (auto _ : state)
+  {
+    auto span = tracer->StartSpan("span");
+    span->End();
+  }
+}
+BENCHMARK_TEMPLATE(BM_SpanCreationThreaded, AlwaysOnSampler)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpanCreationThreaded, AlwaysOffSampler)->ThreadRange(1, 64)->UseRealTime();
+
 }  // namespace
 BENCHMARK_MAIN();
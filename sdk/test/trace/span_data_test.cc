@@ -124,3 +124,37 @@ TEST(SpanData, Links)
               values[i]);
   }
 }
+
+TEST(SpanData, InternedName)
+{
+  SpanData data;
+  data.SetName("interned span name");
+  ASSERT_TRUE(data.GetInternedName().IsValid());
+  EXPECT_EQ(data.GetName(), "interned span name");
+
+  SpanData other;
+  other.SetName("interned span name");
+  EXPECT_EQ(other.GetInternedName().GetId(), data.GetInternedName().GetId());
+
+  // Names too long to be interned are copied.
+  std::string long_name(1000, 'x');
+  data.SetName(long_name);
+  EXPECT_FALSE(data.GetInternedName().IsValid());
+  EXPECT_EQ(data.GetName(), long_name);
+}
+
+TEST(SpanData, LookUpAttribute)
+{
+  SpanData data;
+  data.SetAttribute("attr1", 1);
+  data.SetAttribute("attr2", 2);
+  data.SetAttribute("attr1", 3);
+
+  size_t num_attributes = 0;
+  bool has_key          = false;
+  ASSERT_TRUE(data.LookUpAttribute("attr1", &num_attributes, &has_key));
+  EXPECT_EQ(num_attributes, 2);
+  EXPECT_TRUE(has_key);
+  ASSERT_TRUE(data.LookUpAttribute("attr3", &num_attributes, &has_key));
+  EXPECT_FALSE(has_key);
+}
@@ -0,0 +1,133 @@
+#include "opentelemetry/sdk/trace/spooling_exporter.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::nostd::string_view;
+using opentelemetry::sdk::common::DiskSpool;
+using opentelemetry::sdk::common::DiskSpoolOptions;
+using opentelemetry::sdk::common::ExportResult;
+
+namespace
+{
+/**
+ * The backend of an EncodingTestExporter.
+ */
+struct TestBackend
+{
+  ExportResult result = ExportResult::kSuccess;
+  std::vector<std::string> exported;
+};
+
+/**
+ * A span exporter which encodes a batch as the names of its spans, and sends
+ * it to a test backend.
+ */
+class EncodingTestExporter final : public EncodingSpanExporter
+{
+public:
+  explicit EncodingTestExporter(std::shared_ptr<TestBackend> backend) noexcept
+      : backend_(backend)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  ExportResult Export(
+      const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &spans) noexcept override
+  {
+    std::string data;
+    Encode(spans, &data);
+    return ExportEncoded(data);
+  }
+
+  bool Encode(const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &spans,
+              std::string *data) noexcept override
+  {
+    for (auto &recordable : spans)
+    {
+      std::unique_ptr<SpanData> span(static_cast<SpanData *>(recordable.release()));
+      data->append(span->GetName().data(), span->GetName().size());
+    }
+    return true;
+  }
+
+  ExportResult ExportEncoded(string_view data) noexcept override
+  {
+    if (backend_->result == ExportResult::kSuccess)
+    {
+      backend_->exported.push_back(std::string(data.data(), data.size()));
+    }
+    return backend_->result;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  std::shared_ptr<TestBackend> backend_;
+};
+
+/**
+ * Keeps the spool of every test in the temporary directory, under the name of
+ * the test, and deletes its files before and after the test.
+ */
+class SpoolingSpanExporterTest : public ::testing::Test
+{
+protected:
+  void SetUp() override { RemoveSpool(); }
+
+  void TearDown() override { RemoveSpool(); }
+
+  DiskSpoolOptions MakeOptions() const
+  {
+    const auto *test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    DiskSpoolOptions options;
+    options.directory       = ::testing::TempDir();
+    options.name            = std::string("spooling_exporter_test_") + test_info->name();
+    options.replay_interval = std::chrono::hours(1);
+    return options;
+  }
+
+  /**
+   * Deletes the files of the spool by reading it entirely.
+   */
+  void RemoveSpool() const
+  {
+    DiskSpool spool{MakeOptions()};
+    std::string record;
+    while (spool.Peek(&record))
+    {
+      spool.Pop();
+    }
+  }
+};
+
+ExportResult ExportOneSpan(SpanExporter &exporter, string_view name)
+{
+  std::unique_ptr<Recordable> spans[] = {exporter.MakeRecordable()};
+  spans[0]->SetName(name);
+  return exporter.Export(opentelemetry::nostd::span<std::unique_ptr<Recordable>>(spans));
+}
+}  // namespace
+
+TEST_F(SpoolingSpanExporterTest, SpoolsEncodedBatches)
+{
+  std::shared_ptr<TestBackend> backend(new TestBackend);
+  SpoolingSpanExporter exporter(
+      std::unique_ptr<EncodingSpanExporter>(new EncodingTestExporter(backend)), MakeOptions());
+
+  // Batches are spooled while the backend is down, and replayed on shutdown.
+  backend->result = ExportResult::kFailureRetryable;
+  EXPECT_EQ(ExportResult::kSuccess, ExportOneSpan(exporter, "a"));
+  EXPECT_EQ(ExportResult::kSuccess, ExportOneSpan(exporter, "b"));
+  EXPECT_TRUE(backend->exported.empty());
+
+  backend->result = ExportResult::kSuccess;
+  EXPECT_TRUE(exporter.Shutdown());
+  EXPECT_EQ(backend->exported, (std::vector<std::string>{"a", "b"}));
+}
@@ -0,0 +1,306 @@
+#include "opentelemetry/sdk/trace/tail_sampling_processor.h"
+#include "opentelemetry/sdk/trace/shared_span_data.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::trace::SpanContext;
+using opentelemetry::trace::SpanId;
+using opentelemetry::trace::StatusCode;
+using opentelemetry::trace::TraceFlags;
+using opentelemetry::trace::TraceId;
+
+namespace
+{
+// A processor that keeps the span data it received.
+class RecordingSpanProcessor final : public SpanProcessor
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData());
+  }
+
+  void OnStart(Recordable &, const SpanContext &) noexcept override {}
+
+  void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    spans_.push_back(static_cast<SharedSpanData *>(span.get())->GetSharedSpanData());
+  }
+
+  bool ForceFlush(std::chrono::microseconds) noexcept override { return true; }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+  std::vector<std::shared_ptr<const SpanData>> GetSpans()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return spans_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<const SpanData>> spans_;
+};
+
+TraceId MakeTraceId(uint8_t first_byte, uint8_t last_byte = 0)
+{
+  uint8_t buffer[TraceId::kSize] = {first_byte};
+  buffer[TraceId::kSize - 1]     = last_byte;
+  return TraceId(buffer);
+}
+
+void EndSpan(TailSamplingSpanProcessor &processor,
+             TraceId trace_id,
+             uint8_t span_byte,
+             bool is_root,
+             StatusCode status                 = StatusCode::kUnset,
+             std::chrono::nanoseconds duration = std::chrono::nanoseconds(0))
+{
+  uint8_t span_buffer[SpanId::kSize]   = {span_byte};
+  uint8_t parent_buffer[SpanId::kSize] = {1};
+  auto span                            = processor.MakeRecordable();
+  span->SetIdentity(SpanContext(trace_id, SpanId(span_buffer), TraceFlags(1), false),
+                    is_root ? SpanId() : SpanId(parent_buffer));
+  span->SetStatus(status, "");
+  span->SetDuration(duration);
+  processor.OnEnd(std::move(span));
+}
+
+TailSamplingSpanProcessorOptions MakeOptions()
+{
+  TailSamplingSpanProcessorOptions options;
+  options.decision_wait      = std::chrono::milliseconds(60000);
+  options.max_trace_duration = std::chrono::milliseconds(60000);
+  return options;
+}
+}  // namespace
+
+TEST(TailSamplingSpanProcessor, KeepsTracesWithErrors)
+{
+  auto recorder = std::make_shared<RecordingSpanProcessor>();
+  auto options  = MakeOptions();
+  options.policies.push_back(std::make_shared<ErrorStatusPolicy>());
+  TailSamplingSpanProcessor processor(recorder, options);
+
+  EndSpan(processor, MakeTraceId(1), 2, false);
+  EndSpan(processor, MakeTraceId(1), 1, true);
+  EndSpan(processor, MakeTraceId(2), 2, false, StatusCode::kError);
+  EndSpan(processor, MakeTraceId(2), 1, true);
+  EXPECT_TRUE(recorder->GetSpans().empty());
+
+  EXPECT_TRUE(processor.ForceFlush());
+  auto spans = recorder->GetSpans();
+  ASSERT_EQ(spans.size(), 2);
+  EXPECT_EQ(spans[0]->GetTraceId(), MakeTraceId(2));
+  EXPECT_EQ(spans[1]->GetTraceId(), MakeTraceId(2));
+  EXPECT_EQ(processor.GetKeptTraceCount(), 1);
+  EXPECT_EQ(processor.GetDroppedTraceCount(), 1);
+}
+
+TEST(TailSamplingSpanProcessor, DecidesIdleTraces)
+{
+  auto recorder         = std::make_shared<RecordingSpanProcessor>();
+  auto options          = MakeOptions();
+  options.decision_wait = std::chrono::milliseconds(10);
+  TailSamplingSpanProcessor processor(recorder, options);
+
+  EndSpan(processor, MakeTraceId(1), 1, true);
+  for (int i = 0; i < 1000 && recorder->GetSpans().empty(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(recorder->GetSpans().size(), 1);
+
+  // A span ending late follows the decision of its trace.
+  EndSpan(processor, MakeTraceId(1), 2, false);
+  EXPECT_EQ(recorder->GetSpans().size(), 2);
+  EXPECT_EQ(processor.GetKeptTraceCount(), 1);
+}
+
+TEST(TailSamplingSpanProcessor, DecidesOldestTracesOverBudget)
+{
+  auto recorder      = std::make_shared<RecordingSpanProcessor>();
+  auto options       = MakeOptions();
+  options.num_shards = 1;
+  SpanData span;
+  options.max_buffer_size_bytes = 2 * span.GetEstimatedSize();
+  TailSamplingSpanProcessor processor(recorder, options);
+
+  EndSpan(processor, MakeTraceId(1), 1, true);
+  EndSpan(processor, MakeTraceId(2), 1, true);
+  EXPECT_TRUE(recorder->GetSpans().empty());
+
+  // The oldest trace is decided early to make room.
+  EndSpan(processor, MakeTraceId(3), 1, true);
+  auto spans = recorder->GetSpans();
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_EQ(spans[0]->GetTraceId(), MakeTraceId(1));
+
+  // A trace never evicts itself.
+  EndSpan(processor, MakeTraceId(3), 2, false);
+  EndSpan(processor, MakeTraceId(3), 3, false);
+  EXPECT_EQ(processor.GetDroppedSpanCount(), 1);
+  EXPECT_EQ(recorder->GetSpans().size(), 2);
+
+  EXPECT_TRUE(processor.ForceFlush());
+  EXPECT_EQ(recorder->GetSpans().size(), 4);
+}
+
+TEST(TailSamplingSpanProcessor, DropsSpansLargerThanBudget)
+{
+  auto recorder      = std::make_shared<RecordingSpanProcessor>();
+  auto options       = MakeOptions();
+  options.num_shards = 1;
+  SpanData span;
+  options.max_buffer_size_bytes = 2 * span.GetEstimatedSize();
+  TailSamplingSpanProcessor processor(recorder, options);
+
+  EndSpan(processor, MakeTraceId(1), 1, true);
+  EndSpan(processor, MakeTraceId(2), 1, true);
+
+  // A span which never fits is dropped without deciding the other traces.
+  uint8_t span_buffer[SpanId::kSize] = {1};
+  auto large_span                    = processor.MakeRecordable();
+  large_span->SetIdentity(SpanContext(MakeTraceId(3), SpanId(span_buffer), TraceFlags(1), false),
+                          SpanId());
+  large_span->SetName(std::string(options.max_buffer_size_bytes, 'x'));
+  processor.OnEnd(std::move(large_span));
+  EXPECT_TRUE(recorder->GetSpans().empty());
+  EXPECT_EQ(processor.GetDroppedSpanCount(), 1);
+
+  EXPECT_TRUE(processor.ForceFlush());
+  EXPECT_EQ(recorder->GetSpans().size(), 2);
+}
+
+TEST(TailSamplingSpanProcessor, DecidesOldestTracesOfOtherShards)
+{
+  auto recorder      = std::make_shared<RecordingSpanProcessor>();
+  auto options       = MakeOptions();
+  options.num_shards = 2;
+  SpanData span;
+  options.max_buffer_size_bytes = 2 * span.GetEstimatedSize();
+  TailSamplingSpanProcessor processor(recorder, options);
+
+  // The shard of a trace is chosen by the second half of its id.
+  uint8_t buffer[TraceId::kSize] = {1};
+  TraceId first_trace_id(buffer);
+  buffer[0] = 2;
+  TraceId second_trace_id(buffer);
+  buffer[0] = 3;
+  buffer[8] = 1;
+  TraceId other_shard_trace_id(buffer);
+
+  EndSpan(processor, first_trace_id, 1, true);
+  EndSpan(processor, second_trace_id, 1, true);
+  EXPECT_TRUE(recorder->GetSpans().empty());
+
+  // The budget is held by the other shard, whose oldest trace makes room.
+  EndSpan(processor, other_shard_trace_id, 1, true);
+  auto spans = recorder->GetSpans();
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_EQ(spans[0]->GetTraceId(), first_trace_id);
+  EXPECT_EQ(processor.GetDroppedSpanCount(), 0);
+}
+
+TEST(TailSamplingSpanProcessor, CopiesSharedSpans)
+{
+  auto recorder = std::make_shared<RecordingSpanProcessor>();
+  TailSamplingSpanProcessor processor(recorder, MakeOptions());
+
+  // A span shared with other processors, as by a MultiSpanProcessor.
+  uint8_t span_buffer[SpanId::kSize] = {1};
+  std::shared_ptr<SpanData> span_data(new SpanData);
+  span_data->SetIdentity(SpanContext(MakeTraceId(1), SpanId(span_buffer), TraceFlags(1), false),
+                         SpanId());
+  span_data->SetName("shared");
+  processor.OnEnd(std::unique_ptr<Recordable>(new SharedSpanData(span_data)));
+
+  EXPECT_TRUE(processor.ForceFlush());
+  auto spans = recorder->GetSpans();
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_NE(spans[0], span_data);
+  EXPECT_EQ(spans[0]->GetTraceId(), MakeTraceId(1));
+  EXPECT_EQ(spans[0]->GetName(), "shared");
+}
+
+TEST(TailSamplingSpanProcessor, SpreadsTracesOverShards)
+{
+  auto recorder = std::make_shared<RecordingSpanProcessor>();
+  auto options  = MakeOptions();
+  options.policies.push_back(std::make_shared<ErrorStatusPolicy>());
+  TailSamplingSpanProcessor processor(recorder, options);
+
+  std::vector<std::thread> threads;
+  for (uint8_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&processor, t] {
+      for (int i = 0; i < 256; ++i)
+      {
+        auto trace_id = MakeTraceId(t + 1, static_cast<uint8_t>(i));
+        EndSpan(processor, trace_id, 2, false, i % 2 == 0 ? StatusCode::kError : StatusCode::kOk);
+        EndSpan(processor, trace_id, 1, true);
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_TRUE(processor.Shutdown());
+  EXPECT_EQ(recorder->GetSpans().size(), 4 * 256);
+  EXPECT_EQ(processor.GetKeptTraceCount(), 4 * 128);
+  EXPECT_EQ(processor.GetDroppedTraceCount(), 4 * 128);
+}
+
+TEST(TailSamplingPolicy, LatencyPolicyUsesRootSpan)
+{
+  LatencyPolicy policy(std::chrono::milliseconds(100));
+  uint8_t parent_buffer[SpanId::kSize] = {1};
+  std::vector<std::unique_ptr<SpanData>> spans;
+  spans.emplace_back(new SpanData());
+  spans.back()->SetIdentity(SpanContext::GetInvalid(), SpanId(parent_buffer));
+  spans.back()->SetDuration(std::chrono::milliseconds(200));
+  EXPECT_TRUE(policy.ShouldKeep(spans));
+
+  spans.emplace_back(new SpanData());
+  spans.back()->SetDuration(std::chrono::milliseconds(50));
+  EXPECT_FALSE(policy.ShouldKeep(spans));
+}
+
+TEST(TailSamplingPolicy, AttributePolicyMatchesValue)
+{
+  AttributePolicy policy("http.route", std::string("/checkout"));
+  std::vector<std::unique_ptr<SpanData>> spans;
+  spans.emplace_back(new SpanData());
+  spans.back()->SetAttribute("http.route", "/home");
+  EXPECT_FALSE(policy.ShouldKeep(spans));
+
+  spans.emplace_back(new SpanData());
+  spans.back()->SetAttribute("http.route", "/checkout");
+  EXPECT_TRUE(policy.ShouldKeep(spans));
+}
+
+TEST(TailSamplingPolicy, RatioPolicyUsesTraceId)
+{
+  RatioPolicy policy(0.5);
+  std::vector<std::unique_ptr<SpanData>> spans;
+  spans.emplace_back(new SpanData());
+  spans.back()->SetIdentity(SpanContext(MakeTraceId(0x01), SpanId(), TraceFlags(1), false),
+                            SpanId());
+  EXPECT_TRUE(policy.ShouldKeep(spans));
+
+  uint8_t buffer[TraceId::kSize];
+  std::fill(buffer, buffer + TraceId::kSize, uint8_t{0xff});
+  spans.back()->SetIdentity(SpanContext(TraceId(buffer), SpanId(), TraceFlags(1), false),
+                            SpanId());
+  EXPECT_FALSE(policy.ShouldKeep(spans));
+}
@@ -223,6 +223,22 @@ TEST(TraceIdRatioBasedSampler, TraceIdRatioBasedSamplerNone)
   ASSERT_EQ(actual_count, expected_count);
 }
 
+TEST(TraceIdRatioBasedSampler, SetRatio)
+{
+  int iterations = 100000;
+
+  trace_api::SpanContext c(true, true);
+  TraceIdRatioBasedSampler s(1.0);
+
+  s.SetRatio(0.0);
+  ASSERT_EQ("TraceIdRatioBasedSampler{0.000000}", s.GetDescription());
+  ASSERT_EQ(0, RunShouldSampleCountDecision(c, s, iterations));
+
+  s.SetRatio(3.0);
+  ASSERT_EQ("TraceIdRatioBasedSampler{1.000000}", s.GetDescription());
+  ASSERT_EQ(iterations, RunShouldSampleCountDecision(c, s, iterations));
+}
+
 TEST(TraceIdRatioBasedSampler, GetDescription)
 {
   TraceIdRatioBasedSampler s1(0.01);
@@ -22,15 +22,28 @@ TEST(TracerProvider, GetTracer)
   ASSERT_NE(nullptr, t2);
   ASSERT_NE(nullptr, t3);
 
-  // Should return the same instance each time.
+  // Should return the same instance for the same library, and a different
+  // instance for a different library.
   ASSERT_EQ(t1, t2);
-  ASSERT_EQ(t1, t3);
+  ASSERT_NE(t1, t3);
+  ASSERT_EQ(t3, tp1.GetTracer("different", "1.0.0"));
+  ASSERT_NE(t3, tp1.GetTracer("different", "2.0.0"));
 
   // Should be an sdk::trace::Tracer with the processor attached.
   auto sdkTracer1 = dynamic_cast<Tracer *>(t1.get());
   ASSERT_NE(nullptr, sdkTracer1);
   ASSERT_EQ(processor, sdkTracer1->GetProcessor());
   ASSERT_EQ("AlwaysOnSampler", sdkTracer1->GetSampler()->GetDescription());
+  ASSERT_EQ("test", sdkTracer1->GetInstrumentationLibrary().GetName());
+  ASSERT_EQ("", sdkTracer1->GetInstrumentationLibrary().GetVersion());
+
+  // Tracers of different libraries should share the configuration.
+  auto sdkTracer3 = dynamic_cast<Tracer *>(t3.get());
+  ASSERT_NE(nullptr, sdkTracer3);
+  ASSERT_EQ(processor, sdkTracer3->GetProcessor());
+  ASSERT_EQ(sdkTracer1->GetSampler(), sdkTracer3->GetSampler());
+  ASSERT_EQ("different", sdkTracer3->GetInstrumentationLibrary().GetName());
+  ASSERT_EQ("1.0.0", sdkTracer3->GetInstrumentationLibrary().GetVersion());
 
   TracerProvider tp2(processor, Resource::Create({}), std::make_shared<AlwaysOffSampler>());
   auto sdkTracer2 = dynamic_cast<Tracer *>(tp2.GetTracer("test").get());
@@ -6,6 +6,7 @@
 #include "opentelemetry/sdk/trace/samplers/parent.h"
 #include "opentelemetry/sdk/trace/simple_processor.h"
 #include "opentelemetry/sdk/trace/span_data.h"
+#include "opentelemetry/sdk/trace/tracer_provider.h"
 
 #include <gtest/gtest.h>
 
@@ -46,6 +47,52 @@ class MockSampler final : public Sampler
   nostd::string_view GetDescription() const noexcept override { return "MockSampler"; }
 };
 
+/**
+ * A mock id generator that returns sequential ids.
+ */
+class MockIdGenerator final : public IdGenerator
+{
+public:
+  trace_api::SpanId GenerateSpanId() noexcept override
+  {
+    uint8_t span_id_buf[trace_api::SpanId::kSize] = {0};
+    span_id_buf[0]                                = ++span_id_count;
+    return trace_api::SpanId(span_id_buf);
+  }
+
+  trace_api::TraceId GenerateTraceId() noexcept override
+  {
+    uint8_t trace_id_buf[trace_api::TraceId::kSize] = {0};
+    trace_id_buf[0]                                 = ++trace_id_count;
+    return trace_api::TraceId(trace_id_buf);
+  }
+
+  uint8_t span_id_count  = 0;
+  uint8_t trace_id_count = 0;
+};
+
+/**
+ * A mock clock that advances by a fixed step on every reading.
+ */
+class MockClock final : public opentelemetry::sdk::common::Clock
+{
+public:
+  SystemTimestamp SystemNow() noexcept override
+  {
+    now_ += std::chrono::nanoseconds(100);
+    return SystemTimestamp(std::chrono::nanoseconds(1000) + now_);
+  }
+
+  SteadyTimestamp SteadyNow() noexcept override
+  {
+    now_ += std::chrono::nanoseconds(100);
+    return SteadyTimestamp(now_);
+  }
+
+private:
+  std::chrono::nanoseconds now_{0};
+};
+
 namespace
 {
 std::shared_ptr<opentelemetry::trace::Tracer> initTracer(
@@ -612,3 +659,231 @@ TEST(Tracer, ExpectParentWithValidSpanContext)
   EXPECT_EQ(spandata_first->GetSpanId(), spandata_second->GetParentSpanId());
   EXPECT_EQ(spandata_second->GetSpanId(), spandata_third->GetParentSpanId());
 }
+
+TEST(Tracer, CustomIdGenerator)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+
+  auto processor    = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  auto resource     = Resource::Create({});
+  auto id_generator = std::make_shared<MockIdGenerator>();
+  auto sdk_tracer   = std::make_shared<Tracer>(processor, resource,
+                                              std::make_shared<AlwaysOnSampler>(), id_generator);
+  EXPECT_EQ(sdk_tracer->GetIdGenerator(), id_generator);
+  std::shared_ptr<opentelemetry::trace::Tracer> tracer = sdk_tracer;
+
+  auto span_first  = tracer->StartSpan("span 1");
+  auto scope_first = tracer->WithActiveSpan(span_first);
+  auto span_second = tracer->StartSpan("span 2");
+  span_second->End();
+  span_first->End();
+
+  // Only the root span gets a new trace id.
+  EXPECT_EQ(id_generator->trace_id_count, 1);
+  EXPECT_EQ(id_generator->span_id_count, 2);
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  uint8_t trace_id_buf[trace_api::TraceId::kSize]      = {1};
+  uint8_t span_id_buf_first[trace_api::SpanId::kSize]  = {1};
+  uint8_t span_id_buf_second[trace_api::SpanId::kSize] = {2};
+  EXPECT_EQ(spans.at(0)->GetTraceId(), trace_api::TraceId(trace_id_buf));
+  EXPECT_EQ(spans.at(0)->GetSpanId(), trace_api::SpanId(span_id_buf_second));
+  EXPECT_EQ(spans.at(1)->GetTraceId(), trace_api::TraceId(trace_id_buf));
+  EXPECT_EQ(spans.at(1)->GetSpanId(), trace_api::SpanId(span_id_buf_first));
+}
+
+TEST(Tracer, CustomClock)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+
+  auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  auto resource  = Resource::Create({});
+  auto clock     = std::make_shared<MockClock>();
+  auto sdk_tracer =
+      std::make_shared<Tracer>(processor, resource, std::make_shared<AlwaysOnSampler>(),
+                               std::make_shared<RandomIdGenerator>(), clock);
+  EXPECT_EQ(sdk_tracer->GetClock(), clock);
+  std::shared_ptr<opentelemetry::trace::Tracer> tracer = sdk_tracer;
+
+  // Start: system time 1100, steady time 200. Event: system time 1300. End:
+  // steady time 400.
+  auto span = tracer->StartSpan("span 1");
+  span->AddEvent("event 1");
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ(std::chrono::nanoseconds(1100), spans.at(0)->GetStartTime().time_since_epoch());
+  EXPECT_EQ(std::chrono::nanoseconds(200), spans.at(0)->GetDuration());
+  ASSERT_EQ(1, spans.at(0)->GetEvents().size());
+  EXPECT_EQ(std::chrono::nanoseconds(1300),
+            spans.at(0)->GetEvents()[0].GetTimestamp().time_since_epoch());
+}
+
+TEST(Tracer, SpanLimits)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+
+  SpanLimits span_limits;
+  span_limits.attribute_count_limit           = 2;
+  span_limits.event_count_limit               = 1;
+  span_limits.link_count_limit                = 1;
+  span_limits.attribute_per_event_count_limit = 1;
+  span_limits.attribute_per_link_count_limit  = 1;
+  span_limits.attribute_value_length_limit    = 3;
+
+  auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  auto resource  = Resource::Create({});
+  auto sdk_tracer =
+      std::make_shared<Tracer>(processor, resource, std::make_shared<AlwaysOnSampler>(),
+                               std::make_shared<RandomIdGenerator>(),
+                               opentelemetry::sdk::common::SystemClock::GetInstance(), span_limits);
+  EXPECT_EQ(sdk_tracer->GetSpanLimits().attribute_count_limit, 2);
+  std::shared_ptr<opentelemetry::trace::Tracer> tracer = sdk_tracer;
+
+  std::map<std::string, int> event_attributes = {{"attr1", 1}, {"attr2", 2}};
+  auto span = tracer->StartSpan("span 1", {{"attr1", "value1"}},
+                                {{SpanContext(false, false), {{"attr1", 1}, {"attr2", 2}}},
+                                 {SpanContext(false, false), {{"attr1", 1}}}});
+
+  // Updating an attribute does not count against the limit.
+  span->SetAttribute("attr1", "value1");
+  span->SetAttribute("attr2", 2);
+  span->SetAttribute("attr3", 3);
+  // Attributes which are already set can still be updated once the limit is reached.
+  span->SetAttribute("attr1", "updated");
+  span->AddEvent("event 1", std::chrono::system_clock::now(), event_attributes);
+  span->AddEvent("event 2");
+  span->AddEvent("event 3");
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  auto &cur_span_data = spans.at(0);
+
+  ASSERT_EQ(2, cur_span_data->GetAttributes().size());
+  EXPECT_EQ("upd", nostd::get<std::string>(cur_span_data->GetAttributes().at("attr1")));
+  EXPECT_EQ(2, nostd::get<int32_t>(cur_span_data->GetAttributes().at("attr2")));
+  EXPECT_EQ(1, cur_span_data->GetDroppedAttributesCount());
+
+  ASSERT_EQ(1, cur_span_data->GetEvents().size());
+  EXPECT_EQ(1, cur_span_data->GetEvents()[0].GetAttributes().size());
+  EXPECT_EQ(1, cur_span_data->GetEvents()[0].GetDroppedAttributesCount());
+  EXPECT_EQ(2, cur_span_data->GetDroppedEventsCount());
+
+  ASSERT_EQ(1, cur_span_data->GetLinks().size());
+  EXPECT_EQ(1, cur_span_data->GetLinks()[0].GetAttributes().size());
+  EXPECT_EQ(1, cur_span_data->GetLinks()[0].GetDroppedAttributesCount());
+  EXPECT_EQ(1, cur_span_data->GetDroppedLinksCount());
+}
+
+TEST(Tracer, InstrumentationLibrary)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  TracerProvider tracer_provider(processor);
+
+  tracer_provider.GetTracer("library 1", "1.0.0")->StartSpan("span 1")->End();
+  tracer_provider.GetTracer("library 2")->StartSpan("span 2")->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("library 1", spans.at(0)->GetInstrumentationLibrary().GetName());
+  EXPECT_EQ("1.0.0", spans.at(0)->GetInstrumentationLibrary().GetVersion());
+  EXPECT_EQ("library 2", spans.at(1)->GetInstrumentationLibrary().GetName());
+  EXPECT_EQ("", spans.at(1)->GetInstrumentationLibrary().GetVersion());
+}
+
+TEST(Tracer, SpanOutlivesTracerProvider)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  nostd::shared_ptr<opentelemetry::trace::Span> span;
+  {
+    auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+    TracerProvider tracer_provider(processor);
+    span = tracer_provider.GetTracer("library")->StartSpan("span");
+
+    // The processor replaced is still used by the span started before.
+    std::unique_ptr<InMemorySpanExporter> other_exporter(new InMemorySpanExporter());
+    tracer_provider.SetProcessor(std::make_shared<SimpleSpanProcessor>(std::move(other_exporter)));
+  }
+
+  // The context of the destroyed tracer provider is kept alive by the span.
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ("span", spans.at(0)->GetName());
+  // The instrumentation library is shared with the exported span.
+  span = nullptr;
+  EXPECT_EQ("library", spans.at(0)->GetInstrumentationLibrary().GetName());
+}
+
+TEST(Tracer, SetSampler)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto processor = std::make_shared<SimpleSpanProcessor>(std::move(exporter));
+  TracerProvider tracer_provider(processor);
+  auto tracer = tracer_provider.GetTracer("library");
+
+  auto span_on = tracer->StartSpan("span on");
+
+  // Tracers created before the sampler is set use the new sampler.
+  auto sampler = std::make_shared<AlwaysOffSampler>();
+  tracer_provider.SetSampler(sampler);
+  ASSERT_EQ(sampler, tracer_provider.GetSampler());
+  tracer->StartSpan("span off")->End();
+
+  // Spans started before keep being recorded.
+  span_on->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ("span on", spans.at(0)->GetName());
+}
+
+TEST(Tracer, DeferredAttributes)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto tracer_on  = initTracer(std::move(exporter));
+  auto tracer_off = initTracer(std::unique_ptr<InMemorySpanExporter>{new InMemorySpanExporter()},
+                               std::make_shared<AlwaysOffSampler>());
+
+  int builder_calls = 0;
+  auto builder      = [&](opentelemetry::common::AttributeAdder add) {
+    ++builder_calls;
+    add("deferred", std::string("value"));
+  };
+
+  // The builders of spans which are not recorded are never invoked.
+  auto span_off = tracer_off->StartSpan("span", {{"eager", 1}}, builder);
+  span_off->SetAttributes(builder);
+  span_off->AddEvent("event", builder);
+  span_off->End();
+  EXPECT_EQ(0, builder_calls);
+
+  auto span_on = tracer_on->StartSpan("span", {{"eager", 1}}, builder);
+  span_on->SetAttributes([](opentelemetry::common::AttributeAdder add) { add("set", true); });
+  span_on->AddEvent("event", builder);
+  span_on->End();
+  EXPECT_EQ(2, builder_calls);
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  auto &cur_span_data = spans.at(0);
+  ASSERT_EQ(3, cur_span_data->GetAttributes().size());
+  EXPECT_EQ(1, nostd::get<int32_t>(cur_span_data->GetAttributes().at("eager")));
+  EXPECT_EQ("value", nostd::get<std::string>(cur_span_data->GetAttributes().at("deferred")));
+  EXPECT_EQ(true, nostd::get<bool>(cur_span_data->GetAttributes().at("set")));
+  ASSERT_EQ(1, cur_span_data->GetEvents().size());
+  EXPECT_EQ("value", nostd::get<std::string>(
+                         cur_span_data->GetEvents().at(0).GetAttributes().at("deferred")));
+}